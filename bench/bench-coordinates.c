@@ -0,0 +1,173 @@
+/**
+ * @file    bench-coordinates.c
+ * @brief   A BENCHMARK of the memory & query time of a coordinate mode
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          Build ONCE per COORD_MODE (see 'make bench-coords'), as the
+ *          coordinate type is fixed at compile time
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+
+#include "../src/coordinates.h"
+#include "../src/dynamic-array.h"
+#include "../src/quad-tree.h"
+
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#define DEFAULT_POINTS 1000000      // Points bulk loaded into the tree
+#define DEFAULT_QUERIES 100000      // Point (& range) queries to time
+#define RANGE_FRACTION 0.01L        // Width of a range query (of the root)
+
+#define ROOT_BL_X 144.9375L         // Same root as the dataset_1000 tests
+#define ROOT_BL_Y -37.8750L
+#define ROOT_TR_X 145.0000L
+#define ROOT_TR_Y -37.6875L
+
+#define NS_PER_SEC 1000000000.0
+
+/* -------------------------------------------------------------------------- */
+
+// FUNCTION PROTOTYPES:
+const char* mode_name(void);
+long double random_fraction(unsigned long *state);
+double elapsed_ns(struct timespec *start, struct timespec *end);
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char **argv) {
+
+    // STEP 1: Read the (optional) workload size
+    int n = (argc > 1) ? atoi(argv[1]) : DEFAULT_POINTS;
+    int q = (argc > 2) ? atoi(argv[2]) : DEFAULT_QUERIES;
+    assert((n > 0) && (q > 0));
+
+    // STEP 2: Generate the SAME pseudo-random points for every mode
+    coord_frame_init(ROOT_BL_X, ROOT_BL_Y, ROOT_TR_X, ROOT_TR_Y);
+    rectangle_t root_bounds = rectangle_init(
+        point_2d_quantise(ROOT_BL_X, ROOT_BL_Y),
+        point_2d_quantise(ROOT_TR_X, ROOT_TR_Y));
+    long double *xs = (long double *)malloc(sizeof(long double) * n);
+    long double *ys = (long double *)malloc(sizeof(long double) * n);
+    point_2d_t *points = (point_2d_t *)malloc(sizeof(point_2d_t) * n);
+    record_ref_t *point_data = (record_ref_t *)malloc(
+        sizeof(record_ref_t) * n);
+    assert(xs && ys && points && point_data);
+
+    unsigned long state = 1;
+    for (int i = 0; i < n; i++) {
+        xs[i] = ROOT_BL_X + random_fraction(&state) * (ROOT_TR_X - ROOT_BL_X);
+        ys[i] = ROOT_BL_Y + random_fraction(&state) * (ROOT_TR_Y - ROOT_BL_Y);
+        points[i] = point_2d_quantise(xs[i], ys[i]);
+        point_data[i].foothpath_id = point_data[i].record = i;
+    }
+
+    // STEP 3: Time the bulk load
+    struct timespec start, end;
+    qt_tree_t *tree = qt_tree_init(root_bounds, QT_DEFAULT_LEAF_CAPACITY,
+        QT_UNLIMITED_DEPTH);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    qt_bulk_load(tree, points, point_data, n);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double build_ns = elapsed_ns(&start, &end);
+
+    // STEP 4: Time point queries for points that are KNOWN to exist (the
+    //         paths are NOT needed, so they are not tracked)
+    long found = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < q; i++) {
+        point_2d_t query = point_2d_quantise(xs[i % n], ys[i % n]);
+        found += (qt_search(tree, &query, NULL) != NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double point_ns = elapsed_ns(&start, &end);
+
+    // STEP 5: Time small range queries scattered across the root
+    long matched = 0;
+    long double w = RANGE_FRACTION * (ROOT_TR_X - ROOT_BL_X);
+    long double h = RANGE_FRACTION * (ROOT_TR_Y - ROOT_BL_Y);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < q; i++) {
+        long double x = ROOT_BL_X + random_fraction(&state)
+            * (ROOT_TR_X - ROOT_BL_X - w);
+        long double y = ROOT_BL_Y + random_fraction(&state)
+            * (ROOT_TR_Y - ROOT_BL_Y - h);
+        rectangle_t range = rectangle_init(point_2d_quantise(x, y),
+            point_2d_quantise(x + w, y + h));
+        array_t *matches = qt_range_query(tree, NULL, &range);
+        if (matches != NULL) {
+            matched += matches->logical_size;
+            array_free(matches);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double range_ns = elapsed_ns(&start, &end);
+
+    // STEP 6: Report ONE machine-readable line per mode
+    printf("mode=%s point_bytes=%zu rect_bytes=%zu node_bytes=%zu "
+        "nodes=%u tree_bytes=%zu build_ms=%.1f point_ns=%.0f "
+        "range_us=%.2f found=%ld matched=%ld\n", mode_name(),
+        sizeof(point_2d_t), sizeof(rectangle_t), sizeof(qt_node_t),
+        tree->node_count, (size_t)tree->node_count * sizeof(qt_node_t),
+        build_ns/1e6, point_ns/q, range_ns/q/1e3, found, matched);
+
+    // STEP 7: Free everything
+    qt_free(tree);
+    free(xs);
+    free(ys);
+    free(points);
+    free(point_data);
+    return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       NAMES the coordinate mode this benchmark was compiled with
+ * @return      A string literal naming COORD_MODE
+*/
+const char*
+mode_name(void) {
+#if COORD_MODE == COORD_FIXED
+    return "fixed";
+#elif COORD_MODE == COORD_DOUBLE
+    return "double";
+#else
+    return "long-double";
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       GENERATES a deterministic pseudo-random fraction
+ * @param[out]  state   The generator's state (advanced by one step)
+ * @return      A long double in [0, 1)
+*/
+long double
+random_fraction(unsigned long *state) {
+    *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+    return (long double)(*state >> 11) / (long double)(1UL << 53);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       MEASURES the time between two timestamps
+ * @param[in]   start   The earlier timestamp
+ * @param[in]   end     The later timestamp
+ * @return      The elapsed time in nanoseconds
+*/
+double
+elapsed_ns(struct timespec *start, struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) * NS_PER_SEC
+        + (end->tv_nsec - start->tv_nsec);
+}
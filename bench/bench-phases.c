@@ -0,0 +1,205 @@
+/**
+ * @file    bench-phases.c
+ * @brief   A BENCHMARK timing each phase of answering queries on a dataset
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          Times the LOAD (reading the CSV into the record store), BUILD
+ *          (bulk loading the quad-tree), POINT-QUERY & RANGE-QUERY phases
+ *          separately on a dataset written by gen-dataset (see 'make bench'),
+ *          & reports them as ONE machine-readable line
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <time.h>
+
+#include "../src/coordinates.h"
+#include "../src/csv.h"
+#include "../src/dynamic-array.h"
+#include "../src/quad-tree.h"
+#include "../src/record-store.h"
+
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#define ROOT_BL_X 144.9375L         // Same root as gen-dataset
+#define ROOT_BL_Y -37.8750L
+#define ROOT_TR_X 145.0000L
+#define ROOT_TR_Y -37.6875L
+
+#define INIT_QUERIES 1024           // Queries there is room for initially
+#define MAX_FILENAME 4096           // Longest path of a dataset file
+#define NS_PER_SEC 1000000000.0
+
+/* -------------------------------------------------------------------------- */
+
+// FUNCTION PROTOTYPES:
+point_2d_t* read_queries(const char *prefix, const char *suffix, int per_line,
+    int *count);
+double elapsed_ns(struct timespec *start, struct timespec *end);
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char **argv) {
+
+    // STEP 1: Read the dataset's prefix & the (optional) label of this run
+    if ((argc < 2) || (argc > 3)) {
+        fprintf(stderr, "usage: %s prefix [label]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    const char *label = (argc > 2) ? argv[2] : "-";
+    char filename[MAX_FILENAME];
+    snprintf(filename, MAX_FILENAME, "%s.csv", argv[1]);
+    coord_frame_init(ROOT_BL_X, ROOT_BL_Y, ROOT_TR_X, ROOT_TR_Y);
+    rectangle_t root_bounds = rectangle_init(
+        point_2d_quantise(ROOT_BL_X, ROOT_BL_Y),
+        point_2d_quantise(ROOT_TR_X, ROOT_TR_Y));
+
+    // STEP 2: Read the queries BEFORE any phase is timed
+    int point_count = 0, range_count = 0;
+    point_2d_t *points = read_queries(argv[1], ".points.in", 1, &point_count);
+    point_2d_t *ranges = read_queries(argv[1], ".ranges.in", 2, &range_count);
+
+    // STEP 3: Time the load (as main.c's build_tree() does it)
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    csv_file_t *csv = csv_open(filename);
+    if (csv == NULL) {
+        fprintf(stderr, "ERROR: could not open %s\n", filename);
+        exit(EXIT_FAILURE);
+    }
+    int row_count = 0;
+    data_t **rows = csv_read_rows(csv, 1, &row_count);
+    record_store_t *store = record_store_init(row_count);
+    int n = 0;
+    point_2d_t *endpoints =
+        (point_2d_t *)malloc(sizeof(point_2d_t) * (2 * row_count + 1));
+    record_ref_t *endpoint_data =
+        (record_ref_t *)malloc(sizeof(record_ref_t) * (2 * row_count + 1));
+    assert((endpoints != NULL) && (endpoint_data != NULL));
+    for (int i = 0; i < row_count; i++) {
+        record_ref_t ref = record_store_append(store, csv->base, rows[i]);
+        endpoints[n] = point_2d_quantise(rows[i]->start_lon,
+            rows[i]->start_lat);
+        endpoint_data[n++] = ref;
+        endpoints[n] = point_2d_quantise(rows[i]->end_lon, rows[i]->end_lat);
+        endpoint_data[n++] = ref;
+        free_data(rows[i]);
+    }
+    free(rows);
+    csv_close(csv);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double load_ns = elapsed_ns(&start, &end);
+
+    // STEP 4: Time the build
+    qt_tree_t *tree = qt_tree_init(root_bounds, QT_DEFAULT_LEAF_CAPACITY,
+        QT_UNLIMITED_DEPTH);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    qt_bulk_load(tree, endpoints, endpoint_data, n);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double build_ns = elapsed_ns(&start, &end);
+
+    // STEP 5: Time the point queries (the paths are NOT needed, so they are
+    //         not tracked)
+    long found = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < point_count; i++) {
+        found += (qt_search(tree, &points[i], NULL) != NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double point_ns = elapsed_ns(&start, &end);
+
+    // STEP 6: Time the range queries
+    long matched = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < range_count; i++) {
+        rectangle_t range = rectangle_init(ranges[2 * i], ranges[2 * i + 1]);
+        array_t *matches = qt_range_query(tree, NULL, &range);
+        if (matches != NULL) {
+            matched += matches->logical_size;
+            array_free(matches);
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double range_ns = elapsed_ns(&start, &end);
+
+    // STEP 7: Report ONE machine-readable line per run
+    const char *dataset = strrchr(argv[1], '/');
+    printf("label=%s dataset=%s rows=%d points=%d nodes=%u load_ms=%.1f "
+        "build_ms=%.1f point_queries=%d point_ns=%.0f range_queries=%d "
+        "range_us=%.2f found=%ld matched=%ld\n", label,
+        (dataset != NULL) ? dataset + 1 : argv[1], row_count, n,
+        tree->node_count, load_ns/1e6, build_ns/1e6, point_count,
+        (point_count > 0) ? point_ns/point_count : 0, range_count,
+        (range_count > 0) ? range_ns/range_count/1e3 : 0, found, matched);
+
+    // STEP 8: Free everything
+    qt_free(tree);
+    record_store_free(store);
+    free(endpoints);
+    free(endpoint_data);
+    free(points);
+    free(ranges);
+    return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       READS a file of queries (each a line of xy-points)
+ * @param[in]   prefix      The path of the dataset
+ * @param[in]   suffix      The rest of the query file's path
+ * @param[in]   per_line    The number of xy-points per query
+ * @param[out]  count       Filled with the number of queries
+ * @return      A POINTER to a heap-allocated array of the (quantised) points
+*/
+point_2d_t*
+read_queries(const char *prefix, const char *suffix, int per_line,
+    int *count) {
+
+    // STEP 1: Open the file
+    char filename[MAX_FILENAME];
+    snprintf(filename, MAX_FILENAME, "%s%s", prefix, suffix);
+    FILE *file = fopen(filename, "r");
+    if (file == NULL) {
+        fprintf(stderr, "ERROR: could not open %s\n", filename);
+        exit(EXIT_FAILURE);
+    }
+
+    // STEP 2: Read EVERY point, growing the array as needed
+    int capacity = INIT_QUERIES, n = 0;
+    point_2d_t *points = (point_2d_t *)malloc(sizeof(point_2d_t) * capacity);
+    assert(points != NULL);
+    long double x, y;
+    while (fscanf(file, "%Lf %Lf", &x, &y) == 2) {
+        if (n == capacity) {
+            capacity *= REALLOC_FACTOR;
+            points = (point_2d_t *)realloc(points,
+                sizeof(point_2d_t) * capacity);
+            assert(points != NULL);
+        }
+        points[n++] = point_2d_quantise(x, y);
+    }
+    fclose(file);
+    *count = n / per_line;
+    return points;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       MEASURES the time between two timestamps
+ * @param[in]   start   The earlier timestamp
+ * @param[in]   end     The later timestamp
+ * @return      The elapsed time in nanoseconds
+*/
+double
+elapsed_ns(struct timespec *start, struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) * NS_PER_SEC
+        + (end->tv_nsec - start->tv_nsec);
+}
@@ -0,0 +1,325 @@
+/**
+ * @file    gen-dataset.c
+ * @brief   A GENERATOR of synthetic Melbourne-schema datasets & their queries
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          Writes <prefix>.csv, <prefix>.points.in (endpoints KNOWN to be in
+ *          the dataset) & <prefix>.ranges.in (small rectangles scattered
+ *          across the root), all within the same root as the dataset_1000
+ *          tests. The output is the SAME for the same arguments
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <math.h>
+
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#define ROOT_BL_X 144.9375          // Same root as the dataset_1000 tests
+#define ROOT_BL_Y -37.8750
+#define ROOT_TR_X 145.0000
+#define ROOT_TR_Y -37.6875
+
+#define FOOTPATH_LENGTH 0.001       // Longest footpath (in degrees)
+#define CLUSTERS 32                 // Centres of the CLUSTERED distribution
+#define CLUSTER_SPREAD 0.002        // Standard deviation of a cluster
+#define DUPLICATES_PER_SITE 64      // Footpaths sharing a NEAR-DUPLICATE site
+#define DUPLICATE_JITTER 1e-9       // Largest offset from a shared site
+#define RANGE_FRACTION 0.01         // Width of a range query (of the root)
+#define EDGE_MARGIN 1e-7            // Gap kept between a point & the root's edge
+
+#define OUTPUT_BUFFER (1 << 20)     // Bytes buffered before each write
+#define PI 3.14159265358979323846
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   The ways footpaths are spread across the root
+*/
+typedef enum distribution distribution_t;
+enum distribution {
+    UNIFORM,
+    CLUSTERED,
+    NEAR_DUPLICATE
+};
+
+/**
+ * @brief   A longitude & latitude
+*/
+typedef struct endpoint endpoint_t;
+struct endpoint {
+    double          lon;
+    double          lat;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// FUNCTION PROTOTYPES:
+distribution_t parse_distribution(const char *name);
+endpoint_t random_start(distribution_t distribution, endpoint_t *centres,
+    endpoint_t *site, long footpath, unsigned long *state);
+endpoint_t random_end(distribution_t distribution, endpoint_t start,
+    unsigned long *state);
+double random_fraction(unsigned long *state);
+double random_gaussian(unsigned long *state);
+double inside(double value, double low, double high);
+FILE* open_output(const char *prefix, const char *suffix);
+
+/* -------------------------------------------------------------------------- */
+
+int main(int argc, char **argv) {
+
+    // STEP 1: Read the distribution, the workload size & the output prefix
+    if (argc != 5) {
+        fprintf(stderr, "usage: %s uniform|clustered|near-duplicate "
+            "footpaths queries prefix\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    distribution_t distribution = parse_distribution(argv[1]);
+    long footpaths = atol(argv[2]);
+    long queries = atol(argv[3]);
+    assert((footpaths > 0) && (queries > 0));
+    FILE *csv = open_output(argv[4], ".csv");
+    FILE *points = open_output(argv[4], ".points.in");
+    FILE *ranges = open_output(argv[4], ".ranges.in");
+
+    // STEP 2: Place the cluster centres (AWAY from the root's edges)
+    unsigned long state = 1;
+    endpoint_t centres[CLUSTERS], site;
+    for (int i = 0; i < CLUSTERS; i++) {
+        centres[i].lon = ROOT_BL_X + (0.1 + 0.8 * random_fraction(&state))
+            * (ROOT_TR_X - ROOT_BL_X);
+        centres[i].lat = ROOT_BL_Y + (0.1 + 0.8 * random_fraction(&state))
+            * (ROOT_TR_Y - ROOT_BL_Y);
+    }
+
+    // STEP 3: Write the footpaths, keeping a uniform SAMPLE of their
+    //         endpoints (i.e. reservoir sampling) as the point queries
+    static const char *suburbs[] = {"Carlton", "Parkville", "Melbourne",
+        "North Melbourne", "Southbank", "Docklands"};
+    static const char *segsides[] = {"North", "South", "East", "West"};
+    endpoint_t *sample = (endpoint_t *)malloc(sizeof(endpoint_t) * queries);
+    assert(sample != NULL);
+    fprintf(csv, "footpath_id,address,clue_sa,asset_type,deltaz,distance,"
+        "grade1in,mcc_id,mccid_int,rlmax,rlmin,segside,statusid,streetid,"
+        "street_group,start_lat,start_lon,end_lat,end_lon\n");
+    for (long i = 0; i < footpaths; i++) {
+        endpoint_t start = random_start(distribution, centres, &site,
+            i, &state);
+        endpoint_t end = random_end(distribution, start, &state);
+        double rlmin = 10 + 40 * random_fraction(&state);
+        double deltaz = 5 * random_fraction(&state);
+        int street = (int)(1000 * random_fraction(&state));
+        fprintf(csv, "%ld,Street %d between Street %d and Street %d,%s,"
+            "Road Footway,%.2f,%.2f,%.1f,%ld.0,%ld,%.2f,%.2f,%s,2.0,%d.0,"
+            "%d.0,%.17g,%.17g,%.17g,%.17g\n", i + 1, street, street + 1,
+            street + 2, suburbs[i % 6], deltaz,
+            10 + 190 * random_fraction(&state),
+            5 + 95 * random_fraction(&state), 1380000 + i, 20000 + i,
+            rlmin + deltaz, rlmin, segsides[i % 4], street, 20000 + street,
+            start.lat, start.lon, end.lat, end.lon);
+
+        // STEP 3A: Each endpoint REPLACES a sampled one with the odds it
+        //          would have of being sampled (once the reservoir is full)
+        for (int j = 0; j < 2; j++) {
+            long seen = 2 * i + j;
+            long slot = (seen < queries) ? seen
+                : (long)(random_fraction(&state) * (seen + 1));
+            if (slot < queries) {
+                sample[slot] = (j == 0) ? start : end;
+            }
+        }
+    }
+
+    // STEP 4: Write the point queries (cycling through the sample if there
+    //         are fewer endpoints than queries)
+    long sampled = (2 * footpaths < queries) ? 2 * footpaths : queries;
+    for (long i = 0; i < queries; i++) {
+        fprintf(points, "%.17g %.17g\n", sample[i % sampled].lon,
+            sample[i % sampled].lat);
+    }
+
+    // STEP 5: Write the range queries
+    double w = RANGE_FRACTION * (ROOT_TR_X - ROOT_BL_X);
+    double h = RANGE_FRACTION * (ROOT_TR_Y - ROOT_BL_Y);
+    for (long i = 0; i < queries; i++) {
+        double x = ROOT_BL_X + random_fraction(&state)
+            * (ROOT_TR_X - ROOT_BL_X - w);
+        double y = ROOT_BL_Y + random_fraction(&state)
+            * (ROOT_TR_Y - ROOT_BL_Y - h);
+        fprintf(ranges, "%.17g %.17g %.17g %.17g\n", x, y, x + w, y + h);
+    }
+
+    // STEP 6: Free everything & close the files
+    free(sample);
+    fclose(csv);
+    fclose(points);
+    fclose(ranges);
+    return 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       PARSES the name of a distribution
+ * @param[in]   name    "uniform", "clustered" or "near-duplicate"
+ * @return      The distribution (the program EXITS on an unknown name)
+*/
+distribution_t
+parse_distribution(const char *name) {
+    if (strcmp(name, "uniform") == 0) return UNIFORM;
+    if (strcmp(name, "clustered") == 0) return CLUSTERED;
+    if (strcmp(name, "near-duplicate") == 0) return NEAR_DUPLICATE;
+    fprintf(stderr, "ERROR: unknown distribution %s\n", name);
+    exit(EXIT_FAILURE);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       GENERATES the start of a footpath
+ * @param[in]   distribution    How footpaths are spread across the root
+ * @param[in]   centres         The CLUSTERS cluster centres
+ * @param[out]  site            The NEAR-DUPLICATE site currently shared
+ * @param[in]   footpath        The footpath's index (in file order)
+ * @param[out]  state           The generator's state
+ * @return      The start (within the root)
+*/
+endpoint_t
+random_start(distribution_t distribution, endpoint_t *centres,
+    endpoint_t *site, long footpath, unsigned long *state) {
+
+    endpoint_t start;
+    double width = ROOT_TR_X - ROOT_BL_X, height = ROOT_TR_Y - ROOT_BL_Y;
+    switch (distribution) {
+
+        // CASE 1: Anywhere in the root
+        case UNIFORM:
+            start.lon = ROOT_BL_X + random_fraction(state) * width;
+            start.lat = ROOT_BL_Y + random_fraction(state) * height;
+            break;
+
+        // CASE 2: Normally distributed around a random cluster centre
+        case CLUSTERED: {
+            endpoint_t *centre =
+                &centres[(int)(random_fraction(state) * CLUSTERS)];
+            start.lon = centre->lon + random_gaussian(state) * CLUSTER_SPREAD;
+            start.lat = centre->lat + random_gaussian(state) * CLUSTER_SPREAD;
+            break;
+        }
+
+        // CASE 3: Within a hair of a site shared by DUPLICATES_PER_SITE
+        //         footpaths (in a row)
+        default:
+            if (footpath % DUPLICATES_PER_SITE == 0) {
+                site->lon = ROOT_BL_X + random_fraction(state) * width;
+                site->lat = ROOT_BL_Y + random_fraction(state) * height;
+            }
+            start.lon = site->lon + random_fraction(state) * DUPLICATE_JITTER;
+            start.lat = site->lat + random_fraction(state) * DUPLICATE_JITTER;
+            break;
+    }
+    start.lon = inside(start.lon, ROOT_BL_X, ROOT_TR_X);
+    start.lat = inside(start.lat, ROOT_BL_Y, ROOT_TR_Y);
+    return start;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       GENERATES the end of a footpath
+ * @param[in]   distribution    How footpaths are spread across the root
+ * @param[in]   start           The start of the footpath
+ * @param[out]  state           The generator's state
+ * @return      The end (within the root)
+*/
+endpoint_t
+random_end(distribution_t distribution, endpoint_t start,
+    unsigned long *state) {
+
+    // NOTE: a NEAR-DUPLICATE footpath ends at (nearly) the same site
+    double length = (distribution == NEAR_DUPLICATE) ? DUPLICATE_JITTER
+        : FOOTPATH_LENGTH * random_fraction(state);
+    double angle = 2 * PI * random_fraction(state);
+    endpoint_t end;
+    end.lon = inside(start.lon + length * cos(angle), ROOT_BL_X, ROOT_TR_X);
+    end.lat = inside(start.lat + length * sin(angle), ROOT_BL_Y, ROOT_TR_Y);
+    return end;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       GENERATES a deterministic pseudo-random fraction
+ * @param[out]  state   The generator's state (advanced by one step)
+ * @return      A double in [0, 1)
+*/
+double
+random_fraction(unsigned long *state) {
+    *state = *state * 6364136223846793005UL + 1442695040888963407UL;
+    return (double)(*state >> 11) / (double)(1UL << 53);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       GENERATES a deterministic pseudo-random STANDARD normal
+ *              deviate (i.e. the Box-Muller transform)
+ * @param[out]  state   The generator's state (advanced by two steps)
+ * @return      A double with mean 0 & standard deviation 1
+*/
+double
+random_gaussian(unsigned long *state) {
+    double u1 = 1 - random_fraction(state);
+    double u2 = random_fraction(state);
+    return sqrt(-2 * log(u1)) * cos(2 * PI * u2);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       CLAMPS a value to STRICTLY inside an interval (a point ON the
+ *              root's edge is NOT found by a point query)
+ * @param[in]   value   The value
+ * @param[in]   low     The interval's lower bound
+ * @param[in]   high    The interval's upper bound
+ * @return      The NEAREST value in [low + EDGE_MARGIN, high - EDGE_MARGIN]
+*/
+double
+inside(double value, double low, double high) {
+    low += EDGE_MARGIN;
+    high -= EDGE_MARGIN;
+    return (value < low) ? low : ((value > high) ? high : value);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       OPENS <prefix><suffix> for writing (in LARGE blocks)
+ * @param[in]   prefix  The path every output file starts with
+ * @param[in]   suffix  The rest of this file's path
+ * @return      The open file (the program EXITS if it could not be opened)
+*/
+FILE*
+open_output(const char *prefix, const char *suffix) {
+    char *filename = (char *)malloc(strlen(prefix) + strlen(suffix) + 1);
+    assert(filename != NULL);
+    strcpy(filename, prefix);
+    strcat(filename, suffix);
+    FILE *file = fopen(filename, "w");
+    if (file == NULL) {
+        fprintf(stderr, "ERROR: could not open %s\n", filename);
+        exit(EXIT_FAILURE);
+    }
+    setvbuf(file, NULL, _IOFBF, OUTPUT_BUFFER);
+    free(filename);
+    return file;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file    bitmap.c
+ * @brief   A file for the implementation of a growable bitmap
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "bitmap.h"
+#include "dynamic-array.h"
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+void bitmap_grow(bitmap_t *bitmap, int word_count);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       INITIALISES an EMPTY bitmap on the heap
+ * @return      A POINTER to a heap-allocated bitmap
+*/
+bitmap_t*
+bitmap_init(void) {
+
+    // NOTE: the words are only allocated once the 1st bit is set
+    bitmap_t *new_bitmap = (bitmap_t *)malloc(sizeof(bitmap_t));
+    assert(new_bitmap != NULL);
+    new_bitmap->words = NULL;
+    new_bitmap->word_count = 0;
+    return new_bitmap;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       SETS a bit, growing the bitmap if needed
+ * @param[out]  bitmap  The bitmap
+ * @param[in]   bit     The (non-negative) bit to set
+ * @return      An integer flag where: 0 means the bit was ALREADY set & 1
+ *              means it has just been set
+*/
+int
+bitmap_test_and_set(bitmap_t *bitmap, int bit) {
+
+    // STEP 1: Make room for the bit
+    assert(bit >= 0);
+    int word = bit / BITMAP_WORD_BITS;
+    if (word >= bitmap->word_count) {
+        bitmap_grow(bitmap, word + 1);
+    }
+
+    // STEP 2: Set the bit, reporting whether it was already set
+    uint64_t mask = (uint64_t)1 << (bit % BITMAP_WORD_BITS);
+    if (bitmap->words[word] & mask) {
+        return 0;
+    }
+    bitmap->words[word] |= mask;
+    return 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       CLEARS a bit that was previously set
+ * @param[out]  bitmap  The bitmap
+ * @param[in]   bit     The bit to clear
+*/
+void
+bitmap_clear(bitmap_t *bitmap, int bit) {
+    assert((bit >= 0) && (bit / BITMAP_WORD_BITS < bitmap->word_count));
+    bitmap->words[bit / BITMAP_WORD_BITS] &= 
+        ~((uint64_t)1 << (bit % BITMAP_WORD_BITS));
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       CLEARS EVERY bit of a bitmap (keeping it's words)
+ * @param[out]  bitmap  The bitmap
+*/
+void
+bitmap_reset(bitmap_t *bitmap) {
+    if (bitmap->word_count > 0) {
+        memset(bitmap->words, 0, bitmap->word_count * sizeof(uint64_t));
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FREES a bitmap from the heap
+ * @param[out]  bitmap  The bitmap to free
+*/
+void
+bitmap_free(bitmap_t *bitmap) {
+    free(bitmap->words);
+    free(bitmap);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - GROWS a bitmap to AT LEAST 'word_count' words
+ * @param[out]  bitmap      The bitmap
+ * @param[in]   word_count  The number of words needed
+ * @note        The new words are ZEROED (i.e. their bits are clear)
+*/
+void
+bitmap_grow(bitmap_t *bitmap, int word_count) {
+
+    int new_count = bitmap->word_count ? bitmap->word_count : 1;
+    while (new_count < word_count) {
+        new_count *= REALLOC_FACTOR;
+    }
+    bitmap->words = (uint64_t *)realloc(bitmap->words, 
+        new_count * sizeof(uint64_t));
+    assert(bitmap->words != NULL);
+    memset(bitmap->words + bitmap->word_count, 0, 
+        (new_count - bitmap->word_count) * sizeof(uint64_t));
+    bitmap->word_count = new_count;
+}
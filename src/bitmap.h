@@ -0,0 +1,78 @@
+/**
+ * @file    bitmap.h
+ * @brief   A HEADER file for the implementation of a growable bitmap
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          A bitmap is a SET of small non-negative integers (e.g. record
+ *          numbers) with one bit each. It grows to fit the largest integer
+ *          ever added, & is EMPTIED by clearing the bits that were set rather
+ *          than by wiping the whole map
+*/
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#ifndef _BITMAP_H_
+#define _BITMAP_H_
+
+#define BITMAP_WORD_BITS 64     // The bits held by ONE word of a bitmap
+
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT FILES
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   A GROWABLE bitmap
+ * @param   words       The bits of the map (bit i is in word i/64)
+ * @param   word_count  The number of words allocated
+*/
+typedef struct bitmap bitmap_t;
+struct bitmap {
+    uint64_t        *words;
+    int             word_count;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// BITMAP OPERATIONS:
+
+/**
+ * @brief       INITIALISES an EMPTY bitmap on the heap
+ * @return      A POINTER to a heap-allocated bitmap
+*/
+bitmap_t* bitmap_init(void);
+
+/**
+ * @brief       SETS a bit, growing the bitmap if needed
+ * @param[out]  bitmap  The bitmap
+ * @param[in]   bit     The (non-negative) bit to set
+ * @return      An integer flag where: 0 means the bit was ALREADY set & 1
+ *              means it has just been set
+*/
+int bitmap_test_and_set(bitmap_t *bitmap, int bit);
+
+/**
+ * @brief       CLEARS a bit that was previously set
+ * @param[out]  bitmap  The bitmap
+ * @param[in]   bit     The bit to clear
+*/
+void bitmap_clear(bitmap_t *bitmap, int bit);
+
+/**
+ * @brief       CLEARS EVERY bit of a bitmap (keeping it's words)
+ * @param[out]  bitmap  The bitmap
+*/
+void bitmap_reset(bitmap_t *bitmap);
+
+/**
+ * @brief       FREES a bitmap from the heap
+ * @param[out]  bitmap  The bitmap to free
+*/
+void bitmap_free(bitmap_t *bitmap);
+
+#endif
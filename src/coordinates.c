@@ -13,6 +13,90 @@
 #include <math.h>
 
 #include "coordinates.h"
+#include "stats.h"
+
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#if COORD_MODE == COORD_LONG_DOUBLE
+#define COORD_FABS fabsl
+#else
+#define COORD_FABS fabs
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   The real-world frame FIXED coordinates are quantised against
+ * @param   min_x   The real-world x-coordinate mapped to -HALF_SPAN
+ * @param   min_y   The real-world y-coordinate mapped to -HALF_SPAN
+ * @param   scale_x The number of fixed units per real-world x unit
+ * @param   scale_y The number of fixed units per real-world y unit
+*/
+typedef struct coord_frame coord_frame_t;
+struct coord_frame {
+    long double     min_x;
+    long double     min_y;
+    long double     scale_x;
+    long double     scale_y;
+};
+
+static coord_frame_t frame = {0, 0, 0, 0};
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+coord_t coord_quantise(long double value, long double min, long double scale);
+long double coord_haversine(long double x1, long double y1, long double x2, 
+    long double y2);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       SETS the real-world frame that FIXED coordinates are relative
+ *              to (i.e. the root bounds), & does nothing otherwise
+ * @param[in]   bl_x    BOTTOM-LEFT real-world x-coordinate of the root
+ * @param[in]   bl_y    BOTTOM-LEFT real-world y-coordinate of the root
+ * @param[in]   tr_x    TOP-RIGHT real-world x-coordinate of the root
+ * @param[in]   tr_y    TOP-RIGHT real-world y-coordinate of the root
+ * @note        Must be called BEFORE any point is quantised
+*/
+void
+coord_frame_init(long double bl_x, long double bl_y, long double tr_x,
+    long double tr_y) {
+
+    // NOTE: the root spans EXACTLY 2^31 units, so halving it is exact for
+    //       the 31 levels it takes to reach a single unit
+#if COORD_MODE == COORD_FIXED
+    assert((tr_x > bl_x) && (tr_y > bl_y));
+#endif
+    frame.min_x = bl_x;
+    frame.min_y = bl_y;
+    frame.scale_x = (2.0L * COORD_FIXED_HALF_SPAN) / (tr_x - bl_x);
+    frame.scale_y = (2.0L * COORD_FIXED_HALF_SPAN) / (tr_y - bl_y);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       QUANTISES a real-world xy-point into the coordinate type
+ * @param[in]   x    The HORIZONTAL component: x-coordinate
+ * @param[in]   y    The VERTICAL component: y-coordinate
+ * @return      A new point_2d_t (points beyond the frame are CLAMPED, but
+ *              still lie outside the root)
+*/
+point_2d_t
+point_2d_quantise(long double x, long double y) {
+
+#if COORD_MODE == COORD_FIXED
+    return point_2d_init(coord_quantise(x, frame.min_x, frame.scale_x),
+        coord_quantise(y, frame.min_y, frame.scale_y));
+#else
+    return point_2d_init((coord_t)x, (coord_t)y);
+#endif
+}
 
 /* -------------------------------------------------------------------------- */
 
@@ -23,7 +107,7 @@
  * @return      A new point_2d_t
 */
 point_2d_t 
-point_2d_init(long double x, long double y) {
+point_2d_init(coord_t x, coord_t y) {
 
     point_2d_t new_point;
     new_point.x = x;
@@ -40,7 +124,7 @@ point_2d_init(long double x, long double y) {
  * @return      A pointer to a new point_2d_t 
 */
 point_2d_t* 
-point_2d_malloc(long double x, long double y) {
+point_2d_malloc(coord_t x, coord_t y) {
 
     point_2d_t *new_point = (point_2d_t *)malloc(sizeof(point_2d_t));
     assert(new_point);
@@ -61,9 +145,19 @@ point_2d_malloc(long double x, long double y) {
 */
 int 
 equal_point_2d(point_2d_t point1, point_2d_t point2) {
-    
+
+#if COORD_MODE == COORD_FIXED
+    // NOTE: values closer than MY_LDBL_EPSILON may still round either side
+    //       of a unit, so allow for a unit of slack
+    return ((llabs((int64_t)point1.x - point2.x) <= COORD_FIXED_EPSILON)
+        && (llabs((int64_t)point1.y - point2.y) <= COORD_FIXED_EPSILON));
+#elif COORD_MODE == COORD_DOUBLE
+    return ((fabs(point1.x - point2.x) < MY_LDBL_EPSILON)
+        && (fabs(point1.y - point2.y) < MY_LDBL_EPSILON));
+#else
     return ((cmp_long_double(point1.x, point2.x) == EQUAL) 
         && (cmp_long_double(point1.y, point2.y) == EQUAL));
+#endif
 }
 
 /* -------------------------------------------------------------------------- */
@@ -79,8 +173,13 @@ rectangle_t rectangle_init(point_2d_t bl, point_2d_t tr) {
     rectangle_t new_rectangle;
     new_rectangle.bl = bl;
     new_rectangle.tr = tr;
-    new_rectangle.hw = fabsl(tr.x - bl.x)/2.0;
-    new_rectangle.hh = fabsl(tr.y - bl.y)/2.0;
+#if COORD_MODE == COORD_FIXED
+    new_rectangle.hw = (coord_t)(llabs((int64_t)tr.x - bl.x)/2);
+    new_rectangle.hh = (coord_t)(llabs((int64_t)tr.y - bl.y)/2);
+#else
+    new_rectangle.hw = COORD_FABS(tr.x - bl.x)/2.0;
+    new_rectangle.hh = COORD_FABS(tr.y - bl.y)/2.0;
+#endif
     new_rectangle.ctr.x = tr.x - new_rectangle.hw;
     new_rectangle.ctr.y = tr.y - new_rectangle.hh;
     return new_rectangle;
@@ -102,10 +201,17 @@ rectangle_t rectangle_init(point_2d_t bl, point_2d_t tr) {
 int 
 rectangle_contains(rectangle_t bounds, point_2d_t point) {
 
+    STATS_COUNT(contains_calls, 1);
+#if COORD_MODE == COORD_FIXED
+    // NOTE: halving an ODD width rounds, so compare against the corners
+    return (((point.x > bounds.bl.x) && (point.x <= bounds.tr.x))
+        && ((point.y >= bounds.bl.y) && (point.y < bounds.tr.y)));
+#else
     return (((point.x > bounds.ctr.x - bounds.hw) 
         && (point.x <= bounds.ctr.x + bounds.hw)) 
         && ((point.y >= bounds.ctr.y - bounds.hh) 
         && (point.y < bounds.ctr.y + bounds.hh)));
+#endif
 }
 
 /* -------------------------------------------------------------------------- */
@@ -124,7 +230,200 @@ rectangle_contains(rectangle_t bounds, point_2d_t point) {
 int 
 rectangle_intersect(rectangle_t *r1, rectangle_t *r2) {
 
-    return ((fabsl(r1->ctr.x - r2->ctr.x) <= 
-        (r1->hw + r2->hw)) && ((fabsl(r1->ctr.y - r2->ctr.y)) <= 
+    STATS_COUNT(intersect_calls, 1);
+#if COORD_MODE == COORD_FIXED
+    return ((r1->bl.x <= r2->tr.x) && (r2->bl.x <= r1->tr.x)
+        && (r1->bl.y <= r2->tr.y) && (r2->bl.y <= r1->tr.y));
+#elif COORD_MODE == COORD_DOUBLE
+    return ((fabs(r1->ctr.x - r2->ctr.x) <= 
+        (r1->hw + r2->hw + MY_LDBL_EPSILON)) 
+        && (fabs(r1->ctr.y - r2->ctr.y) <= 
+        (r1->hh + r2->hh + MY_LDBL_EPSILON)));
+#else
+    return ((COORD_FABS(r1->ctr.x - r2->ctr.x) <= 
+        (r1->hw + r2->hw)) && ((COORD_FABS(r1->ctr.y - r2->ctr.y)) <= 
         (r1->hh + r2->hh)));
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       INITIALISES a Circle
+ * @param[in]   ctr     CENTER coordinate
+ * @param[in]   radius  The radius (in coordinate units or metres, as per 
+ *                      metric)
+ * @param[in]   metric  Either DISTANCE_PLANAR or DISTANCE_HAVERSINE
+ * @return      A new circle_t
+*/
+circle_t 
+circle_init(point_2d_t ctr, long double radius, int metric) {
+    circle_t circle;
+    circle.ctr = ctr;
+    circle.radius = radius;
+    circle.metric = metric;
+    return circle;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       CHECKS whether a xy point is WITHIN a circle
+ * @param[in]   circle  A pointer to the circle
+ * @param[in]   point   The point to see if it is within the circle
+ * @return      An INTEGER flag where: 0 indicates the point is NOT within
+ *              the circle & 1 denotes the point is WITHIN it
+*/
+int 
+circle_contains(circle_t *circle, point_2d_t point) {
+    STATS_COUNT(contains_calls, 1);
+    return point_2d_distance(circle->ctr, point, circle->metric) 
+        <= circle->radius;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       CHECKS if a circle & a rectangle INTERSECT
+ * @param[in]   circle  A pointer to the circle
+ * @param[in]   bounds  A pointer to the rectangle
+ * @return      An INTEGER flag where: 0 indicates that they DO NOT intersect
+ *              & 1 indicates that they DO intersect
+ * @note        The test is EXACT (i.e. the rectangle's nearest point lies
+ *              within the circle), NOT a test against the circle's bounding
+ *              square
+*/
+int 
+circle_intersect(circle_t *circle, rectangle_t *bounds) {
+    STATS_COUNT(intersect_calls, 1);
+    return rectangle_distance(bounds, circle->ctr, circle->metric) 
+        <= circle->radius;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       CONVERTS a point back to real-world coordinates
+ * @param[in]   point   The point (as quantised by point_2d_quantise())
+ * @param[out]  x       The real-world x-coordinate
+ * @param[out]  y       The real-world y-coordinate
+*/
+void
+point_2d_real(point_2d_t point, long double *x, long double *y) {
+
+#if COORD_MODE == COORD_FIXED
+    *x = ((long double)point.x + COORD_FIXED_HALF_SPAN) / frame.scale_x 
+        + frame.min_x;
+    *y = ((long double)point.y + COORD_FIXED_HALF_SPAN) / frame.scale_y 
+        + frame.min_y;
+#else
+    *x = (long double)point.x;
+    *y = (long double)point.y;
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       MEASURES the distance between TWO points
+ * @param[in]   point1  1st point
+ * @param[in]   point2  2nd point
+ * @param[in]   metric  Either DISTANCE_PLANAR or DISTANCE_HAVERSINE
+ * @return      The distance (in coordinate units or metres respectively)
+*/
+long double
+point_2d_distance(point_2d_t point1, point_2d_t point2, int metric) {
+
+    long double x1, y1, x2, y2;
+    point_2d_real(point1, &x1, &y1);
+    point_2d_real(point2, &x2, &y2);
+    if (metric == DISTANCE_HAVERSINE) {
+        return coord_haversine(x1, y1, x2, y2);
+    }
+    return hypotl(x2 - x1, y2 - y1);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       MEASURES the SHORTEST distance from a point to a rectangle
+ * @param[in]   bounds  The rectangle
+ * @param[in]   point   The point
+ * @param[in]   metric  Either DISTANCE_PLANAR or DISTANCE_HAVERSINE
+ * @return      The distance to the nearest point of the rectangle (0 if the
+ *              point lies within it), which is NEVER more than the distance
+ *              to any point within it
+*/
+long double
+rectangle_distance(rectangle_t *bounds, point_2d_t point, int metric) {
+
+    long double x, y, min_x, min_y, max_x, max_y;
+    point_2d_real(point, &x, &y);
+    point_2d_real(bounds->bl, &min_x, &min_y);
+    point_2d_real(bounds->tr, &max_x, &max_y);
+    long double near_y = fminl(fmaxl(y, min_y), max_y);
+
+    // CASE 1: Planar distance to the nearest point of the rectangle
+    if (metric != DISTANCE_HAVERSINE) {
+        return hypotl(fmaxl(fmaxl(min_x - x, x - max_x), 0.0L), y - near_y);
+    }
+
+    // CASE 2: Within the rectangle's longitudes, the nearest point is due 
+    //         NORTH or SOUTH (i.e. along a meridian)
+    if ((x >= min_x) && (x <= max_x)) {
+        return coord_haversine(x, y, x, near_y);
+    }
+
+    // CASE 3: Otherwise it lies on the NEARER meridian edge (every point of
+    //         the other edges is further away than that edge's corner), at
+    //         the latitude closest to the point's great circle
+    long double edge_x = (x < min_x) ? min_x : max_x;
+    long double lat = y * DEGREES_TO_RADIANS;
+    long double dlon = (x - edge_x) * DEGREES_TO_RADIANS;
+    long double closest_y = atan2l(sinl(lat), cosl(lat) * cosl(dlon)) 
+        / DEGREES_TO_RADIANS;
+    return coord_haversine(x, y, edge_x, 
+        fminl(fmaxl(closest_y, min_y), max_y));
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - QUANTISES ONE real-world component of a point
+ * @param[in]   value   The real-world value
+ * @param[in]   min     The real-world value mapped to -HALF_SPAN
+ * @param[in]   scale   The number of fixed units per real-world unit
+ * @return      The nearest fixed coordinate, CLAMPED to the int32_t range
+*/
+coord_t
+coord_quantise(long double value, long double min, long double scale) {
+
+    assert(scale > 0);
+    long double scaled = roundl((value - min) * scale) - COORD_FIXED_HALF_SPAN;
+    if (scaled < INT32_MIN) return INT32_MIN;
+    if (scaled > INT32_MAX) return INT32_MAX;
+    return (coord_t)scaled;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - MEASURES the great-circle distance between TWO
+ *              real-world points using the HAVERSINE formula
+ * @param[in]   x1  The longitude of the 1st point (in degrees)
+ * @param[in]   y1  The latitude of the 1st point (in degrees)
+ * @param[in]   x2  The longitude of the 2nd point (in degrees)
+ * @param[in]   y2  The latitude of the 2nd point (in degrees)
+ * @return      The distance in metres
+*/
+long double
+coord_haversine(long double x1, long double y1, long double x2, 
+    long double y2) {
+
+    long double half_dlat = (y2 - y1) * DEGREES_TO_RADIANS / 2.0L;
+    long double half_dlon = (x2 - x1) * DEGREES_TO_RADIANS / 2.0L;
+    long double a = sinl(half_dlat) * sinl(half_dlat) 
+        + cosl(y1 * DEGREES_TO_RADIANS) * cosl(y2 * DEGREES_TO_RADIANS) 
+        * sinl(half_dlon) * sinl(half_dlon);
+    return 2.0L * EARTH_RADIUS_METRES * asinl(sqrtl(fminl(a, 1.0L)));
 }
\ No newline at end of file
@@ -10,13 +10,49 @@
 #ifndef _CARTESIAN_COORDINATES_H_
 #define _CARTESIAN_COORDINATES_H_
 
+// NOTE: the coordinate representation is chosen at COMPILE time (e.g. with
+//       -DCOORD_MODE=COORD_FIXED), & a 'make clean' is needed to switch
+#define COORD_LONG_DOUBLE 1         // 80-bit x87 long doubles (the original)
+#define COORD_DOUBLE 2              // 64-bit SSE doubles
+#define COORD_FIXED 3               // 32-bit integers relative to the root
+
+#ifndef COORD_MODE
+#define COORD_MODE COORD_DOUBLE
+#endif
+
+#define COORD_FIXED_HALF_SPAN 1073741824L   // Root maps onto [-2^30, 2^30]
+#define COORD_FIXED_EPSILON 1               // Units apart still deemed EQUAL
+
+#define DISTANCE_PLANAR 1       // Straight-line distance in coordinate units
+#define DISTANCE_HAVERSINE 2    // Great-circle distance in metres (x is the 
+                                // longitude & y the latitude, in degrees)
+#define EARTH_RADIUS_METRES 6371008.8L      // The Earth's MEAN radius
+#define DEGREES_TO_RADIANS 0.017453292519943295769236907684886127L
+
 /* -------------------------------------------------------------------------- */
 
 // RELEVANT HEADER FILES:
+#include <stdint.h>
+
 #include "cmp.h"
 
 /* -------------------------------------------------------------------------- */
 
+// TYPE DEFINITIONS:
+
+/**
+ * @brief   A SINGLE coordinate component (i.e. an x or y value)
+*/
+#if COORD_MODE == COORD_FIXED
+typedef int32_t coord_t;
+#elif COORD_MODE == COORD_DOUBLE
+typedef double coord_t;
+#else
+typedef long double coord_t;
+#endif
+
+/* -------------------------------------------------------------------------- */
+
 // STRUCTURE DEFINITIONS:
 
 /**
@@ -26,8 +62,8 @@
 */
 typedef struct point_2d point_2d_t;
 struct point_2d {
-    long double     x;
-    long double     y;
+    coord_t         x;
+    coord_t         y;
 };
 
 /**
@@ -43,21 +79,55 @@ struct rectangle {
     point_2d_t      bl;
     point_2d_t      tr;
     point_2d_t      ctr;
-    long double     hw;
-    long double     hh;
+    coord_t         hw;
+    coord_t         hh;
+};
+
+/**
+ * @brief   Defines the centre & radius of a CIRCLE
+ * @param   ctr     CENTER coordinates of the circle
+ * @param   radius  The radius (in coordinate units or metres, as per metric)
+ * @param   metric  Either DISTANCE_PLANAR or DISTANCE_HAVERSINE
+*/
+typedef struct circle circle_t;
+struct circle {
+    point_2d_t      ctr;
+    long double     radius;
+    int             metric;
 };
 
 /* -------------------------------------------------------------------------- */
 
 // FUNCTION PROTOTYPES:
 
+/**
+ * @brief       SETS the real-world frame that FIXED coordinates are relative
+ *              to (i.e. the root bounds), & does nothing otherwise
+ * @param[in]   bl_x    BOTTOM-LEFT real-world x-coordinate of the root
+ * @param[in]   bl_y    BOTTOM-LEFT real-world y-coordinate of the root
+ * @param[in]   tr_x    TOP-RIGHT real-world x-coordinate of the root
+ * @param[in]   tr_y    TOP-RIGHT real-world y-coordinate of the root
+ * @note        Must be called BEFORE any point is quantised
+*/
+void coord_frame_init(long double bl_x, long double bl_y, long double tr_x,
+    long double tr_y);
+
+/**
+ * @brief       QUANTISES a real-world xy-point into the coordinate type
+ * @param[in]   x    The HORIZONTAL component: x-coordinate
+ * @param[in]   y    The VERTICAL component: y-coordinate
+ * @return      A new point_2d_t (points beyond the frame are CLAMPED, but
+ *              still lie outside the root)
+*/
+point_2d_t point_2d_quantise(long double x, long double y);
+
 /**
  * @brief       INITIALISES a 2D point
  * @param[in]   x    The HORIZONTAL component: x-coordinate
  * @param[in]   y    The VERTICAL component: y-coordinate
  * @return      A new point_2d_t
 */
-point_2d_t point_2d_init(long double x, long double y);
+point_2d_t point_2d_init(coord_t x, coord_t y);
 
 /**
  * @brief       INTIALISES a 2D point on the HEAP
@@ -65,7 +135,7 @@ point_2d_t point_2d_init(long double x, long double y);
  * @param[in]   y    The VERTICAL component: y-coordinate
  * @return      A pointer to a new point_2d_t 
 */
-point_2d_t* point_2d_malloc(long double x, long double y);
+point_2d_t* point_2d_malloc(coord_t x, coord_t y);
 
 /**
  * @brief       CHECKS if TWO points are EQUAL
@@ -110,4 +180,65 @@ int rectangle_contains(rectangle_t bounds, point_2d_t point);
 */
 int rectangle_intersect(rectangle_t *r1, rectangle_t *r2);
 
+/**
+ * @brief       INITIALISES a Circle
+ * @param[in]   ctr     CENTER coordinate
+ * @param[in]   radius  The radius (in coordinate units or metres, as per 
+ *                      metric)
+ * @param[in]   metric  Either DISTANCE_PLANAR or DISTANCE_HAVERSINE
+ * @return      A new circle_t
+*/
+circle_t circle_init(point_2d_t ctr, long double radius, int metric);
+
+/**
+ * @brief       CHECKS whether a xy point is WITHIN a circle
+ * @param[in]   circle  A pointer to the circle
+ * @param[in]   point   The point to see if it is within the circle
+ * @return      An INTEGER flag where: 0 indicates the point is NOT within
+ *              the circle & 1 denotes the point is WITHIN it
+*/
+int circle_contains(circle_t *circle, point_2d_t point);
+
+/**
+ * @brief       CHECKS if a circle & a rectangle INTERSECT
+ * @param[in]   circle  A pointer to the circle
+ * @param[in]   bounds  A pointer to the rectangle
+ * @return      An INTEGER flag where: 0 indicates that they DO NOT intersect
+ *              & 1 indicates that they DO intersect
+ * @note        The test is EXACT (i.e. the rectangle's nearest point lies
+ *              within the circle), NOT a test against the circle's bounding
+ *              square
+*/
+int circle_intersect(circle_t *circle, rectangle_t *bounds);
+
+/**
+ * @brief       CONVERTS a point back to real-world coordinates
+ * @param[in]   point   The point (as quantised by point_2d_quantise())
+ * @param[out]  x       The real-world x-coordinate
+ * @param[out]  y       The real-world y-coordinate
+*/
+void point_2d_real(point_2d_t point, long double *x, long double *y);
+
+/**
+ * @brief       MEASURES the distance between TWO points
+ * @param[in]   point1  1st point
+ * @param[in]   point2  2nd point
+ * @param[in]   metric  Either DISTANCE_PLANAR or DISTANCE_HAVERSINE
+ * @return      The distance (in coordinate units or metres respectively)
+*/
+long double point_2d_distance(point_2d_t point1, point_2d_t point2, 
+    int metric);
+
+/**
+ * @brief       MEASURES the SHORTEST distance from a point to a rectangle
+ * @param[in]   bounds  The rectangle
+ * @param[in]   point   The point
+ * @param[in]   metric  Either DISTANCE_PLANAR or DISTANCE_HAVERSINE
+ * @return      The distance to the nearest point of the rectangle (0 if the
+ *              point lies within it), which is NEVER more than the distance
+ *              to any point within it
+*/
+long double rectangle_distance(rectangle_t *bounds, point_2d_t point, 
+    int metric);
+
 #endif
\ No newline at end of file
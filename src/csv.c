@@ -0,0 +1,566 @@
+/**
+ * @file    csv.c
+ * @brief   A file for the implementation of a memory-mapped CSV reader
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <stdint.h>
+#include <float.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <pthread.h>
+
+#include "csv.h"
+#include "dynamic-array.h"
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+int csv_parse_row(csv_file_t *csv, size_t *pos, data_t *dest);
+int csv_parse_string(csv_file_t *csv, size_t *pos, string_view_t *view);
+int csv_parse_int(csv_file_t *csv, size_t *pos, int *value);
+int csv_parse_long_double(csv_file_t *csv, size_t *pos, long double *value);
+int csv_expect(csv_file_t *csv, size_t *pos, char delim);
+void csv_skip_blanks(csv_file_t *csv, size_t *pos);
+size_t csv_row_boundary(csv_file_t *csv, size_t begin, size_t offset, 
+    size_t quotes_before);
+void* csv_count_worker(void *arg);
+void* csv_parse_worker(void *arg);
+
+/* -------------------------------------------------------------------------- */
+
+// NOTE: 10^0 ... 10^27 are ALL exactly representable in an x87 long double
+static const long double powers_of_10[CSV_FAST_EXPONENT + 1] = {
+    1e0L,  1e1L,  1e2L,  1e3L,  1e4L,  1e5L,  1e6L,  1e7L,  1e8L,  1e9L,
+    1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L, 1e19L,
+    1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L
+};
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       OPENS a CSV file by mapping it into memory
+ * @param[in]   filename    The path of the CSV file
+ * @return      A POINTER to a heap-allocated csv_file_t (positioned AFTER the
+ *              header row), & NULL if the file could not be mapped
+*/
+csv_file_t*
+csv_open(const char *filename) {
+
+    // STEP 1: Find out how large the file is
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+        close(fd);
+        return NULL;
+    }
+
+    // STEP 2: Map the ENTIRE file (an empty file has nothing to map)
+    csv_file_t *new_csv = (csv_file_t *)malloc(sizeof(csv_file_t));
+    assert(new_csv != NULL);
+    new_csv->base = NULL;
+    new_csv->size = (size_t)info.st_size;
+    new_csv->cursor = 0;
+    if (new_csv->size > 0) {
+        void *mapping = mmap(NULL, new_csv->size, PROT_READ, MAP_PRIVATE,
+            fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            free(new_csv);
+            return NULL;
+        }
+        madvise(mapping, new_csv->size, MADV_SEQUENTIAL);
+        new_csv->base = (const char *)mapping;
+    }
+
+    // NOTE: the mapping outlives the file descriptor
+    close(fd);
+
+    // STEP 3: Skip the header row
+    const char *newline = (new_csv->size > 0)
+        ? memchr(new_csv->base, '\n', new_csv->size) : NULL;
+    new_csv->cursor = (newline != NULL)
+        ? (size_t)(newline - new_csv->base) + 1 : new_csv->size;
+    return new_csv;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       READS every remaining row of a CSV file using worker threads
+ * @param[out]  csv     The CSV file (it's cursor moves to the end)
+ * @param[in]   threads The number of threads to parse with
+ * @param[out]  count   The number of rows read
+ * @return      A heap-allocated array of the well-formed rows, IN FILE ORDER
+*/
+data_t**
+csv_read_rows(csv_file_t *csv, int threads, int *count) {
+
+    // STEP 1: Only hand out ranges that are worth a thread
+    size_t begin = csv->cursor, length = csv->size - csv->cursor;
+    if (threads < 1) threads = 1;
+    if ((size_t)threads > length / CSV_MIN_CHUNK) {
+        threads = (length / CSV_MIN_CHUNK > 0) ? length / CSV_MIN_CHUNK : 1;
+    }
+
+    // STEP 2: Split the remaining bytes into EQUAL ranges & count the quotes
+    //         in each one (in parallel)
+    csv_batch_t *batches = (csv_batch_t *)malloc(sizeof(csv_batch_t) * threads);
+    pthread_t *workers = (pthread_t *)malloc(sizeof(pthread_t) * threads);
+    assert((batches != NULL) && (workers != NULL));
+    for (int i = 0; i < threads; i++) {
+        batches[i].csv = csv;
+        batches[i].start = begin + (length * i) / threads;
+        batches[i].end = begin + (length * (i + 1)) / threads;
+        batches[i].quotes = 0;
+        batches[i].rows = NULL;
+        batches[i].count = batches[i].capacity = 0;
+        batches[i].complete = 1;
+    }
+    for (int i = 1; i < threads; i++) {
+        pthread_create(&workers[i], NULL, csv_count_worker, &batches[i]);
+    }
+    csv_count_worker(&batches[0]);
+    for (int i = 1; i < threads; i++) pthread_join(workers[i], NULL);
+
+    // STEP 3: Move every range's start onto a TRUE row boundary (i.e. after
+    //         a newline that is NOT within a quoted field)
+    size_t quotes_before = batches[0].quotes;
+    for (int i = 1; i < threads; i++) {
+        size_t boundary = csv_row_boundary(csv, begin, batches[i].start, 
+            quotes_before);
+        quotes_before += batches[i].quotes;
+        batches[i].start = boundary;
+        batches[i - 1].end = boundary;
+    }
+    for (int i = 1; i < threads; i++) {
+        if (batches[i].start < batches[i - 1].start) {
+            batches[i].start = batches[i - 1].end = batches[i - 1].start;
+        }
+    }
+
+    // STEP 4: Parse each range into it's OWN batch (in parallel)
+    for (int i = 1; i < threads; i++) {
+        pthread_create(&workers[i], NULL, csv_parse_worker, &batches[i]);
+    }
+    csv_parse_worker(&batches[0]);
+    for (int i = 1; i < threads; i++) pthread_join(workers[i], NULL);
+
+    // STEP 5: Merge the batches in file order, STOPPING (as a sequential 
+    //         read would) at the 1st malformed row
+    int total = 0, last = 0;
+    while ((last < threads - 1) && batches[last].complete) last++;
+    for (int i = 0; i <= last; i++) total += batches[i].count;
+    data_t **rows = (data_t **)malloc(sizeof(data_t *) * (total > 0 ? total : 1));
+    assert(rows != NULL);
+    *count = 0;
+    for (int i = 0; i < threads; i++) {
+        for (int j = 0; j < batches[i].count; j++) {
+            if (i <= last) {
+                rows[(*count)++] = batches[i].rows[j];
+            } else {
+                free_data(batches[i].rows[j]);
+            }
+        }
+        free(batches[i].rows);
+    }
+    csv->cursor = csv->size;
+    free(batches);
+    free(workers);
+    return rows;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       COMPUTES a checksum of EVERY byte of a CSV file
+ * @param[in]   csv     The CSV file
+ * @return      A 64-bit checksum that changes whenever the file's contents do
+ * @note        FNV-1a applied to 8 bytes at a time (with the tail bytes 
+ *              folded in ONE at a time)
+*/
+uint64_t
+csv_checksum(csv_file_t *csv) {
+
+    // STEP 1: Mix in the whole words
+    uint64_t checksum = CSV_CHECKSUM_SEED ^ csv->size;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= csv->size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, csv->base + i, sizeof(uint64_t));
+        checksum = (checksum ^ word) * CSV_CHECKSUM_PRIME;
+        checksum ^= checksum >> 32;
+    }
+
+    // STEP 2: Mix in the remaining bytes
+    for (; i < csv->size; i++) {
+        checksum = (checksum ^ (unsigned char)csv->base[i]) 
+            * CSV_CHECKSUM_PRIME;
+    }
+    return checksum;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       CLOSES a CSV file by unmapping it from memory
+ * @param[out]  csv     The CSV file to close
+ * @note        Every data_t read from csv is left with DANGLING strings
+*/
+void
+csv_close(csv_file_t *csv) {
+    if (csv->base != NULL) munmap((void *)csv->base, csv->size);
+    free(csv);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - PARSES a single CSV row
+ * @param[in]   csv     The CSV file
+ * @param[out]  pos     The offset of the row (moved past the row)
+ * @param[out]  dest    The data to fill in
+ * @return      An integer flag where: 0 means the row is MISSING or
+ *              malformed & 1 means the row was parsed
+*/
+int
+csv_parse_row(csv_file_t *csv, size_t *pos, data_t *dest) {
+
+    // NOTE: the fields are read in the SAME order as the header (& the
+    //       string views are relative to the start of the mapping)
+    int parsed = csv_parse_int(csv, pos, &dest->foothpath_id)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_string(csv, pos, &dest->address)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_string(csv, pos, &dest->clue_sa)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_string(csv, pos, &dest->asset_type)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_long_double(csv, pos, &dest->deltaz)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_long_double(csv, pos, &dest->distance)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_long_double(csv, pos, &dest->grade1in)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_long_double(csv, pos, &dest->mcc_id)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_int(csv, pos, &dest->mccid_int)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_long_double(csv, pos, &dest->rlmax)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_long_double(csv, pos, &dest->rlmin)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_string(csv, pos, &dest->segside)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_int(csv, pos, &dest->statusid)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_int(csv, pos, &dest->streetid)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_int(csv, pos, &dest->street_group)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_long_double(csv, pos, &dest->start_lat)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_long_double(csv, pos, &dest->start_lon)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_long_double(csv, pos, &dest->end_lat)
+        && csv_expect(csv, pos, COMMA)
+        && csv_parse_long_double(csv, pos, &dest->end_lon);
+    return parsed;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - PARSES a string field as a VIEW into the mapping
+ * @param[in]   csv     The CSV file
+ * @param[out]  pos     The offset of the field (moved past the field)
+ * @param[out]  view    The offset & length of the field's characters
+ * @return      An integer flag where: 0 means the field is malformed & 1
+ *              means the field was parsed
+ * @note        A field encased in "quotes" may contain commas, the quotes
+ *              themselves are NOT part of the view
+*/
+int
+csv_parse_string(csv_file_t *csv, size_t *pos, string_view_t *view) {
+
+    const char *s = csv->base;
+    size_t p = *pos;
+    if (p >= csv->size) return 0;
+
+    // CASE 1: A field encased in "quotes" ends at the CLOSING quote
+    if (s[p] == DOUBLE_QUOTE) {
+        const char *close = memchr(s + p + 1, DOUBLE_QUOTE,
+            csv->size - p - 1);
+        if (close == NULL) return 0;
+        view->offset = p + 1;
+        view->length = (int)((size_t)(close - s) - (p + 1));
+        *pos = (size_t)(close - s) + 1;
+        return 1;
+    }
+
+    // CASE 2: Otherwise the field ends at the next COMMA (& may be EMPTY)
+    size_t start = p;
+    while ((p < csv->size) && (s[p] != COMMA) && (s[p] != '\n')) p++;
+    view->offset = start;
+    view->length = (int)(p - start);
+    *pos = p;
+    return 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - PARSES an integer field (e.g. '20684.0')
+ * @param[in]   csv     The CSV file
+ * @param[out]  pos     The offset of the field (moved past the field)
+ * @param[out]  value   The integer part of the field
+ * @return      An integer flag where: 0 means the field is malformed & 1
+ *              means the field was parsed
+*/
+int
+csv_parse_int(csv_file_t *csv, size_t *pos, int *value) {
+
+    // STEP 1: Read the sign
+    csv_skip_blanks(csv, pos);
+    const char *s = csv->base;
+    size_t p = *pos;
+    int negative = 0;
+    if ((p < csv->size) && ((s[p] == '-') || (s[p] == '+'))) {
+        negative = (s[p++] == '-');
+    }
+
+    // STEP 2: Read the integer part (there must be at least ONE digit)
+    size_t first_digit = p;
+    long result = 0;
+    while ((p < csv->size) && (s[p] >= '0') && (s[p] <= '9')) {
+        result = result * 10 + (s[p++] - '0');
+    }
+    if (p == first_digit) return 0;
+
+    // STEP 3: Discard the (zero) fractional part
+    if ((p < csv->size) && (s[p] == '.')) {
+        p++;
+        while ((p < csv->size) && (s[p] >= '0') && (s[p] <= '9')) p++;
+    }
+    *value = (int)(negative ? -result : result);
+    *pos = p;
+    return 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - PARSES a decimal field into a long double
+ * @param[in]   csv     The CSV file
+ * @param[out]  pos     The offset of the field (moved past the field)
+ * @param[out]  value   The CORRECTLY rounded value of the field
+ * @return      An integer flag where: 0 means the field is malformed & 1
+ *              means the field was parsed
+ * @note        A field of at most CSV_FAST_DIGITS significant digits is ONE
+ *              exact integer scaled by ONE exact power of 10, so a single
+ *              (correctly rounded) operation gives the same value as strtold;
+ *              anything longer falls back to strtold itself
+*/
+int
+csv_parse_long_double(csv_file_t *csv, size_t *pos, long double *value) {
+
+    // STEP 1: Read the sign
+    csv_skip_blanks(csv, pos);
+    const char *s = csv->base;
+    size_t p = *pos, start = *pos;
+    int negative = 0;
+    if ((p < csv->size) && ((s[p] == '-') || (s[p] == '+'))) {
+        negative = (s[p++] == '-');
+    }
+
+    // STEP 2: Accumulate the digits (either side of the point) as an integer
+    uint64_t mantissa = 0;
+    int digits = 0, any_digits = 0, exponent = 0, point = 0;
+    for (; p < csv->size; p++) {
+        if ((s[p] == '.') && (! point)) {
+            point = 1;
+            continue;
+        }
+        if ((s[p] < '0') || (s[p] > '9')) break;
+        any_digits = 1;
+        if ((mantissa == 0) && (s[p] == '0')) {
+            exponent -= point;
+            continue;
+        }
+        if (digits < CSV_FAST_DIGITS) mantissa = mantissa * 10 + (s[p] - '0');
+        else if (! point) exponent++;
+        exponent -= (point && (digits < CSV_FAST_DIGITS));
+        digits++;
+    }
+    if (! any_digits) return 0;
+
+    // STEP 3: Read the (optional) exponent
+    if ((p < csv->size) && ((s[p] == 'e') || (s[p] == 'E'))) {
+        size_t q = p + 1;
+        int exp_negative = 0, exp_value = 0;
+        if ((q < csv->size) && ((s[q] == '-') || (s[q] == '+'))) {
+            exp_negative = (s[q++] == '-');
+        }
+        if ((q < csv->size) && (s[q] >= '0') && (s[q] <= '9')) {
+            while ((q < csv->size) && (s[q] >= '0') && (s[q] <= '9')) {
+                if (exp_value < 100000) exp_value = exp_value * 10 + (s[q] - '0');
+                q++;
+            }
+            exponent += exp_negative ? -exp_value : exp_value;
+            p = q;
+        }
+    }
+    *pos = p;
+
+    // CASE 1: The FAST path (every operand is exact in a long double)
+#if LDBL_MANT_DIG >= 64
+    if ((digits <= CSV_FAST_DIGITS) && (exponent >= -CSV_FAST_EXPONENT)
+        && (exponent <= CSV_FAST_EXPONENT)) {
+        long double result = (long double)mantissa;
+        result = (exponent < 0) ? result / powers_of_10[-exponent]
+            : result * powers_of_10[exponent];
+        *value = negative ? -result : result;
+        return 1;
+    }
+#endif
+
+    // CASE 2: Otherwise let strtold round the (copied) field
+    char field[MAX_STR_LEN + 1];
+    if (p - start > MAX_STR_LEN) return 0;
+    memcpy(field, s + start, p - start);
+    field[p - start] = '\0';
+    *value = strtold(field, NULL);
+    return 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - CONSUMES the delimiter that ends a field
+ * @param[in]   csv     The CSV file
+ * @param[out]  pos     The offset of the delimiter (moved past it)
+ * @param[in]   delim   The expected delimiter
+ * @return      An integer flag where: 0 means the delimiter is MISSING & 1
+ *              means it was consumed
+*/
+int
+csv_expect(csv_file_t *csv, size_t *pos, char delim) {
+    if ((*pos >= csv->size) || (csv->base[*pos] != delim)) return 0;
+    (*pos)++;
+    return 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - SKIPS whitespace (including blank lines)
+ * @param[in]   csv     The CSV file
+ * @param[out]  pos     The offset to skip from
+*/
+void
+csv_skip_blanks(csv_file_t *csv, size_t *pos) {
+    while ((*pos < csv->size) && ((csv->base[*pos] == ' ')
+        || (csv->base[*pos] == '\t') || (csv->base[*pos] == '\r')
+        || (csv->base[*pos] == '\n'))) {
+        (*pos)++;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - FINDS the 1st row boundary at or after an offset
+ * @param[in]   csv             The CSV file
+ * @param[in]   begin           The offset of a KNOWN row boundary
+ * @param[in]   offset          Where to start looking (must be after begin)
+ * @param[in]   quotes_before   The number of DOUBLE_QUOTEs in [begin, offset)
+ * @return      The offset of the 1st row that starts at or after offset, &
+ *              the size of the CSV if there is none
+*/
+size_t
+csv_row_boundary(csv_file_t *csv, size_t begin, size_t offset, 
+    size_t quotes_before) {
+
+    // NOTE: a row starts right AFTER a newline, so begin the scan 1 byte 
+    //       early in case offset is ALREADY a row boundary
+    assert(offset > begin);
+    size_t p = offset - 1;
+    int quoted = (quotes_before - (csv->base[p] == DOUBLE_QUOTE)) % 2;
+    for (; p < csv->size; p++) {
+        if (csv->base[p] == DOUBLE_QUOTE) {
+            quoted = ! quoted;
+        } else if ((csv->base[p] == '\n') && (! quoted)) {
+            return p + 1;
+        }
+    }
+    return csv->size;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - COUNTS the DOUBLE_QUOTEs within a batch's range
+ * @param[out]  arg     The csv_batch_t to count the quotes of
+ * @return      NULL (as required by pthread_create)
+*/
+void*
+csv_count_worker(void *arg) {
+
+    csv_batch_t *batch = (csv_batch_t *)arg;
+    const char *p = batch->csv->base + batch->start;
+    const char *end = batch->csv->base + batch->end;
+    while ((p < end) && ((p = memchr(p, DOUBLE_QUOTE, end - p)) != NULL)) {
+        batch->quotes++;
+        p++;
+    }
+    return NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - PARSES the rows that start within a batch's range
+ * @param[out]  arg     The csv_batch_t to fill
+ * @return      NULL (as required by pthread_create)
+*/
+void*
+csv_parse_worker(void *arg) {
+
+    csv_batch_t *batch = (csv_batch_t *)arg;
+    size_t pos = batch->start;
+    while (1) {
+
+        // STEP 1: Stop once the next row belongs to the next range
+        csv_skip_blanks(batch->csv, &pos);
+        if (pos >= batch->end) break;
+
+        // STEP 2: Parse the row (a malformed row ends the WHOLE read)
+        data_t *row = data_init();
+        if (! csv_parse_row(batch->csv, &pos, row)) {
+            free_data(row);
+            batch->complete = 0;
+            break;
+        }
+
+        // STEP 3: Append it to the batch
+        if (batch->count == batch->capacity) {
+            batch->capacity = batch->capacity 
+                ? batch->capacity * REALLOC_FACTOR : CSV_INIT_BATCH;
+            batch->rows = (data_t **)realloc(batch->rows, 
+                sizeof(data_t *) * batch->capacity);
+            assert(batch->rows != NULL);
+        }
+        batch->rows[batch->count++] = row;
+    }
+    return NULL;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file    csv.h
+ * @brief   A HEADER file for a memory-mapped, zero-copy CSV reader
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          The whole CSV is mapped into memory & rows are tokenised in place.
+ *          String fields are NOT copied, they are kept as (offset, length)
+ *          views into the mapping, so the CSV must stay open for as long as
+ *          any data_t read from it is in use
+*/
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#ifndef _CSV_H_
+#define _CSV_H_
+
+#define CSV_FAST_DIGITS 19      // Significant digits that fit in a uint64_t
+#define CSV_FAST_EXPONENT 27    // Largest power of 10 EXACT in a long double
+
+#define CSV_MIN_CHUNK 65536     // Fewest bytes worth handing to a thread
+#define CSV_INIT_BATCH 1024     // Initial number of rows a batch holds
+
+#define CSV_CHECKSUM_SEED 0xcbf29ce484222325ULL     // FNV-1a offset basis
+#define CSV_CHECKSUM_PRIME 0x100000001b3ULL         // FNV-1a prime
+
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT FILES
+#include <stddef.h>
+#include <stdint.h>
+
+#include "data.h"
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   A CSV file mapped into memory
+ * @param   base    The 1st byte of the mapping (NULL for an EMPTY file)
+ * @param   size    The number of bytes mapped
+ * @param   cursor  The offset of the next row to be read
+*/
+typedef struct csv_file csv_file_t;
+struct csv_file {
+    const char      *base;
+    size_t          size;
+    size_t          cursor;
+};
+
+/**
+ * @brief   The rows parsed by ONE worker thread from a byte range of a CSV
+ * @param   csv         The CSV file
+ * @param   start       The offset of the 1st byte in the range
+ * @param   end         ONE past the last byte in the range
+ * @param   quotes      The number of DOUBLE_QUOTEs within the range
+ * @param   rows        The rows starting within the range (in file order)
+ * @param   count       The number of rows
+ * @param   capacity    The number of rows there is room for
+ * @param   complete    0 if a MALFORMED row cut the range short, & 1 otherwise
+*/
+typedef struct csv_batch csv_batch_t;
+struct csv_batch {
+    csv_file_t      *csv;
+    size_t          start;
+    size_t          end;
+    size_t          quotes;
+    data_t          **rows;
+    int             count;
+    int             capacity;
+    int             complete;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// CSV OPERATIONS:
+
+/**
+ * @brief       OPENS a CSV file by mapping it into memory
+ * @param[in]   filename    The path of the CSV file
+ * @return      A POINTER to a heap-allocated csv_file_t (positioned AFTER the
+ *              header row), & NULL if the file could not be mapped
+*/
+csv_file_t* csv_open(const char *filename);
+
+/**
+ * @brief       READS every remaining row of a CSV file using worker threads
+ * @param[out]  csv     The CSV file (it's cursor moves to the end)
+ * @param[in]   threads The number of threads to parse with
+ * @param[out]  count   The number of rows read
+ * @return      A heap-allocated array of the well-formed rows, IN FILE ORDER
+*/
+data_t** csv_read_rows(csv_file_t *csv, int threads, int *count);
+
+/**
+ * @brief       COMPUTES a checksum of EVERY byte of a CSV file
+ * @param[in]   csv     The CSV file
+ * @return      A 64-bit checksum that changes whenever the file's contents do
+*/
+uint64_t csv_checksum(csv_file_t *csv);
+
+/**
+ * @brief       CLOSES a CSV file by unmapping it from memory
+ * @param[out]  csv     The CSV file to close
+ * @note        Every data_t read from csv is left with DANGLING strings
+*/
+void csv_close(csv_file_t *csv);
+
+#endif
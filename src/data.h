@@ -16,6 +16,10 @@
 #define COMMA ','           // Delimiter for a COMMA
 #define DOUBLE_QUOTE '"'    // Delimiter for a DOUBLE QUOTE
 
+// The ARGUMENTS to print a string view (into the buffer 'base') with "%.*s"
+#define VIEW_ARGS(base, data, field) \
+    (data)->field.length, ((base) + (data)->field.offset)
+
 #define EQUAL 0             // Variable 1 & 2 are equal
 #define GREATER 1           // Variable 1 is GREATER than variable 2
 #define LESS -1             // Variable 1 is LESS than variable 2
@@ -23,24 +27,40 @@
 /* -------------------------------------------------------------------------- */
 
 // LIBRARIES & RELEVANT FILES
+#include <stdio.h>
+#include <stddef.h>
+
 #include "cmp.h"
 
 /* -------------------------------------------------------------------------- */
 
 // STRUCTURE DEFINITIONS:
 
+/**
+ * @brief   A string field kept as a VIEW into the buffer it was read from
+ * @param   offset  The position of the field's 1st character RELATIVE to the
+ *                  start of that buffer (so the data is pointer-free)
+ * @param   length  The number of characters (the view is NOT terminated)
+*/
+typedef struct string_view string_view_t;
+struct string_view {
+    size_t          offset;
+    int             length;
+};
+
 /**
  * @brief   Data entries (in-order) from the Melbourne CSV file
- * @note    - 'char' can be EMPTY strings
- *          - 'char' can be no more than 128 characters
+ * @note    - strings are VIEWS (relative to the start of the mapping) into
+ *            the CSV it was read from, so they are only valid whilst the CSV
+ *            is open & can be EMPTY
  *          - 'int' are always SPECIFIED & PRESENT
 */
 typedef struct data data_t;
 struct data {
     int             foothpath_id;
-    char*           address;
-    char*           clue_sa;
-    char*           asset_type;
+    string_view_t   address;
+    string_view_t   clue_sa;
+    string_view_t   asset_type;
     long double     deltaz;
     long double     distance;
     long double     grade1in;
@@ -48,7 +68,7 @@ struct data {
     int             mccid_int;
     long double     rlmax;
     long double     rlmin;
-    char*           segside;
+    string_view_t   segside;
     int             statusid;
     int             streetid;
     int             street_group;
@@ -62,35 +82,12 @@ struct data {
 
 // FUNCTION PROTOTYPES:
 
-/**
- * @brief       UTILITY - SKIPS a line from an input file
- * @param[in]   file    The file whose line is to be SKIPPED
-*/
-void file_skip_line(FILE *file);
-
 /**
  * @brief       UTILITY - Initialises the data structure
  * @return      A pointer to an initialised data in the heap
 */
 data_t* data_init(void);
 
-/**
- * @brief       UTILITY - returns a field from a csv line
- * @param[in]   input_file  The CSV file with cursor at a string
- * @param[out]  dest        The pointer where the string to be saved
- * @return      A pointer to a string from a CSV field
- * @note        ASSUMES the next field is a string
-*/
-char* get_csv_string(FILE *input_file, char *dest);
-
-/**
- * @brief       UTILITY - Reads a single CSV line
- * @param[in]   file        The input CSV file to be read
- * @param[out]  new_data    New data to be inserted
- * @return      A pointer to the heap allocated data
-*/
-data_t* read_line_data(FILE *file, data_t *new_data);
-
 /**
  * @brief       DELETES data_t from the heap's deallocated memory
  * @param[in]   data    The data to freed from the heap
@@ -99,17 +96,10 @@ void free_data(data_t *data);
 
 /**
  * @brief       PRINTS all fields in the structure data_t
+ * @param[in]   base    The 1st byte of the CSV the data was read from
  * @param[in]   data    The structure whose components are to be printed
 */
-void print_data(data_t *data);
-
-/**
- * @brief       UTILITY - Prints data that share (i.e. match) the same key
- * @param[in]   output_file     The file to store the matches
- * @param[in]   data            The data to be printed & redirected to output
-*/
-void print_data_to_file(FILE *output_file, data_t *data);
-
+void print_data(const char *base, data_t *data);
 
 /**
  * @brief       COMPARES double variables by comparing which one is LARGER
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <math.h>
+#include <string.h>
 
 #include "dynamic-array.h"
 
@@ -28,7 +29,7 @@ array_init(void) {
     assert(new_array);
 
     // STEP 2: Allocate space on the heap for the DYNAMIC ARRAY
-    new_array->data = malloc(sizeof(data_t *) * INIT_ARRAY_SIZE);
+    new_array->data = malloc(sizeof(record_ref_t) * INIT_ARRAY_SIZE);
     assert(new_array->data);
 
     // STEP 3: Initialise the logical & physical space
@@ -65,7 +66,7 @@ array_expand(array_t *array) {
         array->physical_size *= REALLOC_FACTOR;
         array->data = 
             realloc(array->data, array->physical_size 
-                * REALLOC_FACTOR * sizeof(data_t *));
+                * REALLOC_FACTOR * sizeof(record_ref_t));
         assert(array->data);
     }
 }
@@ -78,11 +79,11 @@ array_expand(array_t *array) {
  *              - Increasing it's physical size when necessary
  *              - Keeping the array in SORTED order from LOWEST to HIGHEST
  * @param[out]  array       An array pointer
- * @param[in]   new_data    The new data to be added
- * @note        Comparisons are based off the data->grade1in parameter
+ * @param[in]   new_item    A reference to the record to be added
+ * @note        Comparisons are based off the footpath_id
 */
 void 
-array_sort_append(array_t *array, data_t *new_data) {
+array_sort_append(array_t *array, record_ref_t new_item) {
 
     // STEP 1: Check & expand if the array needs to be expanded
     array_expand(array);
@@ -96,7 +97,7 @@ array_sort_append(array_t *array, data_t *new_data) {
 
         // Start from the end & traverse backwards
         for (i = array->logical_size - 1; i >= 0 && 
-            cmp_int(get_foothpath_id(new_data), get_foothpath_id(array->data[i])) 
+            cmp_int(new_item.foothpath_id, array->data[i].foothpath_id) 
             == LESS; i--) {
             array->data[i + 1] = array->data[i];
         }
@@ -108,32 +109,148 @@ array_sort_append(array_t *array, data_t *new_data) {
     }
 
     // STEP 3: Assign the new data & updated the physical size
-    array->data[index] = new_data;
+    array->data[index] = new_item;
     array->logical_size++;
 }
 
 /* -------------------------------------------------------------------------- */
 
+/**
+ * @brief       ADDS new data to the END of the dynamic array (i.e. WITHOUT
+ *              keeping it sorted)
+ * @param[out]  array       An array pointer
+ * @param[in]   new_item    A reference to the record to be added
+*/
+void 
+array_append(array_t *array, record_ref_t new_item) {
+    array_expand(array);
+    array->data[array->logical_size++] = new_item;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       SORTS the array by footpath_id using a RADIX sort
+ * @param[out]  array   An array pointer
+ * @note        The sort is STABLE: equal footpath_ids keep their order
+*/
+void 
+array_sort(array_t *array) {
+
+    // STEP 1: Count the digits of every pass at once
+    int n = array->logical_size;
+    if (n < 2) return;
+    int counts[RADIX_PASSES][RADIX_BUCKETS];
+    memset(counts, 0, sizeof(counts));
+    for (int i = 0; i < n; i++) {
+
+        // NOTE: flipping the sign bit orders NEGATIVE ids 1st
+        uint32_t key = (uint32_t)array->data[i].foothpath_id ^ 0x80000000u;
+        for (int pass = 0; pass < RADIX_PASSES; pass++) {
+            counts[pass][(key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+        }
+    }
+
+    // STEP 2: Scatter by each digit from LEAST to MOST significant, skipping
+    //         the digits that every footpath_id shares
+    record_ref_t *from = array->data;
+    record_ref_t *to = (record_ref_t *)malloc(sizeof(record_ref_t) * n);
+    assert(to != NULL);
+    for (int pass = 0; pass < RADIX_PASSES; pass++) {
+        int shift = pass * RADIX_BITS;
+        uint32_t first = (uint32_t)from[0].foothpath_id ^ 0x80000000u;
+        if (counts[pass][(first >> shift) & (RADIX_BUCKETS - 1)] == n) {
+            continue;
+        }
+        int start = 0;
+        for (int bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+            int count = counts[pass][bucket];
+            counts[pass][bucket] = start;
+            start += count;
+        }
+        for (int i = 0; i < n; i++) {
+            uint32_t key = (uint32_t)from[i].foothpath_id ^ 0x80000000u;
+            to[counts[pass][(key >> shift) & (RADIX_BUCKETS - 1)]++] = from[i];
+        }
+        record_ref_t *swap = from;
+        from = to;
+        to = swap;
+    }
+
+    // STEP 3: Keep whichever buffer holds the sorted result
+    if (from != array->data) {
+        to = array->data;
+        array->data = from;
+        array->physical_size = n;
+    }
+    free(to);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       REMOVES all but the 1st of each run of EQUAL footpath_ids
+ * @param[out]  array   An array pointer (SORTED by footpath_id)
+*/
+void 
+array_unique(array_t *array) {
+    int kept = 0;
+    for (int i = 0; i < array->logical_size; i++) {
+        if ((kept == 0) || (array->data[i].foothpath_id 
+            != array->data[kept - 1].foothpath_id)) {
+            array->data[kept++] = array->data[i];
+        }
+    }
+    array->logical_size = kept;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       REMOVES the reference with footpath_id 'key' from the array
+ * @param[out]  array   An array pointer (SORTED by footpath_id)
+ * @param[in]   key     The footpath_id of the reference to remove
+ * @return      An integer flag where: 0 means 'key' was NOT found & 1 means
+ *              it was removed (the array STAYS sorted)
+*/
+int 
+array_remove(array_t *array, int key) {
+
+    // STEP 1: Find the reference (return early if it is absent)
+    record_ref_t *found = array_binary_search(array, key);
+    if (found == NULL) return 0;
+
+    // STEP 2: Shift every LATER reference down by one
+    int index = found - array->data;
+    memmove(found, found + 1, 
+        sizeof(record_ref_t) * (array->logical_size - index - 1));
+    array->logical_size--;
+    return 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
 /**
  * @brief       SEARCHES the array by using the BINARY SEARCH algorithm
  * @param[in]   array           An array pointer to the array to be QUERIED
  * @param[in]   key             The closest value binary search is querying for
- * @return      A long double from array that is closest to grade1in
+ * @return      A pointer to the reference with footpath_id 'key', & NULL
+ *              otherwise
 */
-data_t* 
+record_ref_t* 
 array_binary_search(array_t *array, int key) {
 
     // STEP 1: Initialise variables
     int comps = 0, lo = 0, mid, hi = array->logical_size - 1;
-    data_t **data = array->data;
-    data_t *result = NULL;
+    record_ref_t *data = array->data;
+    record_ref_t *result = NULL;
 
     // STEP 2: Keep traversing the array into the LEFT or RIGHT half
     while (lo <= hi) {
         mid = (lo + hi)/2;
 		comps++;
-        result = data[mid];
-		int cmp = cmp_int(key, get_foothpath_id(result));
+        result = &data[mid];
+		int cmp = cmp_int(key, result->foothpath_id);
 
         // CASE 1: Found an exact match (return early)
 		if (cmp == 0) return result;
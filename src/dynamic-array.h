@@ -14,10 +14,14 @@
 #define REALLOC_FACTOR 2
 #define REMAINDER_SIZE 3
 
+#define RADIX_BITS 8                        // Key bits sorted per pass
+#define RADIX_BUCKETS (1 << RADIX_BITS)     // Buckets of ONE pass
+#define RADIX_PASSES 4                      // Passes to sort a 32-bit key
+
 /* -------------------------------------------------------------------------- */
 
 // LIBRARIES & RELEVANT FILES
-#include "data.h"
+#include "record-store.h"
 
 /* -------------------------------------------------------------------------- */
 
@@ -25,13 +29,14 @@
 
 /**
  * @brief   DYNAMIC ARRAY Structure
- * @param   data            A pointer to the data
+ * @param   data            The references to the records, SORTED by
+ *                          footpath_id
  * @param   logical_size    The number of RECORDED items
  * @param   physical_size   The MAXIMUM CAPACITY of the dynamic array
 */
 typedef struct array array_t;
 struct array {
-    data_t      **data;
+    record_ref_t    *data;
     int         logical_size;
     int         physical_size;
 };
@@ -63,16 +68,47 @@ void array_expand(array_t *array);
  *              - Increasing it's physical size when necessary
  *              - Keeping the array in SORTED order from LOWEST to HIGHEST
  * @param[out]  array       An array pointer
- * @param[in]   new_data    The new data to be added
+ * @param[in]   new_item    A reference to the record to be added
+*/
+void array_sort_append(array_t *array, record_ref_t new_item);
+
+/**
+ * @brief       ADDS new data to the END of the dynamic array (i.e. WITHOUT
+ *              keeping it sorted)
+ * @param[out]  array       An array pointer
+ * @param[in]   new_item    A reference to the record to be added
+*/
+void array_append(array_t *array, record_ref_t new_item);
+
+/**
+ * @brief       SORTS the array by footpath_id using a RADIX sort
+ * @param[out]  array   An array pointer
+ * @note        The sort is STABLE: equal footpath_ids keep their order
+*/
+void array_sort(array_t *array);
+
+/**
+ * @brief       REMOVES all but the 1st of each run of EQUAL footpath_ids
+ * @param[out]  array   An array pointer (SORTED by footpath_id)
+*/
+void array_unique(array_t *array);
+
+/**
+ * @brief       REMOVES the reference with footpath_id 'key' from the array
+ * @param[out]  array   An array pointer (SORTED by footpath_id)
+ * @param[in]   key     The footpath_id of the reference to remove
+ * @return      An integer flag where: 0 means 'key' was NOT found & 1 means
+ *              it was removed (the array STAYS sorted)
 */
-void array_sort_append(array_t *array, data_t *new_data);
+int array_remove(array_t *array, int key);
 
 /**
  * @brief       SEARCHES the array by using the BINARY SEARCH algorithm
  * @param[in]   array           An array pointer to the array to be QUERIED
  * @param[in]   key             The closest value binary search is querying for
- * @return      A long double from array that is closest to grade1in
+ * @return      A pointer to the reference with footpath_id 'key', & NULL
+ *              otherwise
 */
-data_t* array_binary_search(array_t *array, int key);
+record_ref_t* array_binary_search(array_t *array, int key);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,190 @@
+/**
+ * @file    epoch.c
+ * @brief   A file for the implementation of epoch-based reclamation
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "epoch.h"
+#include "dynamic-array.h"
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+unsigned long epoch_oldest_reader(epoch_t *epoch);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       INITIALISES an epoch (with NO readers) on the heap
+ * @param[in]   reclaim     Frees a retired block
+ * @param[in]   context     Passed to every call of reclaim
+ * @return      A POINTER to a heap-allocated epoch
+*/
+epoch_t*
+epoch_init(epoch_reclaim_t reclaim, void *context) {
+
+    epoch_t *new_epoch = (epoch_t *)malloc(sizeof(epoch_t));
+    assert(new_epoch != NULL);
+    atomic_init(&new_epoch->global, EPOCH_QUIESCENT + 1);
+    for (int i = 0; i < EPOCH_MAX_READERS; i++) {
+        atomic_init(&new_epoch->readers[i], EPOCH_QUIESCENT);
+    }
+    atomic_init(&new_epoch->reader_count, 0);
+    new_epoch->retired = (epoch_retired_t *)malloc(sizeof(epoch_retired_t)
+        * EPOCH_INIT_RETIRED);
+    assert(new_epoch->retired != NULL);
+    new_epoch->retired_count = 0;
+    new_epoch->retired_capacity = EPOCH_INIT_RETIRED;
+    new_epoch->reclaim = reclaim;
+    new_epoch->context = context;
+    return new_epoch;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       REGISTERS a new reader
+ * @param[out]  epoch   The epoch to read under
+ * @return      The reader's id (passed to epoch_enter() & epoch_exit())
+*/
+int
+epoch_register(epoch_t *epoch) {
+    int reader = atomic_fetch_add(&epoch->reader_count, 1);
+    assert(reader < EPOCH_MAX_READERS);
+    return reader;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       ENTERS a read (i.e. the blocks reachable from here on are NOT
+ *              reclaimed until the reader exits)
+ * @param[out]  epoch   The epoch to read under
+ * @param[in]   reader  The reader's id
+*/
+void
+epoch_enter(epoch_t *epoch, int reader) {
+
+    // NOTE: if the writer misses this announcement it has ALREADY published
+    //       the version the reader goes on to load (both are sequentially
+    //       consistent), so nothing the reader reaches is reclaimed
+    atomic_store(&epoch->readers[reader], atomic_load(&epoch->global));
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       EXITS a read
+ * @param[out]  epoch   The epoch to read under
+ * @param[in]   reader  The reader's id
+*/
+void
+epoch_exit(epoch_t *epoch, int reader) {
+    atomic_store_explicit(&epoch->readers[reader], EPOCH_QUIESCENT,
+        memory_order_release);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       WRITER - RETIRES a block that readers may STILL be using
+ * @param[out]  epoch   The epoch
+ * @param[in]   block   The block (it must NO longer be reachable once the
+ *                      writer publishes it's next version)
+ * @param[in]   kind    What the block is (passed to the reclaim callback)
+*/
+void
+epoch_retire(epoch_t *epoch, void *block, int kind) {
+    if (epoch->retired_count == epoch->retired_capacity) {
+        epoch->retired_capacity *= REALLOC_FACTOR;
+        epoch->retired = (epoch_retired_t *)realloc(epoch->retired,
+            sizeof(epoch_retired_t) * epoch->retired_capacity);
+        assert(epoch->retired != NULL);
+    }
+    epoch_retired_t *retired = &epoch->retired[epoch->retired_count++];
+    retired->block = block;
+    retired->kind = kind;
+    retired->epoch = atomic_load_explicit(&epoch->global,
+        memory_order_relaxed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       WRITER - ADVANCES the epoch once a new version is published,
+ *              & then RECLAIMS the blocks NO reader can still be using
+ * @param[out]  epoch   The epoch
+*/
+void
+epoch_advance(epoch_t *epoch) {
+    atomic_fetch_add(&epoch->global, 1);
+    epoch_reclaim(epoch, 0);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       WRITER - RECLAIMS the retired blocks NO reader can be using
+ * @param[out]  epoch   The epoch
+ * @param[in]   force   1 to reclaim EVERY block (i.e. NO reader is inside)
+*/
+void
+epoch_reclaim(epoch_t *epoch, int force) {
+
+    // STEP 1: Blocks retired BEFORE the oldest reader entered are unreachable
+    unsigned long oldest = force ? (unsigned long)-1
+        : epoch_oldest_reader(epoch);
+
+    // STEP 2: Reclaim them, keeping the rest (in order) for later
+    int kept = 0;
+    for (int i = 0; i < epoch->retired_count; i++) {
+        epoch_retired_t *retired = &epoch->retired[i];
+        if (retired->epoch < oldest) {
+            epoch->reclaim(retired->block, retired->kind, epoch->context);
+        } else {
+            epoch->retired[kept++] = *retired;
+        }
+    }
+    epoch->retired_count = kept;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FREES an epoch from the heap (reclaiming EVERY retired block)
+ * @param[out]  epoch   The epoch to free (NO reader may be inside)
+*/
+void
+epoch_free(epoch_t *epoch) {
+    epoch_reclaim(epoch, 1);
+    free(epoch->retired);
+    free(epoch);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - FINDS the epoch the OLDEST reader entered at
+ * @param[in]   epoch   The epoch
+ * @return      The oldest announced epoch, or the CURRENT one if NO reader
+ *              is inside
+*/
+unsigned long
+epoch_oldest_reader(epoch_t *epoch) {
+    unsigned long oldest = atomic_load(&epoch->global);
+    int reader_count = atomic_load(&epoch->reader_count);
+    for (int i = 0; (i < reader_count) && (i < EPOCH_MAX_READERS); i++) {
+        unsigned long entered = atomic_load(&epoch->readers[i]);
+        if ((entered != EPOCH_QUIESCENT) && (entered < oldest)) {
+            oldest = entered;
+        }
+    }
+    return oldest;
+}
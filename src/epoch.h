@@ -0,0 +1,140 @@
+/**
+ * @file    epoch.h
+ * @brief   A HEADER file for the implementation of epoch-based reclamation
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          A SINGLE writer RETIRES the blocks a new version no longer uses,
+ *          instead of freeing them, & then ADVANCES the epoch. Readers
+ *          ANNOUNCE the epoch they entered at, & a block is only reclaimed
+ *          once EVERY reader still inside entered AFTER it was retired.
+ *          Neither readers nor the writer take a lock
+*/
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#ifndef _EPOCH_H_
+#define _EPOCH_H_
+
+#define EPOCH_MAX_READERS 64    // The readers that may register at once
+#define EPOCH_QUIESCENT 0       // Announced by a reader that is NOT inside
+#define EPOCH_INIT_RETIRED 64   // Retired blocks there is room for initially
+
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT FILES
+#include <stdatomic.h>
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   A CALLBACK freeing ONE retired block
+ * @param   block       The block to free
+ * @param   kind        Whatever the writer passed to epoch_retire()
+ * @param   context     Whatever the writer passed to epoch_init()
+*/
+typedef void (*epoch_reclaim_t)(void *block, int kind, void *context);
+
+/**
+ * @brief   A block a reader may STILL be using
+ * @param   block       The block
+ * @param   kind        What the block is (passed to the reclaim callback)
+ * @param   epoch       The epoch the block was retired at
+*/
+typedef struct epoch_retired epoch_retired_t;
+struct epoch_retired {
+    void            *block;
+    int             kind;
+    unsigned long   epoch;
+};
+
+/**
+ * @brief   The epochs of a SINGLE writer & it's readers
+ * @param   global          The CURRENT epoch (starts after EPOCH_QUIESCENT)
+ * @param   readers         The epoch each reader entered at, or
+ *                          EPOCH_QUIESCENT if it is NOT inside
+ * @param   reader_count    The number of readers registered
+ * @param   retired         The blocks waiting to be reclaimed (WRITER only)
+ * @param   retired_count   The number of retired blocks
+ * @param   retired_capacity    The number of retired blocks there is room for
+ * @param   reclaim         Frees a retired block
+ * @param   context         Passed to every call of reclaim
+*/
+typedef struct epoch epoch_t;
+struct epoch {
+    atomic_ulong    global;
+    atomic_ulong    readers[EPOCH_MAX_READERS];
+    atomic_int      reader_count;
+    epoch_retired_t *retired;
+    int             retired_count;
+    int             retired_capacity;
+    epoch_reclaim_t reclaim;
+    void            *context;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// EPOCH OPERATIONS:
+
+/**
+ * @brief       INITIALISES an epoch (with NO readers) on the heap
+ * @param[in]   reclaim     Frees a retired block
+ * @param[in]   context     Passed to every call of reclaim
+ * @return      A POINTER to a heap-allocated epoch
+*/
+epoch_t* epoch_init(epoch_reclaim_t reclaim, void *context);
+
+/**
+ * @brief       REGISTERS a new reader
+ * @param[out]  epoch   The epoch to read under
+ * @return      The reader's id (passed to epoch_enter() & epoch_exit())
+*/
+int epoch_register(epoch_t *epoch);
+
+/**
+ * @brief       ENTERS a read (i.e. the blocks reachable from here on are NOT
+ *              reclaimed until the reader exits)
+ * @param[out]  epoch   The epoch to read under
+ * @param[in]   reader  The reader's id
+*/
+void epoch_enter(epoch_t *epoch, int reader);
+
+/**
+ * @brief       EXITS a read
+ * @param[out]  epoch   The epoch to read under
+ * @param[in]   reader  The reader's id
+*/
+void epoch_exit(epoch_t *epoch, int reader);
+
+/**
+ * @brief       WRITER - RETIRES a block that readers may STILL be using
+ * @param[out]  epoch   The epoch
+ * @param[in]   block   The block (it must NO longer be reachable once the
+ *                      writer publishes it's next version)
+ * @param[in]   kind    What the block is (passed to the reclaim callback)
+*/
+void epoch_retire(epoch_t *epoch, void *block, int kind);
+
+/**
+ * @brief       WRITER - ADVANCES the epoch once a new version is published,
+ *              & then RECLAIMS the blocks NO reader can still be using
+ * @param[out]  epoch   The epoch
+*/
+void epoch_advance(epoch_t *epoch);
+
+/**
+ * @brief       WRITER - RECLAIMS the retired blocks NO reader can be using
+ * @param[out]  epoch   The epoch
+ * @param[in]   force   1 to reclaim EVERY block (i.e. NO reader is inside)
+*/
+void epoch_reclaim(epoch_t *epoch, int force);
+
+/**
+ * @brief       FREES an epoch from the heap (reclaiming EVERY retired block)
+ * @param[out]  epoch   The epoch to free (NO reader may be inside)
+*/
+void epoch_free(epoch_t *epoch);
+
+#endif
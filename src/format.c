@@ -0,0 +1,221 @@
+/**
+ * @file    format.c
+ * @brief   A file for the implementation of a text formatter
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+#include <stdint.h>
+
+#include "format.h"
+#include "dynamic-array.h"
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+void format_reserve(format_buffer_t *buffer, size_t length);
+int format_digits(char *text, uint64_t value, int width);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       INITIALISES an EMPTY buffer on the heap
+ * @return      A POINTER to a heap-allocated buffer
+*/
+format_buffer_t*
+format_init(void) {
+
+    format_buffer_t *new_buffer =
+        (format_buffer_t *)malloc(sizeof(format_buffer_t));
+    assert(new_buffer != NULL);
+    new_buffer->text = (char *)malloc(FORMAT_INIT_CAPACITY);
+    assert(new_buffer->text != NULL);
+    new_buffer->length = 0;
+    new_buffer->capacity = FORMAT_INIT_CAPACITY;
+    return new_buffer;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       APPENDS text to a buffer
+ * @param[out]  buffer  The buffer
+ * @param[in]   text    The characters to append
+ * @param[in]   length  The number of characters
+*/
+void
+format_text(format_buffer_t *buffer, const char *text, size_t length) {
+    format_reserve(buffer, length);
+    memcpy(buffer->text + buffer->length, text, length);
+    buffer->length += length;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       APPENDS an integer to a buffer (as printf()'s "%ld" would)
+ * @param[out]  buffer  The buffer
+ * @param[in]   value   The integer
+*/
+void
+format_int(format_buffer_t *buffer, long value) {
+
+    // NOTE: the magnitude is taken unsigned so LONG_MIN does NOT overflow
+    format_reserve(buffer, FORMAT_MAX_NUMBER);
+    char *text = buffer->text + buffer->length;
+    int length = 0;
+    uint64_t magnitude = (uint64_t)value;
+    if (value < 0) {
+        text[length++] = '-';
+        magnitude = -magnitude;
+    }
+    length += format_digits(text + length, magnitude, 1);
+    buffer->length += length;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       APPENDS a number with a FIXED number of decimals to a buffer
+ *              (as printf()'s "%0.<decimals>Lf" would)
+ * @param[out]  buffer      The buffer
+ * @param[in]   value       The number
+ * @param[in]   decimals    The number of decimals (at most
+ *                          FORMAT_MAX_DECIMALS)
+*/
+void
+format_fixed(format_buffer_t *buffer, long double value, int decimals) {
+
+    // STEP 1: Scale the number so the decimals kept are WHOLE (an EXACT
+    //         power of 10, so the product is rounded only once)
+    static const uint64_t powers[FORMAT_MAX_DECIMALS + 1] = {1, 10, 100,
+        1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    assert((decimals >= 0) && (decimals <= FORMAT_MAX_DECIMALS));
+    long double scaled = fabsl(value) * powers[decimals];
+    uint64_t units = 0;
+    long double fraction = 0.5L;
+    if (scaled < FORMAT_FAST_LIMIT) {
+        units = (uint64_t)scaled;
+        fraction = scaled - units;
+    }
+
+    // EXCEPTION: a HUGE (or non-finite) number, or one so close to a rounding
+    //            tie that the product's error matters, is left to printf()
+    if (fabsl(fraction - 0.5L) < FORMAT_TIE_MARGIN) {
+        format_reserve(buffer, snprintf(NULL, 0, "%0.*Lf", decimals, value)
+            + 1);
+        buffer->length += sprintf(buffer->text + buffer->length, "%0.*Lf",
+            decimals, value);
+        return;
+    }
+
+    // STEP 2: Round to the NEAREST unit, then print the whole part & the
+    //         (zero-padded) decimals (NOTE: printf() keeps the sign of a
+    //         negative number that rounds to 0)
+    units += (fraction > 0.5L);
+    format_reserve(buffer, FORMAT_MAX_NUMBER);
+    char *text = buffer->text + buffer->length;
+    int length = 0;
+    if (signbit(value)) {
+        text[length++] = '-';
+    }
+    length += format_digits(text + length, units / powers[decimals], 1);
+    if (decimals > 0) {
+        text[length++] = '.';
+        length += format_digits(text + length, units % powers[decimals],
+            decimals);
+    }
+    buffer->length += length;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       WRITES a buffer to a file once it holds a LARGE block
+ * @param[out]  buffer  The buffer (EMPTIED if it was written)
+ * @param[out]  file    The file to write to
+*/
+void
+format_spill(format_buffer_t *buffer, FILE *file) {
+    if (buffer->length >= FORMAT_BLOCK_SIZE) {
+        format_flush(buffer, file);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       WRITES EVERYTHING in a buffer to a file
+ * @param[out]  buffer  The buffer (EMPTIED)
+ * @param[out]  file    The file to write to
+*/
+void
+format_flush(format_buffer_t *buffer, FILE *file) {
+    fwrite(buffer->text, 1, buffer->length, file);
+    buffer->length = 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FREES a buffer from the heap
+ * @param[out]  buffer  The buffer to free
+*/
+void
+format_free(format_buffer_t *buffer) {
+    free(buffer->text);
+    free(buffer);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - ENSURES a buffer has room for more characters
+ * @param[out]  buffer  The buffer
+ * @param[in]   length  The number of characters about to be appended
+*/
+void
+format_reserve(format_buffer_t *buffer, size_t length) {
+    if (buffer->length + length <= buffer->capacity) {
+        return;
+    }
+    while (buffer->length + length > buffer->capacity) {
+        buffer->capacity *= REALLOC_FACTOR;
+    }
+    buffer->text = (char *)realloc(buffer->text, buffer->capacity);
+    assert(buffer->text != NULL);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - PRINTS the decimal digits of an unsigned integer
+ * @param[out]  text    Where the digits are printed (NOT null-terminated)
+ * @param[in]   value   The integer
+ * @param[in]   width   The FEWEST digits to print (padded with leading 0s)
+ * @return      The number of digits printed
+*/
+int
+format_digits(char *text, uint64_t value, int width) {
+
+    // STEP 1: Generate the digits from LEAST to MOST significant
+    char digits[FORMAT_MAX_NUMBER];
+    int count = 0;
+    do {
+        digits[count++] = '0' + (value % 10);
+        value /= 10;
+    } while ((value > 0) || (count < width));
+
+    // STEP 2: Copy them out in reading order
+    for (int i = 0; i < count; i++) {
+        text[i] = digits[count - 1 - i];
+    }
+    return count;
+}
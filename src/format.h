@@ -0,0 +1,108 @@
+/**
+ * @file    format.h
+ * @brief   A HEADER file for the implementation of a text formatter
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          Text is rendered into a GROWABLE buffer that is reused between
+ *          writes, & then handed to the file in LARGE blocks. Numbers are
+ *          converted by hand, giving the SAME characters as printf()
+ *          (which is used instead whenever the fast conversion could round
+ *          differently)
+*/
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#ifndef _FORMAT_H_
+#define _FORMAT_H_
+
+#define FORMAT_INIT_CAPACITY 4096   // Initial characters a buffer holds
+#define FORMAT_BLOCK_SIZE 65536     // Characters buffered before a write
+#define FORMAT_MAX_NUMBER 64        // Most characters a FAST number takes
+#define FORMAT_MAX_DECIMALS 9       // Most decimals converted by hand
+#define FORMAT_FAST_LIMIT 1e9L      // Largest scaled value converted by hand
+#define FORMAT_TIE_MARGIN 1e-6L     // Nearer a rounding tie uses printf()
+
+// APPENDS a string LITERAL (whose length is known at compile time)
+#define format_literal(buffer, literal) \
+    format_text((buffer), (literal), sizeof(literal) - 1)
+
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT FILES
+#include <stdio.h>
+#include <stddef.h>
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   A GROWABLE buffer of text
+ * @param   text        The characters (NOT null-terminated)
+ * @param   length      The number of characters
+ * @param   capacity    The number of characters there is room for
+*/
+typedef struct format_buffer format_buffer_t;
+struct format_buffer {
+    char            *text;
+    size_t          length;
+    size_t          capacity;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// FORMAT OPERATIONS:
+
+/**
+ * @brief       INITIALISES an EMPTY buffer on the heap
+ * @return      A POINTER to a heap-allocated buffer
+*/
+format_buffer_t* format_init(void);
+
+/**
+ * @brief       APPENDS text to a buffer
+ * @param[out]  buffer  The buffer
+ * @param[in]   text    The characters to append
+ * @param[in]   length  The number of characters
+*/
+void format_text(format_buffer_t *buffer, const char *text, size_t length);
+
+/**
+ * @brief       APPENDS an integer to a buffer (as printf()'s "%ld" would)
+ * @param[out]  buffer  The buffer
+ * @param[in]   value   The integer
+*/
+void format_int(format_buffer_t *buffer, long value);
+
+/**
+ * @brief       APPENDS a number with a FIXED number of decimals to a buffer
+ *              (as printf()'s "%0.<decimals>Lf" would)
+ * @param[out]  buffer      The buffer
+ * @param[in]   value       The number
+ * @param[in]   decimals    The number of decimals (at most
+ *                          FORMAT_MAX_DECIMALS)
+*/
+void format_fixed(format_buffer_t *buffer, long double value, int decimals);
+
+/**
+ * @brief       WRITES a buffer to a file once it holds a LARGE block
+ * @param[out]  buffer  The buffer (EMPTIED if it was written)
+ * @param[out]  file    The file to write to
+*/
+void format_spill(format_buffer_t *buffer, FILE *file);
+
+/**
+ * @brief       WRITES EVERYTHING in a buffer to a file
+ * @param[out]  buffer  The buffer (EMPTIED)
+ * @param[out]  file    The file to write to
+*/
+void format_flush(format_buffer_t *buffer, FILE *file);
+
+/**
+ * @brief       FREES a buffer from the heap
+ * @param[out]  buffer  The buffer to free
+*/
+void format_free(format_buffer_t *buffer);
+
+#endif
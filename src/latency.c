@@ -0,0 +1,216 @@
+/**
+ * @file    latency.c
+ * @brief   A file for the implementation of per-query latency histograms
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+#include <time.h>
+
+#include "latency.h"
+
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#define NS_PER_SEC 1000000000ULL
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+uint64_t latency_now(void);
+int latency_bucket(uint64_t value);
+uint64_t latency_bucket_max(int bucket);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       INITIALISES EMPTY histograms for every stage on the heap
+ * @return      A POINTER to a heap-allocated latency_t
+*/
+latency_t*
+latency_init(void) {
+    latency_t *new_latency = (latency_t *)calloc(1, sizeof(latency_t));
+    assert(new_latency != NULL);
+    return new_latency;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       STARTS timing a query, once it's line has been read (so the
+ *              time spent WAITING for the line is NOT counted)
+ * @param[out]  latency The latencies (& NULL to time nothing)
+*/
+void
+latency_start(latency_t *latency) {
+    if (latency != NULL) {
+        latency->start = latency->mark = latency_now();
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       ENDS a stage of the current query, recording it's latency
+ *              (& that of the WHOLE query once LATENCY_FORMAT ends)
+ * @param[out]  latency The latencies (& NULL to time nothing)
+ * @param[in]   stage   Either LATENCY_PARSE, LATENCY_TRAVERSE or
+ *                      LATENCY_FORMAT
+*/
+void
+latency_lap(latency_t *latency, int stage) {
+
+    // NOTE: ONE clock read per stage, as the end of a stage is the start of
+    //       the next
+    if (latency == NULL) {
+        return;
+    }
+    assert((stage >= LATENCY_PARSE) && (stage < LATENCY_TOTAL));
+    uint64_t now = latency_now();
+    latency_record(&latency->stages[stage], now - latency->mark);
+    latency->mark = now;
+    if (stage == LATENCY_FORMAT) {
+        latency_record(&latency->stages[LATENCY_TOTAL], now - latency->start);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       RECORDS a latency in a histogram
+ * @param[out]  histogram   The histogram
+ * @param[in]   value       The latency (in nanoseconds)
+*/
+void
+latency_record(latency_histogram_t *histogram, uint64_t value) {
+    histogram->counts[latency_bucket(value)]++;
+    histogram->count++;
+    if (value > histogram->max) {
+        histogram->max = value;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FINDS a percentile of the latencies in a histogram
+ * @param[in]   histogram   The histogram
+ * @param[in]   percentile  The percentile (between 0 & 100)
+ * @return      The LARGEST latency in the bucket the percentile falls into
+ *              (at most the largest recorded), & 0 if the histogram is EMPTY
+*/
+uint64_t
+latency_percentile(latency_histogram_t *histogram, double percentile) {
+
+    // STEP 1: The percentile is the latency of the rank-th SMALLEST
+    if (histogram->count == 0) {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)ceil(percentile / 100 * histogram->count);
+    if (rank < 1) rank = 1;
+
+    // STEP 2: Find the bucket holding it
+    uint64_t seen = 0;
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        seen += histogram->counts[b];
+        if (seen >= rank) {
+            uint64_t value = latency_bucket_max(b);
+            return (value < histogram->max) ? value : histogram->max;
+        }
+    }
+    return histogram->max;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       WRITES the p50, p90, p99, p99.9 & maximum of every stage as a
+ *              JSON object
+ * @param[out]  file    The file to write to
+ * @param[in]   latency The latencies
+*/
+void
+latency_write(FILE *file, latency_t *latency) {
+    static const char *names[LATENCY_STAGES] = {"parse", "traverse",
+        "format", "total"};
+    fprintf(file, "{\n");
+    for (int i = 0; i < LATENCY_STAGES; i++) {
+        latency_histogram_t *histogram = &latency->stages[i];
+        fprintf(file, "  \"%s\": {\"queries\": %llu, \"p50_ns\": %llu, "
+            "\"p90_ns\": %llu, \"p99_ns\": %llu, \"p99.9_ns\": %llu, "
+            "\"max_ns\": %llu}%s\n", names[i],
+            (unsigned long long)histogram->count,
+            (unsigned long long)latency_percentile(histogram, 50),
+            (unsigned long long)latency_percentile(histogram, 90),
+            (unsigned long long)latency_percentile(histogram, 99),
+            (unsigned long long)latency_percentile(histogram, 99.9),
+            (unsigned long long)histogram->max,
+            (i < LATENCY_STAGES - 1) ? "," : "");
+    }
+    fprintf(file, "}\n");
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FREES the latencies from the heap
+ * @param[out]  latency The latencies to free
+*/
+void
+latency_free(latency_t *latency) {
+    free(latency);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - READS the monotonic clock
+ * @return      The time (in nanoseconds) since an ARBITRARY fixed point
+*/
+uint64_t
+latency_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * NS_PER_SEC + (uint64_t)now.tv_nsec;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - FINDS the bucket of a latency
+ * @param[in]   value   The latency
+ * @return      The bucket (values below LATENCY_SUB_BUCKETS have their own,
+ *              & each LARGER power of 2 is split into LATENCY_SUB_BUCKETS)
+*/
+int
+latency_bucket(uint64_t value) {
+    if (value < LATENCY_SUB_BUCKETS) {
+        return (int)value;
+    }
+    int shift = (63 - __builtin_clzll(value)) - LATENCY_SUB_BITS;
+    return (shift + 1) * LATENCY_SUB_BUCKETS
+        + (int)((value >> shift) - LATENCY_SUB_BUCKETS);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - FINDS the LARGEST latency a bucket holds
+ * @param[in]   bucket  The bucket
+ * @return      The largest latency whose bucket is 'bucket'
+*/
+uint64_t
+latency_bucket_max(int bucket) {
+    if (bucket < LATENCY_SUB_BUCKETS) {
+        return (uint64_t)bucket;
+    }
+    int shift = bucket / LATENCY_SUB_BUCKETS - 1;
+    uint64_t sub = LATENCY_SUB_BUCKETS + bucket % LATENCY_SUB_BUCKETS;
+    return ((sub + 1) << shift) - 1;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file    latency.h
+ * @brief   A HEADER file for the implementation of per-query latency
+ *          histograms
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          Each stage of a query is timed with a MONOTONIC clock & recorded
+ *          in an HDR-style histogram: values are bucketed by their power of
+ *          2, & then LINEARLY within it, so recording is O(1) & EVERY
+ *          percentile is reported to within 1/LATENCY_SUB_BUCKETS of it's
+ *          true value, whatever the range of latencies
+*/
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#ifndef _LATENCY_H_
+#define _LATENCY_H_
+
+#define LATENCY_SUB_BITS 5                          // Precision of a bucket
+#define LATENCY_SUB_BUCKETS (1 << LATENCY_SUB_BITS) // Buckets per power of 2
+#define LATENCY_BUCKETS ((64 - LATENCY_SUB_BITS + 1) * LATENCY_SUB_BUCKETS)
+
+#define LATENCY_PARSE 0     // Parsing the (already read) query line
+#define LATENCY_TRAVERSE 1  // Querying the quad-tree
+#define LATENCY_FORMAT 2    // Printing the findings
+#define LATENCY_TOTAL 3     // ALL of the above
+#define LATENCY_STAGES 4    // The number of stages timed
+
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT FILES
+#include <stdio.h>
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   A histogram of latencies (in nanoseconds)
+ * @param   counts  The number of latencies recorded in each bucket
+ * @param   count   The number of latencies recorded
+ * @param   max     The LARGEST latency recorded
+*/
+typedef struct latency_histogram latency_histogram_t;
+struct latency_histogram {
+    uint64_t        counts[LATENCY_BUCKETS];
+    uint64_t        count;
+    uint64_t        max;
+};
+
+/**
+ * @brief   The latencies of every stage of a stream of queries
+ * @param   stages  A histogram per stage (indexed by LATENCY_PARSE, ...)
+ * @param   start   When the current query started
+ * @param   mark    When the current stage started
+*/
+typedef struct latency latency_t;
+struct latency {
+    latency_histogram_t stages[LATENCY_STAGES];
+    uint64_t        start;
+    uint64_t        mark;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// LATENCY OPERATIONS:
+
+/**
+ * @brief       INITIALISES EMPTY histograms for every stage on the heap
+ * @return      A POINTER to a heap-allocated latency_t
+*/
+latency_t* latency_init(void);
+
+/**
+ * @brief       STARTS timing a query, once it's line has been read (so the
+ *              time spent WAITING for the line is NOT counted)
+ * @param[out]  latency The latencies (& NULL to time nothing)
+*/
+void latency_start(latency_t *latency);
+
+/**
+ * @brief       ENDS a stage of the current query, recording it's latency
+ *              (& that of the WHOLE query once LATENCY_FORMAT ends)
+ * @param[out]  latency The latencies (& NULL to time nothing)
+ * @param[in]   stage   Either LATENCY_PARSE, LATENCY_TRAVERSE or
+ *                      LATENCY_FORMAT
+*/
+void latency_lap(latency_t *latency, int stage);
+
+/**
+ * @brief       RECORDS a latency in a histogram
+ * @param[out]  histogram   The histogram
+ * @param[in]   value       The latency (in nanoseconds)
+*/
+void latency_record(latency_histogram_t *histogram, uint64_t value);
+
+/**
+ * @brief       FINDS a percentile of the latencies in a histogram
+ * @param[in]   histogram   The histogram
+ * @param[in]   percentile  The percentile (between 0 & 100)
+ * @return      The LARGEST latency in the bucket the percentile falls into
+ *              (at most the largest recorded), & 0 if the histogram is EMPTY
+*/
+uint64_t latency_percentile(latency_histogram_t *histogram,
+    double percentile);
+
+/**
+ * @brief       WRITES the p50, p90, p99, p99.9 & maximum of every stage as a
+ *              JSON object
+ * @param[out]  file    The file to write to
+ * @param[in]   latency The latencies
+*/
+void latency_write(FILE *file, latency_t *latency);
+
+/**
+ * @brief       FREES the latencies from the heap
+ * @param[out]  latency The latencies to free
+*/
+void latency_free(latency_t *latency);
+
+#endif
@@ -0,0 +1,556 @@
+/**
+ * @file    linear-quad-tree.c
+ * @brief   A file for the implementation of a LINEAR quad-tree
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#include "linear-quad-tree.h"
+#include "priority-queue.h"
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+int lqt_measure(qt_node_t *root, int depth, int *entry_count,
+    int *item_count);
+void lqt_recursive_build(lqt_t *lqt, qt_node_t *root, uint64_t key,
+    int depth);
+int lqt_lower_bound(lqt_t *lqt, int lo, int hi, int depth, int quadrant);
+void lqt_recursive_range_query(lqt_t *lqt, int lo, int hi, int depth,
+    rectangle_t *bounds, path_t *path, rectangle_t *range,
+    qt_visitor_t *visitor);
+void lqt_recursive_radius_query(lqt_t *lqt, int lo, int hi, int depth,
+    rectangle_t *bounds, path_t *path, circle_t *circle, 
+    qt_visitor_t *visitor);
+void lqt_knn_expand(lqt_t *lqt, pq_t *queue, qt_knn_t *knn,
+    lqt_knn_entry_t *entry);
+lqt_t* lqt_init(rectangle_t *bounds, int owner);
+array_t* lqt_entry_items(lqt_t *lqt, lqt_entry_t *entry, array_t *view);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       BUILDS a linear quad-tree from the nodes of a quad-tree
+ * @param[in]   root    The root node of the quad-tree to flatten
+ * @param[in]   bounds  The boundary of the root
+ * @return      A POINTER to a heap-allocated linear quad-tree, & NULL if a
+ *              leaf is deeper than LQT_MAX_DEPTH
+*/
+lqt_t*
+lqt_build(qt_node_t *root, rectangle_t *bounds) {
+
+    // STEP 1: Size the arrays (& check every path fits in a Morton key)
+    int entry_count = 0, item_count = 0;
+    if (lqt_measure(root, 0, &entry_count, &item_count) > LQT_MAX_DEPTH) {
+        return NULL;
+    }
+
+    // STEP 2: Allocate the linear quad-tree & its flat arrays
+    lqt_t *new_lqt = lqt_init(bounds, 1);
+    new_lqt->entries = (lqt_entry_t *)malloc(
+        sizeof(lqt_entry_t) * (entry_count > 0 ? entry_count : 1));
+    new_lqt->items = (record_ref_t *)malloc(
+        sizeof(record_ref_t) * (item_count > 0 ? item_count : 1));
+    assert((new_lqt->entries != NULL) && (new_lqt->items != NULL));
+
+    // STEP 3: A depth-first walk in NW, NE, SW, SE order emits SORTED keys
+    lqt_recursive_build(new_lqt, root, 0, 0);
+    return new_lqt;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       WRAPS arrays built elsewhere (e.g. a snapshot) as a linear 
+ *              quad-tree, WITHOUT copying them
+ * @param[in]   bounds      The boundary of the root
+ * @param[in]   entries     The points of the leaves, SORTED by key
+ * @param[in]   entry_count The number of entries
+ * @param[in]   items       The DATA of every leaf, stored back-to-back
+ * @param[in]   item_count  The number of items
+ * @return      A POINTER to a heap-allocated linear quad-tree (the arrays are
+ *              NOT freed by lqt_free())
+*/
+lqt_t*
+lqt_view(rectangle_t *bounds, lqt_entry_t *entries, int entry_count,
+    record_ref_t *items, int item_count) {
+
+    lqt_t *new_lqt = lqt_init(bounds, 0);
+    new_lqt->entries = entries;
+    new_lqt->entry_count = entry_count;
+    new_lqt->items = items;
+    new_lqt->item_count = item_count;
+    return new_lqt;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       SEARCHES a linear quad-tree for a xy-point
+ * @param[in]   lqt     The linear quad-tree to be queried
+ * @param[in]   point   The point to find
+ * @param[out]  path    The path of the point (& NULL to skip tracking it)
+ * @param[out]  found   Filled with a VIEW of the items stored at the point
+ *                      (so searches with DIFFERENT views may run at once)
+ * @return      found, & NULL if the point is NOT stored
+*/
+array_t*
+lqt_search(lqt_t *lqt, point_2d_t *point, path_t *path, array_t *found) {
+
+    // STEP 1: Check if the point lies in the boundary
+    if (! rectangle_contains(lqt->bounds, *point)) {
+        return NULL;
+    }
+
+    // STEP 2: Keep narrowing the run of entries whilst it is INTERNAL (i.e.
+    //         holds entries but NONE of them end at this depth, as the run
+    //         of a leaf is ONLY that leaf's points)
+    rectangle_t bounds = lqt->bounds;
+    int lo = 0, hi = lqt->entry_count, depth = 0;
+    STATS_COUNT(nodes_visited, 1);
+    while ((lo < hi) && (lqt->entries[lo].depth != depth)) {
+
+        // STEP 3: Figure out which quadrant to traverse
+        int child_flag = qt_determine_quadrant(&bounds, point, &bounds);
+        qt_path_append(path, child_flag);
+
+        // STEP 4: Binary search for the entries within that quadrant
+        int child_lo = lqt_lower_bound(lqt, lo, hi, depth, child_flag);
+        hi = lqt_lower_bound(lqt, child_lo, hi, depth, child_flag + 1);
+        lo = child_lo;
+        depth++;
+        STATS_COUNT(nodes_visited, 1);
+    }
+
+    // STEP 5: Check if the leaf holds an equivalent point
+    for (int i = lo; i < hi; i++) {
+        if (equal_point_2d(lqt->entries[i].point, *point)) {
+            return lqt_entry_items(lqt, &lqt->entries[i], found);
+        }
+    }
+    return NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FINDS all the points of a linear quad-tree within a RANGE
+ * @param[in]   lqt     The linear quad-tree to query
+ * @param[out]  path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   range   The bounded rectangle that defines a range
+ * @param[out]  visitor Where the matches are sent
+*/
+void
+lqt_range_query(lqt_t *lqt, path_t *path, rectangle_t *range,
+    qt_visitor_t *visitor) {
+
+    // NOTE: an EMPTY linear quad-tree is a single WHITE root
+    if (lqt->entry_count > 0) {
+        lqt_recursive_range_query(lqt, 0, lqt->entry_count, 0, &lqt->bounds,
+            path, range, visitor);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FINDS all the points of a linear quad-tree within a CIRCLE
+ * @param[in]   lqt     The linear quad-tree to query
+ * @param[out]  path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   circle  The circle that defines the range
+ * @param[out]  visitor Where the matches are sent
+*/
+void
+lqt_radius_query(lqt_t *lqt, path_t *path, circle_t *circle,
+    qt_visitor_t *visitor) {
+
+    // NOTE: an EMPTY linear quad-tree is a single WHITE root
+    if (lqt->entry_count > 0) {
+        lqt_recursive_radius_query(lqt, 0, lqt->entry_count, 0, &lqt->bounds,
+            path, circle, visitor);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FINDS the records of a linear quad-tree NEAREST to a point
+ * @param[in]   lqt     The linear quad-tree to query
+ * @param[out]  knn     The search (see qt_knn())
+*/
+void
+lqt_knn(lqt_t *lqt, qt_knn_t *knn) {
+
+    // NOTE: an EMPTY linear quad-tree is a single WHITE root
+    if (lqt->entry_count == 0) {
+        return;
+    }
+
+    // STEP 1: Pop the NEAREST run (or point) until k records are matched
+    pq_t *queue = pq_init(sizeof(lqt_knn_entry_t));
+    lqt_knn_entry_t entry = {0, lqt->entry_count, 0, lqt->bounds};
+    pq_push(queue, rectangle_distance(&lqt->bounds, knn->point, knn->metric),
+        &entry);
+    array_t view;
+    while ((queue->count > 0) && (knn->matches->logical_size < knn->k)) {
+        long double distance = pq_pop(queue, &entry);
+        if (entry.depth < 0) {
+            qt_knn_collect(knn, lqt_entry_items(lqt, 
+                &lqt->entries[entry.lo], &view), distance);
+        } else {
+            lqt_knn_expand(lqt, queue, knn, &entry);
+        }
+    }
+    pq_free(queue);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       MEASURES the shape of a linear quad-tree (i.e. it's leaves, as
+ *              it keeps NO other nodes) & the bytes it holds
+ * @param[in]   lqt     The linear quad-tree
+ * @param[out]  shape   A ZEROED shape, filled in
+ * @param[out]  bytes   Has the bytes held added to it
+*/
+void
+lqt_stats(lqt_t *lqt, stats_shape_t *shape, stats_bytes_t *bytes) {
+
+    // STEP 1: The entries of ONE leaf are a run sharing the same key & depth
+    shape->linear = 1;
+    int lo = 0;
+    while (lo < lqt->entry_count) {
+        int hi = lo;
+        long items = 0;
+        while ((hi < lqt->entry_count) 
+            && (lqt->entries[hi].key == lqt->entries[lo].key)
+            && (lqt->entries[hi].depth == lqt->entries[lo].depth)) {
+            items += lqt->entries[hi++].item_count;
+        }
+        shape->colours[BLACK]++;
+        stats_shape_leaf(shape, lqt->entries[lo].depth, hi - lo, items);
+        lo = hi;
+    }
+
+    // STEP 2: A view's arrays belong to whatever it wraps
+    if (lqt->owner) {
+        bytes->linear += sizeof(lqt_entry_t) * lqt->entry_count
+            + sizeof(record_ref_t) * lqt->item_count;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FREES a linear quad-tree from the heap
+ * @param[out]  lqt     The linear quad-tree to free
+*/
+void
+lqt_free(lqt_t *lqt) {
+    if (lqt->owner) {
+        free(lqt->entries);
+        free(lqt->items);
+    }
+    free(lqt);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - COUNTS the leaves & items below a node
+ * @param[in]   root        The current root of a subtree
+ * @param[in]   depth       The depth of root
+ * @param[out]  entry_count Incremented for every BLACK node
+ * @param[out]  item_count  Incremented for every item of a BLACK node
+ * @return      The depth of the DEEPEST leaf in the subtree
+*/
+int
+lqt_measure(qt_node_t *root, int depth, int *entry_count, int *item_count) {
+
+    // CASE 1: Every point of a BLACK leaf becomes an entry
+    if (root->color == BLACK) {
+        *entry_count += root->point_count;
+        for (int i = 0; i < root->point_count; i++) {
+            *item_count += root->slots[i].items->logical_size;
+        }
+        return depth;
+    }
+
+    // CASE 2: A GREY node contributes the leaves of its children
+    int deepest = depth;
+    if (root->color == GREY) {
+        for (int q = 0; q < QUADRANTS; q++) {
+            int child_depth = lqt_measure(&root->children[q], depth + 1,
+                entry_count, item_count);
+            if (child_depth > deepest) deepest = child_depth;
+        }
+    }
+    return deepest;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - APPENDS the leaves below a node as entries
+ * @param[out]  lqt     The linear quad-tree being built
+ * @param[in]   root    The current root of a subtree
+ * @param[in]   key     The Morton key of root's path
+ * @param[in]   depth   The depth of root
+*/
+void
+lqt_recursive_build(lqt_t *lqt, qt_node_t *root, uint64_t key, int depth) {
+
+    // CASE 1: A BLACK leaf - copy each point & its items into the flat 
+    //         arrays (the entries of ONE leaf share the same key & depth)
+    if (root->color == BLACK) {
+        for (int i = 0; i < root->point_count; i++) {
+            array_t *items = root->slots[i].items;
+            lqt_entry_t *entry = &lqt->entries[lqt->entry_count++];
+            entry->key = key;
+            entry->depth = depth;
+            entry->first_item = lqt->item_count;
+            entry->item_count = items->logical_size;
+            entry->point = root->slots[i].point;
+            memcpy(&lqt->items[lqt->item_count], items->data,
+                sizeof(record_ref_t) * items->logical_size);
+            lqt->item_count += items->logical_size;
+        }
+        return;
+    }
+
+    // CASE 2: A GREY node - visit the children in Z-order
+    if (root->color == GREY) {
+        int shift = 2 * (MORTON_BITS - 1 - depth);
+        for (int q = 0; q < QUADRANTS; q++) {
+            lqt_recursive_build(lqt, &root->children[q],
+                key | ((uint64_t)q << shift), depth + 1);
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - BINARY SEARCHES a run of entries sharing a path
+ *              for the 1st one in (or after) some quadrant
+ * @param[in]   lqt         The linear quad-tree
+ * @param[in]   lo          The 1st entry of the run
+ * @param[in]   hi          ONE past the last entry of the run
+ * @param[in]   depth       The depth of the node the run lies within
+ * @param[in]   quadrant    Either NW, NE, SW, SE or QUADRANTS
+ * @return      The index of the 1st entry whose quadrant is >= 'quadrant'
+*/
+int
+lqt_lower_bound(lqt_t *lqt, int lo, int hi, int depth, int quadrant) {
+
+    while (lo < hi) {
+        int mid = lo + (hi - lo)/2;
+        if (morton_quadrant(lqt->entries[mid].key, depth) < quadrant) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - RECURSIVELY finds all the points within a range
+ * @param[in]   lqt     The linear quad-tree to query
+ * @param[in]   lo      The 1st entry within the current node
+ * @param[in]   hi      ONE past the last entry within the current node
+ * @param[in]   depth   The depth of the current node
+ * @param[in]   bounds  The bounds of the current node
+ * @param[out]  path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   range   The bounded rectangle that defines a range
+ * @param[out]  visitor Where the matches are sent
+*/
+void
+lqt_recursive_range_query(lqt_t *lqt, int lo, int hi, int depth,
+    rectangle_t *bounds, path_t *path, rectangle_t *range,
+    qt_visitor_t *visitor) {
+
+    // STEP 1: Check if this node's boundary intersects with query range
+    if (! rectangle_intersect(bounds, range)) {
+        return;
+    }
+    STATS_COUNT(nodes_visited, 1);
+
+    // STEP 2: A run ending at this depth is a BLACK leaf
+    if (lqt->entries[lo].depth == depth) {
+        array_t view;
+        for (int i = lo; i < hi; i++) {
+            if (rectangle_contains(*range, lqt->entries[i].point)) {
+                qt_collect_items(visitor,
+                    lqt_entry_items(lqt, &lqt->entries[i], &view));
+            }
+        }
+        return;
+    }
+
+    // STEP 3: Otherwise traverse to the NON-EMPTY quadrants in the same order
+    //         as the pointer-based quad-tree
+    int order[QUADRANTS] = {SW, NW, NE, SE};
+    for (int i = 0; i < QUADRANTS; i++) {
+        int child_flag = order[i];
+        int child_lo = lqt_lower_bound(lqt, lo, hi, depth, child_flag);
+        int child_hi = lqt_lower_bound(lqt, child_lo, hi, depth,
+            child_flag + 1);
+        if (child_lo == child_hi) continue;
+
+        rectangle_t child_bounds = qt_child_bounds(bounds, child_flag);
+        if (rectangle_intersect(&child_bounds, range)) {
+            qt_path_append(path, child_flag);
+            lqt_recursive_range_query(lqt, child_lo, child_hi, depth + 1,
+                &child_bounds, path, range, visitor);
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - RECURSIVELY finds all the points within a circle
+ * @param[in]   lqt     The linear quad-tree to query
+ * @param[in]   lo      The 1st entry within the current node
+ * @param[in]   hi      ONE past the last entry within the current node
+ * @param[in]   depth   The depth of the current node
+ * @param[in]   bounds  The bounds of the current node
+ * @param[out]  path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   circle  The circle that defines the range
+ * @param[out]  visitor Where the matches are sent
+*/
+void
+lqt_recursive_radius_query(lqt_t *lqt, int lo, int hi, int depth,
+    rectangle_t *bounds, path_t *path, circle_t *circle, 
+    qt_visitor_t *visitor) {
+
+    // STEP 1: Check if this node's boundary intersects with the circle
+    if (! circle_intersect(circle, bounds)) {
+        return;
+    }
+    STATS_COUNT(nodes_visited, 1);
+
+    // STEP 2: A run ending at this depth is a BLACK leaf
+    if (lqt->entries[lo].depth == depth) {
+        array_t view;
+        for (int i = lo; i < hi; i++) {
+            if (circle_contains(circle, lqt->entries[i].point)) {
+                qt_collect_items(visitor,
+                    lqt_entry_items(lqt, &lqt->entries[i], &view));
+            }
+        }
+        return;
+    }
+
+    // STEP 3: Otherwise traverse to the NON-EMPTY quadrants the circle
+    //         reaches, in the same order as the pointer-based quad-tree
+    int order[QUADRANTS] = {SW, NW, NE, SE};
+    for (int i = 0; i < QUADRANTS; i++) {
+        int child_flag = order[i];
+        int child_lo = lqt_lower_bound(lqt, lo, hi, depth, child_flag);
+        int child_hi = lqt_lower_bound(lqt, child_lo, hi, depth,
+            child_flag + 1);
+        if (child_lo == child_hi) continue;
+
+        rectangle_t child_bounds = qt_child_bounds(bounds, child_flag);
+        if (circle_intersect(circle, &child_bounds)) {
+            qt_path_append(path, child_flag);
+            lqt_recursive_radius_query(lqt, child_lo, child_hi, depth + 1,
+                &child_bounds, path, circle, visitor);
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - EXPANDS a run popped by a k-nearest-neighbour 
+ *              search, queueing it's points (if it is a leaf) or it's 
+ *              non-EMPTY quadrants, in the same order as the pointer-based 
+ *              quad-tree
+ * @param[in]   lqt     The linear quad-tree
+ * @param[out]  queue   The search's priority queue
+ * @param[in]   knn     The search
+ * @param[in]   entry   The popped run
+*/
+void
+lqt_knn_expand(lqt_t *lqt, pq_t *queue, qt_knn_t *knn,
+    lqt_knn_entry_t *entry) {
+
+    // CASE 1: A run ending at this depth is a BLACK leaf
+    STATS_COUNT(nodes_visited, 1);
+    if (lqt->entries[entry->lo].depth == entry->depth) {
+        for (int i = entry->lo; i < entry->hi; i++) {
+            lqt_knn_entry_t point = {i, i + 1, -1, entry->bounds};
+            pq_push(queue, point_2d_distance(knn->point, 
+                lqt->entries[i].point, knn->metric), &point);
+        }
+        return;
+    }
+
+    // CASE 2: Otherwise queue each quadrant by the distance to it's bounds
+    for (int q = 0; q < QUADRANTS; q++) {
+        int child_lo = lqt_lower_bound(lqt, entry->lo, entry->hi, 
+            entry->depth, q);
+        int child_hi = lqt_lower_bound(lqt, child_lo, entry->hi, 
+            entry->depth, q + 1);
+        if (child_lo == child_hi) continue;
+
+        lqt_knn_entry_t child = {child_lo, child_hi, entry->depth + 1,
+            qt_child_bounds(&entry->bounds, q)};
+        pq_push(queue, rectangle_distance(&child.bounds, knn->point, 
+            knn->metric), &child);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - ALLOCATES a linear quad-tree with NO entries
+ * @param[in]   bounds  The boundary of the root
+ * @param[in]   owner   Whether the entries & items are freed with the tree
+ * @return      A POINTER to a heap-allocated linear quad-tree
+*/
+lqt_t*
+lqt_init(rectangle_t *bounds, int owner) {
+
+    lqt_t *new_lqt = (lqt_t *)malloc(sizeof(lqt_t));
+    assert(new_lqt != NULL);
+    new_lqt->bounds = *bounds;
+    new_lqt->entries = NULL;
+    new_lqt->entry_count = 0;
+    new_lqt->items = NULL;
+    new_lqt->item_count = 0;
+    new_lqt->owner = owner;
+    new_lqt->found.data = NULL;
+    new_lqt->found.logical_size = new_lqt->found.physical_size = 0;
+    return new_lqt;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - VIEWS the items of an entry as an array
+ * @param[in]   lqt     The linear quad-tree
+ * @param[in]   entry   The entry whose items are needed
+ * @param[out]  view    The array_t to point at the items (it does NOT own
+ *                      them, so must never be freed)
+ * @return      view
+*/
+array_t*
+lqt_entry_items(lqt_t *lqt, lqt_entry_t *entry, array_t *view) {
+    view->data = &lqt->items[entry->first_item];
+    view->logical_size = entry->item_count;
+    view->physical_size = entry->item_count;
+    return view;
+}
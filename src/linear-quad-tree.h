@@ -0,0 +1,170 @@
+/**
+ * @file    linear-quad-tree.h
+ * @brief   A HEADER file for the implementation of a LINEAR quad-tree
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          Only the BLACK leaves are kept, as a flat array SORTED by the
+ *          Morton key of their path from the root. Internal (GREY) & empty
+ *          (WHITE) nodes are implied by which key prefixes are present, &
+ *          their bounds are recomputed whilst descending
+ *
+ *          Entries & items hold NO pointers (items are record references),
+ *          so the arrays may equally live in a snapshot mapping
+*/
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#ifndef _LINEAR_QUAD_TREE_H_
+#define _LINEAR_QUAD_TREE_H_
+
+#define LQT_MAX_DEPTH MORTON_BITS   // Deepest leaf a Morton key can describe
+
+/* -------------------------------------------------------------------------- */
+
+// RELEVANT HEADER FILES:
+#include <stdint.h>
+
+#include "quad-tree.h"
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   A point of a BLACK leaf of a linear quad-tree (a leaf holding
+ *          several points has one entry per point, sharing the key & depth)
+ * @param   key     The leaf's path as 2-bit quadrants (from the MOST
+ *                  significant end), padded with NW (i.e. 0) bits
+ * @param   depth   The number of quadrants in the leaf's path
+ * @param   first_item  The index of the point's 1st item in the flat array
+ * @param   item_count  The number of items stored at the point
+ * @param   point   The point stored at the leaf
+*/
+typedef struct lqt_entry lqt_entry_t;
+struct lqt_entry {
+    uint64_t        key;
+    int             depth;
+    int             first_item;
+    int             item_count;
+    point_2d_t      point;
+};
+
+/**
+ * @brief   ONE entry of the priority queue of a k-nearest-neighbour search
+ * @param   lo      The 1st entry within the node
+ * @param   hi      ONE past the last entry within the node
+ * @param   depth   The depth of the node, & -1 for the point of entry lo
+ * @param   bounds  The bounds of the node
+*/
+typedef struct lqt_knn_entry lqt_knn_entry_t;
+struct lqt_knn_entry {
+    int             lo;
+    int             hi;
+    int             depth;
+    rectangle_t     bounds;
+};
+
+/**
+ * @brief   A LINEAR quad-tree
+ * @param   bounds      The boundary of the root
+ * @param   entries     The points of the leaves, SORTED by key
+ * @param   entry_count The number of entries
+ * @param   items       The DATA of every leaf, stored back-to-back
+ * @param   item_count  The number of items
+ * @param   owner       Whether entries & items are freed with the tree
+ * @param   found       A VIEW of the items of the LAST point qt_search() 
+ *                      found
+*/
+struct lqt {
+    rectangle_t     bounds;
+    lqt_entry_t     *entries;
+    int             entry_count;
+    record_ref_t    *items;
+    int             item_count;
+    int             owner;
+    array_t         found;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// LINEAR QUAD-TREE OPERATIONS:
+
+/**
+ * @brief       BUILDS a linear quad-tree from the nodes of a quad-tree
+ * @param[in]   root    The root node of the quad-tree to flatten
+ * @param[in]   bounds  The boundary of the root
+ * @return      A POINTER to a heap-allocated linear quad-tree, & NULL if a
+ *              leaf is deeper than LQT_MAX_DEPTH
+*/
+lqt_t* lqt_build(qt_node_t *root, rectangle_t *bounds);
+
+/**
+ * @brief       WRAPS arrays built elsewhere (e.g. a snapshot) as a linear 
+ *              quad-tree, WITHOUT copying them
+ * @param[in]   bounds      The boundary of the root
+ * @param[in]   entries     The points of the leaves, SORTED by key
+ * @param[in]   entry_count The number of entries
+ * @param[in]   items       The DATA of every leaf, stored back-to-back
+ * @param[in]   item_count  The number of items
+ * @return      A POINTER to a heap-allocated linear quad-tree (the arrays are
+ *              NOT freed by lqt_free())
+*/
+lqt_t* lqt_view(rectangle_t *bounds, lqt_entry_t *entries, int entry_count,
+    record_ref_t *items, int item_count);
+
+/**
+ * @brief       SEARCHES a linear quad-tree for a xy-point
+ * @param[in]   lqt     The linear quad-tree to be queried
+ * @param[in]   point   The point to find
+ * @param[out]  path    The path of the point (& NULL to skip tracking it)
+ * @param[out]  found   Filled with a VIEW of the items stored at the point
+ *                      (so searches with DIFFERENT views may run at once)
+ * @return      found, & NULL if the point is NOT stored
+*/
+array_t* lqt_search(lqt_t *lqt, point_2d_t *point, path_t *path,
+    array_t *found);
+
+/**
+ * @brief       FINDS all the points of a linear quad-tree within a RANGE
+ * @param[in]   lqt     The linear quad-tree to query
+ * @param[out]  path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   range   The bounded rectangle that defines a range
+ * @param[out]  visitor Where the matches are sent
+*/
+void lqt_range_query(lqt_t *lqt, path_t *path, rectangle_t *range,
+    qt_visitor_t *visitor);
+
+/**
+ * @brief       FINDS all the points of a linear quad-tree within a CIRCLE
+ * @param[in]   lqt     The linear quad-tree to query
+ * @param[out]  path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   circle  The circle that defines the range
+ * @param[out]  visitor Where the matches are sent
+*/
+void lqt_radius_query(lqt_t *lqt, path_t *path, circle_t *circle,
+    qt_visitor_t *visitor);
+
+/**
+ * @brief       FINDS the records of a linear quad-tree NEAREST to a point
+ * @param[in]   lqt     The linear quad-tree to query
+ * @param[out]  knn     The search (see qt_knn())
+*/
+void lqt_knn(lqt_t *lqt, qt_knn_t *knn);
+
+/**
+ * @brief       MEASURES the shape of a linear quad-tree (i.e. it's leaves, as
+ *              it keeps NO other nodes) & the bytes it holds
+ * @param[in]   lqt     The linear quad-tree
+ * @param[out]  shape   A ZEROED shape, filled in
+ * @param[out]  bytes   Has the bytes held added to it
+*/
+void lqt_stats(lqt_t *lqt, stats_shape_t *shape, stats_bytes_t *bytes);
+
+/**
+ * @brief       FREES a linear quad-tree from the heap
+ * @param[out]  lqt     The linear quad-tree to free
+*/
+void lqt_free(lqt_t *lqt);
+
+#endif
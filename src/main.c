@@ -13,11 +13,18 @@
 #include <string.h>
 
 #include "cmp.h"
+#include "csv.h"
 #include "data.h"
 #include "coordinates.h"
 #include "dynamic-array.h"
 #include "quad-tree.h"
-#include "sll.h"
+#include "record-store.h"
+#include "format.h"
+#include "snapshot.h"
+#include "query-engine.h"
+#include "stats.h"
+#include "latency.h"
+#include "range-cache.h"
 
 /* -------------------------------------------------------------------------- */
 
@@ -25,6 +32,8 @@
 #define MIN_ARGS 7
 #define MODE_1 1
 #define MODE_2 2
+#define MODE_3 3
+#define MODE_4 4
 
 #define MODE_ARG 1
 #define CSV_ARG 2
@@ -34,72 +43,244 @@
 #define X_TOP_RIGHT_ARG 6
 #define Y_TOP_RIGHT_ARG 7
 
+#define FIRST_FLAG_ARG 8
+
+#define FLAG_LINEAR "--linear"      // Answer queries with the LINEAR backend
+#define FLAG_LEAF_CAPACITY "--leaf-capacity"    // DISTINCT points per leaf
+#define FLAG_MAX_DEPTH "--max-depth"            // Depth leaves stop splitting
+#define FLAG_THREADS "--threads"    // Threads parsing the CSV & answering queries
+#define FLAG_SNAPSHOT "--snapshot"              // Query a FRESH snapshot
+#define FLAG_SAVE_SNAPSHOT "--save-snapshot"    // Save the built quad-tree
+#define FLAG_STREAM "--stream"      // Print range matches as they are found
+#define FLAG_BATCH "--batch"        // Answer queries in Morton-ordered blocks
+#define FLAG_HAVERSINE "--haversine"    // Nearest records by great-circle
+#define FLAG_STATS "--stats"        // Write runtime statistics as JSON
+#define FLAG_LATENCY "--latency"    // Write per-query latencies as JSON
+#define FLAG_RANGE_CACHE "--range-cache"    // Bytes of cached range results
+#define FLAG_UPDATES "--updates"    // Remove or move rows before the queries
+
+#define UPDATE_REMOVE "remove"      // remove footpath_id
+#define UPDATE_MOVE "move"          // move footpath_id start_lon start_lat 
+                                    //      end_lon end_lat
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   The OPTIONAL flags that follow the positional arguments
+ * @param   linear          Whether queries use the LINEAR quad-tree backend
+ * @param   leaf_capacity   The DISTINCT points a leaf holds before splitting
+ * @param   max_depth       The depth at which leaves stop splitting
+ * @param   threads         The number of threads that parse the CSV (& answer
+ *                          the queries, in blocks, if MORE than 1)
+ * @param   snapshot        The snapshot to answer queries from (unless it is
+ *                          missing or STALE), & NULL otherwise
+ * @param   save_snapshot   Where to save the built quad-tree, & NULL otherwise
+ * @param   stream          Whether range matches are printed as they are
+ *                          found (rather than sorted by footpath_id)
+ * @param   batch           The number of queries in each chunk a worker
+ *                          answers (in Morton order), & 0 to answer them one
+ *                          at a time (unless there are several threads)
+ * @param   metric          How nearest-neighbour queries measure distance
+ *                          (either DISTANCE_PLANAR or DISTANCE_HAVERSINE)
+ * @param   stats           Where runtime statistics are written (as JSON) on
+ *                          exit, & NULL to NOT gather them
+ * @param   latency         Where the latency percentiles of each stage of a
+ *                          query are written (as JSON) on exit, & NULL to
+ *                          NOT time queries
+ * @param   range_cache     The MOST bytes of range results cached (so that
+ *                          REPEATED ranges skip the quad-tree), & 0 to cache
+ *                          nothing
+ * @param   updates         The rows to remove or move (ONE per line) once the
+ *                          quad-tree is built, & NULL to change nothing
+*/
+typedef struct options options_t;
+struct options {
+    int             linear;
+    int             leaf_capacity;
+    int             max_depth;
+    int             threads;
+    const char      *snapshot;
+    const char      *save_snapshot;
+    int             stream;
+    int             batch;
+    int             metric;
+    const char      *stats;
+    const char      *latency;
+    size_t          range_cache;
+    const char      *updates;
+};
+
+/**
+ * @brief   Where a STREAMED range query prints it's matches
+ * @param   output_file The file to print the matches to
+ * @param   buffer      Where the matches are rendered before being printed
+ * @param   store       The records the quad-tree's items refer to
+ * @param   query       The query line (printed before the 1st match)
+ * @param   count       The number of matches printed so far
+*/
+typedef struct stream stream_t;
+struct stream {
+    FILE            *output_file;
+    format_buffer_t *buffer;
+    record_store_t  *store;
+    const char      *query;
+    int             count;
+};
+
 /* -------------------------------------------------------------------------- */
 
 // FUNCTION PROTOTYPES:
-void process_args(int argc, char **argv);
+void process_args(int argc, char **argv, options_t *options);
+record_store_t* build_tree(csv_file_t *csv, qt_tree_t *tree, 
+    options_t *options, snapshot_key_t *key);
 long double custom_strtold(const char *str);
-void point_query(FILE *output_file, qt_tree_t *tree);
-void range_query(FILE *output_file, qt_tree_t *tree);
+void apply_updates(const char *filename, qt_tree_t *tree, 
+    record_store_t *store);
+int find_record(record_store_t *store, int footpath_id);
+void point_query(FILE *output_file, qt_tree_t *tree, record_store_t *store,
+    latency_t *latency);
+void range_query(FILE *output_file, qt_tree_t *tree, record_store_t *store,
+    int stream, range_cache_t *cache, latency_t *latency);
+void stream_match(record_ref_t item, void *context);
+void knn_query(FILE *output_file, qt_tree_t *tree, record_store_t *store,
+    int metric, latency_t *latency);
+void radius_query(FILE *output_file, qt_tree_t *tree, record_store_t *store,
+    latency_t *latency);
+void print_matches(FILE *output_file, format_buffer_t *buffer, 
+    record_store_t *store, const char *query, array_t *matches);
+void write_stats(const char *filename, qt_tree_t *tree, 
+    record_store_t *store, range_cache_t *cache);
+void write_latency(const char *filename, latency_t *latency);
 
 /* -------------------------------------------------------------------------- */
 
 int main(int argc, char **argv) {
 
     // STEP 1: Check the validity of the program arguments
-    process_args(argc, argv);
+    options_t options;
+    process_args(argc, argv, &options);
+    if (options.stats != NULL) {
+        stats_enable();
+    }
+    latency_t *latency = (options.latency != NULL) ? latency_init() : NULL;
+    range_cache_t *cache = NULL;
 
     // STEP 2: Record the input arguments into variables
     int stage_number = atoi(argv[MODE_ARG]);
-    FILE *input_file = fopen(argv[CSV_ARG], "r");
+    csv_file_t *input_csv = csv_open(argv[CSV_ARG]);
     FILE *output_file = fopen(argv[OUTPUT_ARG], "w");
-    assert((input_file != NULL) && (output_file != NULL));
-
-    // STEP 3: Intialise the quad-tree (SEARCH coordinates)
-    point_2d_t root_bounds_bl = 
-        point_2d_init(custom_strtold(argv[X_BOTTOM_LEFT_ARG]), 
-        custom_strtold(argv[Y_BOTTOM_LEFT_ARG]));
-    point_2d_t root_bounds_tr = 
-        point_2d_init(custom_strtold(argv[X_TOP_RIGHT_ARG]), 
-        custom_strtold(argv[Y_TOP_RIGHT_ARG]));
+    assert((input_csv != NULL) && (output_file != NULL));
+
+    // STEP 3: Intialise the quad-tree (SEARCH coordinates), which also fixes
+    //         the frame coordinates are quantised against
+    long double root_bl_x = custom_strtold(argv[X_BOTTOM_LEFT_ARG]);
+    long double root_bl_y = custom_strtold(argv[Y_BOTTOM_LEFT_ARG]);
+    long double root_tr_x = custom_strtold(argv[X_TOP_RIGHT_ARG]);
+    long double root_tr_y = custom_strtold(argv[Y_TOP_RIGHT_ARG]);
+    coord_frame_init(root_bl_x, root_bl_y, root_tr_x, root_tr_y);
+    point_2d_t root_bounds_bl = point_2d_quantise(root_bl_x, root_bl_y);
+    point_2d_t root_bounds_tr = point_2d_quantise(root_tr_x, root_tr_y);
     rectangle_t root_bounds = rectangle_init(root_bounds_bl, root_bounds_tr);
-    qt_tree_t *qtree = qt_tree_init(root_bounds);
-
-    // STEP 4: Initialise the linked-list (STORE data entries)
-    sll_t *list = sll_init();
-
-    // STEP 5: Skip the header & read the data into the quad-tree
-    data_t *tmp_data = NULL;
-    point_2d_t *tmp_point = NULL;
-
-    file_skip_line(input_file);
-    while ((tmp_data = read_line_data(input_file, tmp_data)) != NULL) {
 
-        // STEP 5A: Read & insert the start_lon & start_lat
-        tmp_point = point_2d_malloc(tmp_data->start_lon, tmp_data->start_lat);
-        qt_insert(qtree, tmp_point, tmp_data);
-        tmp_point = NULL;
+    // STEP 4: Answer queries from the snapshot if it is still FRESH (i.e. 
+    //         built from the same CSV, root & tree parameters)
+    snapshot_key_t key;
+    memset(&key, 0, sizeof(snapshot_key_t));
+    if ((options.snapshot != NULL) || (options.save_snapshot != NULL)) {
+        key = snapshot_key_init(input_csv, root_bl_x, root_bl_y, root_tr_x,
+            root_tr_y, options.leaf_capacity, options.max_depth);
+    }
+    snapshot_t *snapshot = NULL;
+    if ((options.snapshot != NULL) 
+        && ((snapshot = snapshot_open(options.snapshot, &key)) == NULL)) {
+        fprintf(stderr, "WARNING: snapshot %s is missing or stale, reading "
+            "%s\n", options.snapshot, argv[CSV_ARG]);
+    }
 
-        // STEP 5B: Read & insert end_lon & end_lat
-        tmp_point = point_2d_malloc(tmp_data->end_lon, tmp_data->end_lat);
-        qt_insert(qtree, tmp_point, tmp_data);
-        tmp_point = NULL;
+    // STEP 5: Otherwise build the quad-tree (& the record store) from the 
+    //         CSV, which is no longer needed afterwards
+    qt_tree_t *qtree = (snapshot != NULL) ? snapshot->tree : NULL;
+    record_store_t *store = (snapshot != NULL) ? snapshot->store : NULL;
+    if (qtree == NULL) {
+        qtree = qt_tree_init(root_bounds, options.leaf_capacity, 
+            options.max_depth);
+        store = build_tree(input_csv, qtree, &options, &key);
+    }
+    csv_close(input_csv);
+
+    // STEP 5A: Remove or move rows if requested (the nodes of a snapshot are
+    //          NOT updated, & nor are those linearised to SAVE one, as the
+    //          snapshot describes the CSV it is keyed on)
+    if ((options.updates != NULL) && (snapshot != NULL)) {
+        fprintf(stderr, "WARNING: %s ignored whilst querying a snapshot\n",
+            FLAG_UPDATES);
+    } else if ((options.updates != NULL) && (qtree->linear != NULL)) {
+        fprintf(stderr, "WARNING: %s ignored whilst saving a snapshot\n",
+            FLAG_UPDATES);
+    } else if (options.updates != NULL) {
+        apply_updates(options.updates, qtree, store);
+    }
 
-        // STEP 5C: Store the data into the linked-list
-        sll_insert_tail(list, tmp_data);
+    // STEP 5B: Swap the nodes for the LINEAR backend if requested
+    if (options.linear && (qtree->linear == NULL) && (! qt_linearise(qtree))) {
+        fprintf(stderr, "WARNING: quad-tree too deep for %s, using nodes\n",
+            FLAG_LINEAR);
     }
 
     // STEP 6: Perform the stage-specifc tasks of STAGE 3 or 4
-    if (stage_number == MODE_1) {
-        point_query(output_file, qtree);
+    //         (answering blocks of queries on the query engine if requested,
+    //         whose queries are NOT timed one at a time)
+    if (stage_number == MODE_3) {
+        knn_query(output_file, qtree, store, options.metric, latency);
+    } else if (stage_number == MODE_4) {
+        radius_query(output_file, qtree, store, latency);
+    } else if ((options.batch > 0) || (options.threads > 1)) {
+        if (latency != NULL) {
+            fprintf(stderr, "WARNING: %s ignored whilst answering queries in "
+                "blocks\n", FLAG_LATENCY);
+        }
+        if (options.range_cache > 0) {
+            fprintf(stderr, "WARNING: %s ignored whilst answering queries in "
+                "blocks\n", FLAG_RANGE_CACHE);
+        }
+        query_engine_run(output_file, qtree, store, 
+            (stage_number == MODE_1) ? QUERY_POINT : QUERY_RANGE,
+            (options.batch > 0) ? options.batch : QUERY_DEFAULT_BATCH,
+            options.threads);
+    } else if (stage_number == MODE_1) {
+        point_query(output_file, qtree, store, latency);
     } else if (stage_number == MODE_2) {
-        range_query(output_file, qtree);
+        if ((options.range_cache > 0) && options.stream) {
+            fprintf(stderr, "WARNING: %s ignored whilst streaming matches\n",
+                FLAG_RANGE_CACHE);
+        } else if (options.range_cache > 0) {
+            cache = range_cache_init(options.range_cache);
+        }
+        range_query(output_file, qtree, store, options.stream, cache, 
+            latency);
     }
     
-    // STEP 7: Free the heap of previous memory allocations, & close files
-    sll_free(list);
-    qt_free(qtree);
-    fclose(input_file);
+    // STEP 7: Write the statistics & latencies gathered (if requested)
+    if (options.stats != NULL) {
+        write_stats(options.stats, qtree, store, cache);
+    }
+    if (latency != NULL) {
+        write_latency(options.latency, latency);
+        latency_free(latency);
+    }
+    if (cache != NULL) {
+        range_cache_free(cache);
+    }
+
+    // STEP 8: Free the heap of previous memory allocations, & close files
+    if (snapshot != NULL) {
+        snapshot_close(snapshot);
+    } else {
+        qt_free(qtree);
+        record_store_free(store);
+    }
     fclose(output_file);
     return 0;
 }
@@ -110,24 +291,226 @@ int main(int argc, char **argv) {
  * @brief       Checks if the arguments are correct before program execution
  * @param[out]  argc    The number of arguments
  * @param[in]   argv    An 2D array of characters for storing argument names
+ * @param[out]  options The OPTIONAL flags supplied after the positional ones
 */
 void 
-process_args(int argc, char **argv) {
+process_args(int argc, char **argv, options_t *options) {
     
     // CASE 1: Insufficient number of arguments
-    if ((argc < MIN_ARGS) || (argc > MIN_ARGS + 1)) {
+    if (argc < MIN_ARGS + 1) {
         fprintf(stderr, "ERROR: Invalid number of arguments\n");
-        fprintf(stderr, "Only %d were supplied. %d OR %d arguments required\n", 
-            argc, MIN_ARGS, MIN_ARGS + 1);
+        fprintf(stderr, "Only %d were supplied. At least %d arguments required\n", 
+            argc, MIN_ARGS + 1);
         exit(EXIT_FAILURE);
     }
-    // CASE 2: Stage arguments must be either '3' or '4'
+    // CASE 2: Mode arguments must be either '1', '2', '3' or '4'
     if ((atoi(argv[MODE_ARG]) < MODE_1) || 
-        (atoi(argv[MODE_ARG]) > MODE_2)) {
-        fprintf(stderr, "ERROR: 1st argument, %s, must equal either 3 or 4\n", 
+        (atoi(argv[MODE_ARG]) > MODE_4)) {
+        fprintf(stderr, "ERROR: 1st argument, %s, must equal 1, 2, 3 or 4\n", 
             argv[MODE_ARG]);
         exit(EXIT_FAILURE);
     }
+
+    // CASE 3: Any remaining arguments must be RECOGNISED flags
+    options->linear = 0;
+    options->leaf_capacity = QT_DEFAULT_LEAF_CAPACITY;
+    options->max_depth = QT_UNLIMITED_DEPTH;
+    options->threads = 1;
+    options->snapshot = NULL;
+    options->save_snapshot = NULL;
+    options->stream = 0;
+    options->batch = 0;
+    options->metric = DISTANCE_PLANAR;
+    options->stats = NULL;
+    options->latency = NULL;
+    options->range_cache = 0;
+    options->updates = NULL;
+    for (int i = FIRST_FLAG_ARG; i < argc; i++) {
+        if (strcmp(argv[i], FLAG_LINEAR) == 0) {
+            options->linear = 1;
+        } else if ((strcmp(argv[i], FLAG_LEAF_CAPACITY) == 0) 
+            && (i + 1 < argc) && (atoi(argv[i + 1]) >= 1)) {
+            options->leaf_capacity = atoi(argv[++i]);
+        } else if ((strcmp(argv[i], FLAG_MAX_DEPTH) == 0) 
+            && (i + 1 < argc) && (atoi(argv[i + 1]) >= 0)
+            && (atoi(argv[i + 1]) <= QT_MAX_DEPTH)) {
+            options->max_depth = atoi(argv[++i]);
+        } else if ((strcmp(argv[i], FLAG_THREADS) == 0) 
+            && (i + 1 < argc) && (atoi(argv[i + 1]) >= 1)) {
+            options->threads = atoi(argv[++i]);
+        } else if ((strcmp(argv[i], FLAG_SNAPSHOT) == 0) && (i + 1 < argc)) {
+            options->snapshot = argv[++i];
+        } else if ((strcmp(argv[i], FLAG_SAVE_SNAPSHOT) == 0) 
+            && (i + 1 < argc)) {
+            options->save_snapshot = argv[++i];
+        } else if (strcmp(argv[i], FLAG_STREAM) == 0) {
+            options->stream = 1;
+        } else if ((strcmp(argv[i], FLAG_BATCH) == 0) 
+            && (i + 1 < argc) && (atoi(argv[i + 1]) >= 1)) {
+            options->batch = atoi(argv[++i]);
+        } else if (strcmp(argv[i], FLAG_HAVERSINE) == 0) {
+            options->metric = DISTANCE_HAVERSINE;
+        } else if ((strcmp(argv[i], FLAG_STATS) == 0) && (i + 1 < argc)) {
+            options->stats = argv[++i];
+        } else if ((strcmp(argv[i], FLAG_LATENCY) == 0) && (i + 1 < argc)) {
+            options->latency = argv[++i];
+        } else if ((strcmp(argv[i], FLAG_RANGE_CACHE) == 0) 
+            && (i + 1 < argc) && (atol(argv[i + 1]) >= 1)) {
+            options->range_cache = (size_t)atol(argv[++i]);
+        } else if ((strcmp(argv[i], FLAG_UPDATES) == 0) && (i + 1 < argc)) {
+            options->updates = argv[++i];
+        } else {
+            fprintf(stderr, "ERROR: Unrecognised flag %s\n", argv[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       BUILDS the quad-tree from the rows of the CSV
+ * @param[in]   csv     The mapped CSV (positioned AFTER the header row)
+ * @param[out]  tree    The EMPTY quad-tree to build
+ * @param[in]   options The OPTIONAL flags supplied after the positional ones
+ * @param[in]   key     What a saved snapshot is built from
+ * @return      A POINTER to a heap-allocated record store that OWNS the data
+ *              (& whose records the quad-tree's items refer to)
+*/
+record_store_t*
+build_tree(csv_file_t *csv, qt_tree_t *tree, options_t *options, 
+    snapshot_key_t *key) {
+
+    // STEP 1: Read the data from the mapped CSV (in file order)
+    int row_count = 0;
+    data_t **rows = csv_read_rows(csv, options->threads, &row_count);
+
+    // STEP 2: Every row has TWO endpoints
+    int point_count = 0;
+    record_store_t *store = record_store_init(row_count);
+    point_2d_t *points = 
+        (point_2d_t *)malloc(sizeof(point_2d_t) * (2 * row_count + 1));
+    record_ref_t *point_data = 
+        (record_ref_t *)malloc(sizeof(record_ref_t) * (2 * row_count + 1));
+    assert((points != NULL) && (point_data != NULL));
+
+    for (int i = 0; i < row_count; i++) {
+        data_t *tmp_data = rows[i];
+
+        // STEP 2A: Move the row into the record store
+        record_ref_t ref = record_store_append(store, csv->base, tmp_data);
+
+        // STEP 2B: Record the start_lon & start_lat
+        points[point_count] = 
+            point_2d_quantise(tmp_data->start_lon, tmp_data->start_lat);
+        point_data[point_count++] = ref;
+
+        // STEP 2C: Record the end_lon & end_lat
+        points[point_count] = 
+            point_2d_quantise(tmp_data->end_lon, tmp_data->end_lat);
+        point_data[point_count++] = ref;
+        free_data(tmp_data);
+    }
+
+    // STEP 3: Build the quad-tree from ALL the endpoints in ONE pass
+    qt_bulk_load(tree, points, point_data, point_count);
+
+    // STEP 4: Save it (as a snapshot) if requested
+    if ((options->save_snapshot != NULL) && (! snapshot_save(
+        options->save_snapshot, key, tree, store))) {
+        fprintf(stderr, "WARNING: could not save snapshot %s\n", 
+            options->save_snapshot);
+    }
+    free(rows);
+    free(points);
+    free(point_data);
+    return store;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       REMOVES or MOVES rows of a built quad-tree, as listed in a file
+ *              where each line is either:
+ *              - "remove footpath_id" (dropping BOTH of the row's endpoints)
+ *              - "move footpath_id start_lon start_lat end_lon end_lat"
+ * @param[in]   filename    The file of updates
+ * @param[out]  tree        The (pointer-based) quad-tree to update
+ * @param[out]  store       The records (a moved row's coordinates change)
+*/
+void 
+apply_updates(const char *filename, qt_tree_t *tree, record_store_t *store) {
+
+    // STEP 1: Open the file of updates
+    FILE *updates = fopen(filename, "r");
+    if (updates == NULL) {
+        fprintf(stderr, "WARNING: could not open %s\n", filename);
+        return;
+    }
+
+    // STEP 2: Apply each update in turn
+    char read[MAX_STR_LEN + 1], kind[MAX_STR_LEN + 1];
+    int footpath_id;
+    long double start_lon, start_lat, end_lon, end_lat;
+    while (fscanf(updates, "%[^\n]\n", read) == 1) {
+        int fields = sscanf(read, "%s %d %Lf %Lf %Lf %Lf", kind, &footpath_id,
+            &start_lon, &start_lat, &end_lon, &end_lat);
+        int record = (fields >= 2) ? find_record(store, footpath_id) : -1;
+        if (record < 0) {
+            fprintf(stderr, "WARNING: skipping update '%s'\n", read);
+            continue;
+        }
+        record_ref_t ref = {footpath_id, record};
+        point_2d_t start = point_2d_quantise(store->start_lon[record], 
+            store->start_lat[record]);
+        point_2d_t end = point_2d_quantise(store->end_lon[record], 
+            store->end_lat[record]);
+
+        // CASE 2A: Drop BOTH endpoints of the row
+        if ((fields == 2) && (strcmp(kind, UPDATE_REMOVE) == 0)) {
+            if (! (qt_remove(tree, &start, footpath_id) 
+                && qt_remove(tree, &end, footpath_id))) {
+                fprintf(stderr, "WARNING: row %d is NOT in the quad-tree\n",
+                    footpath_id);
+            }
+
+        // CASE 2B: Move BOTH endpoints of the row (& it's record with them)
+        } else if ((fields == 6) && (strcmp(kind, UPDATE_MOVE) == 0)) {
+            point_2d_t new_start = point_2d_quantise(start_lon, start_lat);
+            point_2d_t new_end = point_2d_quantise(end_lon, end_lat);
+            if (! (qt_move(tree, &start, &new_start, ref) 
+                && qt_move(tree, &end, &new_end, ref))) {
+                fprintf(stderr, "WARNING: could not move row %d\n", 
+                    footpath_id);
+                continue;
+            }
+            store->start_lon[record] = start_lon;
+            store->start_lat[record] = start_lat;
+            store->end_lon[record] = end_lon;
+            store->end_lat[record] = end_lat;
+
+        // CASE 2C: Anything else is malformed
+        } else {
+            fprintf(stderr, "WARNING: skipping update '%s'\n", read);
+        }
+    }
+    fclose(updates);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FINDS the record of a row
+ * @param[in]   store       The records
+ * @param[in]   footpath_id The footpath_id of the row
+ * @return      The index of the row's record, & -1 if there is NO such row
+*/
+int 
+find_record(record_store_t *store, int footpath_id) {
+    for (int i = 0; i < store->count; i++) {
+        if (store->foothpath_id[i] == footpath_id) return i;
+    }
+    return -1;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -152,34 +535,47 @@ custom_strtold(const char *str) {
  *              quad-tree & then returns matched entries
  * @param[in]   output_file     The file to write output to
  * @param[in]   tree            Contains coordinates for quick look-up
+ * @param[in]   store           The records the quad-tree's items refer to
+ * @param[out]  latency         Times each stage of every query (& NULL to
+ *                              time nothing)
 */
 void 
-point_query(FILE *output_file, qt_tree_t *tree) {
+point_query(FILE *output_file, qt_tree_t *tree, record_store_t *store,
+    latency_t *latency) {
 
     char read[MAX_STR_LEN + 1];
+    long double x, y;
     point_2d_t query;
-    qt_node_t *search = NULL;
-    char path[MAX_PATH_LENGTH + 1] = "";
+    array_t *search = NULL;
+    path_t *path = path_init();
+    format_buffer_t *buffer = format_init();
 
     // STEP 1: Read the queries from STDIN
     while (scanf("%[^\n]\n", read) == 1) {
-        assert(sscanf(read ,"%Lf %Lf\n", &query.x, &query.y) == 2);
+        latency_start(latency);
+        assert(sscanf(read ,"%Lf %Lf\n", &x, &y) == 2);
+        query = point_2d_quantise(x, y);
+        latency_lap(latency, LATENCY_PARSE);
 
         // STEP 2: Search the quad-tree for the query
-        if ((search = qt_search(tree, &query, path)) != NULL) {
+        search = qt_search(tree, &query, path);
+        latency_lap(latency, LATENCY_TRAVERSE);
+        if (search != NULL) {
 
             // STEP 3: Print the findings to the output file
-            fprintf(output_file, "%s\n", read);
-            for (int i = 0; i < search->items->logical_size; i++) {
-                print_data_to_file(output_file, search->items->data[i]);
-            }
+            print_matches(output_file, buffer, store, read, search);
 
             // STEP 4: Print the findings to STDOUT
             printf("%s -->", read);
-            printf("%s\n", path);
-            strcpy(path, "");
+            path_print(stdout, path);
+            printf("\n");
+            path_truncate(path, 0);
         }
+        latency_lap(latency, LATENCY_FORMAT);
     }
+    format_flush(buffer, output_file);
+    format_free(buffer);
+    path_free(path);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -189,39 +585,276 @@ point_query(FILE *output_file, qt_tree_t *tree) {
  *              the points that exists within the query range
  * @param[in]   output_file     The file to print the outputs to
  * @param[in]   tree            The quad-tree to range query
+ * @param[in]   store           The records the quad-tree's items refer to
+ * @param[in]   stream          Whether matches are printed as they are found
+ *                              (in traversal order), rather than collected &
+ *                              sorted by footpath_id
+ * @param[out]  cache           Answers REPEATED ranges (& NULL to always
+ *                              query the quad-tree)
+ * @param[out]  latency         Times each stage of every query (& NULL to
+ *                              time nothing)
 */
 void 
-range_query(FILE *output_file, qt_tree_t *tree) {
+range_query(FILE *output_file, qt_tree_t *tree, record_store_t *store,
+    int stream, range_cache_t *cache, latency_t *latency) {
 
     char read[MAX_STR_LEN + 1];
     long double bl_x, bl_y, tr_x, tr_y;
     rectangle_t range;
     array_t *matches = NULL;
-    char path[MAX_PATH_LENGTH + 1] = "";
+    path_t *path = path_init();
+    format_buffer_t *buffer = format_init();
 
     // STEP 1: Read the queries from STDIN
     while (scanf("%[^\n]\n", read) == 1) {
+        latency_start(latency);
         assert(sscanf(read, "%Lf %Lf %Lf %Lf\n", 
             &bl_x, &bl_y, &tr_x, &tr_y) == 4);
         range = rectangle_init(
-            point_2d_init(bl_x, bl_y), point_2d_init(tr_x, tr_y));
+            point_2d_quantise(bl_x, bl_y), point_2d_quantise(tr_x, tr_y));
+        latency_lap(latency, LATENCY_PARSE);
+
+        // STEP 1A: Stream the matches straight to the output if requested
+        //          (so the traversal's time INCLUDES rendering the matches)
+        if (stream) {
+            stream_t context = {output_file, buffer, store, read, 0};
+            qt_range_visit(tree, path, &range, stream_match, &context, 1);
+            latency_lap(latency, LATENCY_TRAVERSE);
+            if (context.count > 0) {
+                printf("%s -->", read);
+                path_print(stdout, path);
+                printf("\n");
+                path_truncate(path, 0);
+            }
+            latency_lap(latency, LATENCY_FORMAT);
+            continue;
+        }
 
-        // STEP 2: Query the quad-tree
-        if ((matches = qt_range_query(tree, path, &range)) != NULL) {
+        // STEP 2: Query the quad-tree (or the cache, if there is one)
+        matches = (cache != NULL) ? range_cache_query(cache, tree, path, 
+            &range) : qt_range_query(tree, path, &range);
+        latency_lap(latency, LATENCY_TRAVERSE);
+        if (matches != NULL) {
 
             // STEP 3: Print the findings to the output
-            fprintf(output_file, "%s\n", read);
-            for (int i = 0; i < matches->logical_size; i++) {
-                print_data_to_file(output_file, matches->data[i]);
-            }
+            print_matches(output_file, buffer, store, read, matches);
 
             // STEP 4: Print the data to STDOUT
             printf("%s -->", read);
-            printf("%s\n", path);
-            strcpy(path, "");
+            path_print(stdout, path);
+            printf("\n");
+            path_truncate(path, 0);
 
             // STEP 5: Free array_t to make way for the next query
             array_free(matches);
         }
+        latency_lap(latency, LATENCY_FORMAT);
+    }
+    format_flush(buffer, output_file);
+    format_free(buffer);
+    path_free(path);
+}
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       Takes input coordinates & a radius (in metres) from STDIN &
+ *              prints all the points within that distance, in the same
+ *              format as range_query()
+ * @param[in]   output_file     The file to print the outputs to
+ * @param[in]   tree            The quad-tree to query
+ * @param[in]   store           The records the quad-tree's items refer to
+ * @param[out]  latency         Times each stage of every query (& NULL to
+ *                              time nothing)
+*/
+void 
+radius_query(FILE *output_file, qt_tree_t *tree, record_store_t *store,
+    latency_t *latency) {
+
+    char read[MAX_STR_LEN + 1];
+    long double x, y, radius;
+    circle_t circle;
+    array_t *matches = NULL;
+    path_t *path = path_init();
+    format_buffer_t *buffer = format_init();
+
+    // STEP 1: Read the queries from STDIN (the coordinates are longitudes &
+    //         latitudes, so distances are measured along the great circle)
+    while (scanf("%[^\n]\n", read) == 1) {
+        latency_start(latency);
+        assert(sscanf(read, "%Lf %Lf %Lf\n", &x, &y, &radius) == 3);
+        circle = circle_init(point_2d_quantise(x, y), radius, 
+            DISTANCE_HAVERSINE);
+        latency_lap(latency, LATENCY_PARSE);
+
+        // STEP 2: Query the quad-tree
+        matches = qt_radius_query(tree, path, &circle);
+        latency_lap(latency, LATENCY_TRAVERSE);
+        if (matches != NULL) {
+
+            // STEP 3: Print the findings to the output
+            print_matches(output_file, buffer, store, read, matches);
+
+            // STEP 4: Print the data to STDOUT
+            printf("%s -->", read);
+            path_print(stdout, path);
+            printf("\n");
+            path_truncate(path, 0);
+            array_free(matches);
+        }
+        latency_lap(latency, LATENCY_FORMAT);
+    }
+    format_flush(buffer, output_file);
+    format_free(buffer);
+    path_free(path);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       PRINTS ONE match of a streamed range query (preceded by the
+ *              query itself if it is the 1st match)
+ * @param[in]   item        The reference to the matched record
+ * @param[out]  context     The stream_t of the query
+*/
+void 
+stream_match(record_ref_t item, void *context) {
+    stream_t *stream = (stream_t *)context;
+    if (stream->count++ == 0) {
+        format_text(stream->buffer, stream->query, strlen(stream->query));
+        format_literal(stream->buffer, "\n");
+    }
+    record_store_format(stream->buffer, stream->store, item.record);
+    format_spill(stream->buffer, stream->output_file);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       Takes input coordinates & a count k from STDIN & prints the k
+ *              records NEAREST to each coordinate
+ * @param[in]   output_file     The file to print the outputs to
+ * @param[in]   tree            The quad-tree to query
+ * @param[in]   store           The records the quad-tree's items refer to
+ * @param[in]   metric          Either DISTANCE_PLANAR or DISTANCE_HAVERSINE
+ * @param[out]  latency         Times each stage of every query (& NULL to
+ *                              time nothing)
+*/
+void 
+knn_query(FILE *output_file, qt_tree_t *tree, record_store_t *store,
+    int metric, latency_t *latency) {
+
+    char read[MAX_STR_LEN + 1];
+    long double x, y;
+    int k;
+    point_2d_t query;
+    array_t *nearest = NULL;
+    format_buffer_t *buffer = format_init();
+
+    // STEP 1: Read the queries from STDIN
+    while (scanf("%[^\n]\n", read) == 1) {
+        latency_start(latency);
+        assert((sscanf(read, "%Lf %Lf %d\n", &x, &y, &k) == 3) && (k >= 1));
+        query = point_2d_quantise(x, y);
+        long double *distances = 
+            (long double *)malloc(sizeof(long double) * k);
+        assert(distances != NULL);
+        latency_lap(latency, LATENCY_PARSE);
+
+        // STEP 2: Query the quad-tree
+        nearest = qt_knn(tree, &query, k, metric, distances);
+        latency_lap(latency, LATENCY_TRAVERSE);
+        if (nearest != NULL) {
+
+            // STEP 3: Print the findings (NEAREST first) to the output
+            print_matches(output_file, buffer, store, read, nearest);
+
+            // STEP 4: Print the distance of each finding to STDOUT
+            printf("%s -->", read);
+            for (int i = 0; i < nearest->logical_size; i++) {
+                printf(" %.6Lg", distances[i]);
+            }
+            printf("\n");
+            array_free(nearest);
+        }
+        free(distances);
+        latency_lap(latency, LATENCY_FORMAT);
+    }
+    format_flush(buffer, output_file);
+    format_free(buffer);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       PRINTS the findings of ONE query to the output file: the query
+ *              line & then every matched record (via a buffer that is only
+ *              written out in LARGE blocks)
+ * @param[in]   output_file The file to print the findings to
+ * @param[out]  buffer      Where the findings are rendered
+ * @param[in]   store       The records the quad-tree's items refer to
+ * @param[in]   query       The query line
+ * @param[in]   matches     The matched records (in the order printed)
+*/
+void 
+print_matches(FILE *output_file, format_buffer_t *buffer, 
+    record_store_t *store, const char *query, array_t *matches) {
+    format_text(buffer, query, strlen(query));
+    format_literal(buffer, "\n");
+    for (int i = 0; i < matches->logical_size; i++) {
+        record_store_format(buffer, store, matches->data[i].record);
+    }
+    format_spill(buffer, output_file);
+}
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       WRITES the statistics gathered by the queries, the shape of 
+ *              the quad-tree, the bytes each subsystem holds & the range
+ *              cache's counters (as JSON)
+ * @param[in]   filename    The file to write the statistics to
+ * @param[in]   tree        The quad-tree the queries were answered on
+ * @param[in]   store       The records the quad-tree's items refer to
+ * @param[in]   cache       The range cache (& NULL if there is none)
+*/
+void 
+write_stats(const char *filename, qt_tree_t *tree, record_store_t *store,
+    range_cache_t *cache) {
+    FILE *stats_file = fopen(filename, "w");
+    if (stats_file == NULL) {
+        fprintf(stderr, "WARNING: could not write statistics to %s\n", 
+            filename);
+        return;
+    }
+    stats_shape_t shape;
+    stats_bytes_t bytes;
+    qt_stats(tree, &shape, &bytes);
+    bytes.records = record_store_bytes(store);
+    if (cache == NULL) {
+        stats_write(stats_file, &shape, &bytes, NULL);
+    } else {
+        stats_cache_t counters = {cache->budget, cache->bytes, 
+            cache->entries, cache->hits, cache->misses, cache->evictions};
+        stats_write(stats_file, &shape, &bytes, &counters);
     }
-}
\ No newline at end of file
+    fclose(stats_file);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       WRITES the latency percentiles of each stage of the queries 
+ *              (as JSON)
+ * @param[in]   filename    The file to write the latencies to
+ * @param[in]   latency     The latencies recorded by the queries
+*/
+void 
+write_latency(const char *filename, latency_t *latency) {
+    FILE *latency_file = fopen(filename, "w");
+    if (latency_file == NULL) {
+        fprintf(stderr, "WARNING: could not write latencies to %s\n", 
+            filename);
+        return;
+    }
+    latency_write(latency_file, latency);
+    fclose(latency_file);
+}
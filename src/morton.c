@@ -0,0 +1,154 @@
+/**
+ * @file    morton.c
+ * @brief   A file for Z-order (Morton) keys of 2D points
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <math.h>
+
+#include "morton.h"
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+uint32_t morton_quantise(long double fraction);
+uint64_t morton_spread(uint32_t v);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       ENCODES a point as a Morton key relative to some bounds
+ * @param[in]   bounds  The rectangle the key is relative to (i.e. the root)
+ * @param[in]   point   The point to encode
+ * @return      A 64-bit key, 2 bits per quadrant level
+ * @note        Points on a shared edge are quantised to the same side as
+ *              rectangle_contains() places them
+*/
+uint64_t
+morton_encode(rectangle_t *bounds, point_2d_t point) {
+
+    // STEP 1: Measure x from the WEST edge & y from the NORTH edge, so that a
+    //         set bit means EAST or SOUTH respectively
+    uint32_t x = morton_quantise(((long double)point.x - bounds->bl.x) 
+        / (2.0L * bounds->hw));
+    uint32_t y = morton_quantise(((long double)bounds->tr.y - point.y) 
+        / (2.0L * bounds->hh));
+
+    // STEP 2: Interleave so each level reads (y-bit, x-bit) = NW, NE, SW, SE
+    return (morton_spread(y) << 1) | morton_spread(x);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       EXTRACTS the quadrant a key falls in at some depth
+ * @param[in]   key     The Morton key
+ * @param[in]   depth   The depth (0 = children of the root)
+ * @return      An INTEGER flag where: 0 indicates NW, 1 indicates NE,
+ *              2 indicates SW & 3 indicates SE
+*/
+int
+morton_quadrant(uint64_t key, int depth) {
+    assert((depth >= 0) && (depth < MORTON_BITS));
+    return (int)((key >> (2 * (MORTON_BITS - 1 - depth))) & 3);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       SORTS entries by key using a STABLE radix sort
+ * @param[out]  entries     The entries to sort
+ * @param[in]   n           The number of entries
+ * @note        Entries with EQUAL keys keep their relative order
+*/
+void
+morton_sort(morton_entry_t *entries, int n) {
+
+    // STEP 1: Allocate a scratch buffer to scatter into
+    int buckets = 1 << MORTON_RADIX_BITS;
+    morton_entry_t *src = entries;
+    morton_entry_t *dst = (morton_entry_t *)malloc(
+        sizeof(morton_entry_t) * (n > 0 ? n : 1));
+    assert(dst != NULL);
+    int *counts = (int *)malloc(sizeof(int) * buckets);
+    assert(counts != NULL);
+
+    // STEP 2: Sort from the LEAST significant digit upwards
+    for (int shift = 0; shift < 2 * MORTON_BITS; shift += MORTON_RADIX_BITS) {
+        memset(counts, 0, sizeof(int) * buckets);
+        for (int i = 0; i < n; i++) {
+            counts[(src[i].key >> shift) & (buckets - 1)]++;
+        }
+
+        // NOTE: a pass where every key shares the digit changes nothing
+        if (n && (counts[(src[0].key >> shift) & (buckets - 1)] == n)) {
+            continue;
+        }
+
+        // STEP 2A: Turn the counts into starting offsets & scatter
+        for (int b = 0, offset = 0; b < buckets; b++) {
+            int count = counts[b];
+            counts[b] = offset;
+            offset += count;
+        }
+        for (int i = 0; i < n; i++) {
+            dst[counts[(src[i].key >> shift) & (buckets - 1)]++] = src[i];
+        }
+        morton_entry_t *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    // STEP 3: Ensure the sorted result ends up in the caller's array
+    if (src != entries) {
+        memcpy(entries, src, sizeof(morton_entry_t) * n);
+        dst = src;
+    }
+    free(dst);
+    free(counts);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - QUANTISES a fraction of the root's extent
+ * @param[in]   fraction    A value in (0, 1]
+ * @return      An unsigned integer in [0, 2^MORTON_BITS - 1]
+ * @note        A fraction of exactly 0.5 lands in the LOWER half, matching
+ *              rectangle_contains() which keeps shared edges in the WEST &
+ *              NORTH quadrants
+*/
+uint32_t
+morton_quantise(long double fraction) {
+
+    long double scaled = ceill(fraction * 4294967296.0L) - 1;
+    if (scaled < 0) return 0;
+    if (scaled > 4294967295.0L) return UINT32_MAX;
+    return (uint32_t)scaled;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - SPREADS the bits of v so they occupy EVEN bits
+ * @param[in]   v   The value to spread
+ * @return      A 64-bit value with a 0 bit between each of v's bits
+*/
+uint64_t
+morton_spread(uint32_t v) {
+
+    uint64_t x = v;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x << 8))  & 0x00FF00FF00FF00FFULL;
+    x = (x | (x << 4))  & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x << 2))  & 0x3333333333333333ULL;
+    x = (x | (x << 1))  & 0x5555555555555555ULL;
+    return x;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file    morton.h
+ * @brief   A HEADER file for Z-order (Morton) keys of 2D points
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          Every 2 bits of a key (from the MOST significant end) select a
+ *          quadrant in the same order as the quad-tree's NW, NE, SW & SE
+ *          flags, so sorting by key visits points quadrant-by-quadrant
+*/
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#ifndef _MORTON_H_
+#define _MORTON_H_
+
+#define MORTON_BITS 32          // Bits of precision kept per AXIS
+#define MORTON_RADIX_BITS 8     // Bits sorted per pass of the radix sort
+
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT FILES
+#include <stdint.h>
+
+#include "coordinates.h"
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   A Morton KEY tagged with the index of the point it came from
+ * @param   key     The Z-order key of the point
+ * @param   index   The position of the point in the caller's input
+*/
+typedef struct morton_entry morton_entry_t;
+struct morton_entry {
+    uint64_t        key;
+    int             index;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// MORTON OPERATIONS:
+
+/**
+ * @brief       ENCODES a point as a Morton key relative to some bounds
+ * @param[in]   bounds  The rectangle the key is relative to (i.e. the root)
+ * @param[in]   point   The point to encode
+ * @return      A 64-bit key, 2 bits per quadrant level
+ * @note        Points on a shared edge are quantised to the same side as
+ *              rectangle_contains() places them
+*/
+uint64_t morton_encode(rectangle_t *bounds, point_2d_t point);
+
+/**
+ * @brief       EXTRACTS the quadrant a key falls in at some depth
+ * @param[in]   key     The Morton key
+ * @param[in]   depth   The depth (0 = children of the root)
+ * @return      An INTEGER flag where: 0 indicates NW, 1 indicates NE,
+ *              2 indicates SW & 3 indicates SE
+*/
+int morton_quadrant(uint64_t key, int depth);
+
+/**
+ * @brief       SORTS entries by key using a STABLE radix sort
+ * @param[out]  entries     The entries to sort
+ * @param[in]   n           The number of entries
+ * @note        Entries with EQUAL keys keep their relative order
+*/
+void morton_sort(morton_entry_t *entries, int n);
+
+#endif
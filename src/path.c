@@ -0,0 +1,186 @@
+/**
+ * @file    path.c
+ * @brief   A file for the implementation of a PACKED traversal path
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "path.h"
+#include "dynamic-array.h"
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+void path_grow(path_t *path, int word_count);
+int path_step(path_t *path, int i);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       INITIALISES an EMPTY path on the heap
+ * @return      A POINTER to a heap-allocated path
+*/
+path_t*
+path_init(void) {
+
+    path_t *new_path = (path_t *)malloc(sizeof(path_t));
+    assert(new_path != NULL);
+    new_path->words = (uint64_t *)malloc(sizeof(uint64_t) * PATH_INIT_WORDS);
+    assert(new_path->words != NULL);
+    new_path->length = 0;
+    new_path->word_count = PATH_INIT_WORDS;
+    return new_path;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       APPENDS a traversed quadrant to a path
+ * @param[out]  path        The path
+ * @param[in]   quadrant    Either NW, NE, SW or SE
+*/
+void
+path_append(path_t *path, int quadrant) {
+
+    // STEP 1: Make room for the quadrant
+    int word = path->length / PATH_QUADRANTS_PER_WORD;
+    int shift = 2 * (path->length % PATH_QUADRANTS_PER_WORD);
+    if (word == path->word_count) {
+        path_grow(path, word + 1);
+    }
+
+    // STEP 2: A word is ZEROED when it's 1st quadrant is written, so the
+    //         bits above the length are NEVER stale
+    if (shift == 0) {
+        path->words[word] = 0;
+    }
+    path->words[word] |= (uint64_t)quadrant << shift;
+    path->length++;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       APPENDS EVERY quadrant of another path to a path
+ * @param[out]  path    The path to extend
+ * @param[in]   suffix  The quadrants to append
+*/
+void
+path_extend(path_t *path, path_t *suffix) {
+    for (int i = 0; i < suffix->length; i++) {
+        path_append(path, path_step(suffix, i));
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       SHORTENS a path to it's 1st 'length' quadrants
+ * @param[out]  path    The path
+ * @param[in]   length  The new length (at most the current length), where 0
+ *                      EMPTIES the path
+*/
+void
+path_truncate(path_t *path, int length) {
+
+    // NOTE: the kept part of the last word is masked, so the next append 
+    //       can OR into it
+    assert((length >= 0) && (length <= path->length));
+    int shift = 2 * (length % PATH_QUADRANTS_PER_WORD);
+    if (shift > 0) {
+        path->words[length / PATH_QUADRANTS_PER_WORD] &= 
+            ((uint64_t)1 << shift) - 1;
+    }
+    path->length = length;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       COPIES a path
+ * @param[in]   path    The path to copy
+ * @return      A POINTER to a heap-allocated copy of path
+*/
+path_t*
+path_copy(path_t *path) {
+
+    path_t *copy = path_init();
+    int words = (path->length + PATH_QUADRANTS_PER_WORD - 1) 
+        / PATH_QUADRANTS_PER_WORD;
+    if (words > copy->word_count) {
+        path_grow(copy, words);
+    }
+    memcpy(copy->words, path->words, sizeof(uint64_t) * words);
+    copy->length = path->length;
+    return copy;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       RENDERS a path as text (e.g. " SW NE NW")
+ * @param[out]  stream  Where to print the path
+ * @param[in]   path    The path to print
+*/
+void
+path_print(FILE *stream, path_t *path) {
+
+    // NOTE: indexed by quadrant (i.e. NW, NE, SW & SE)
+    static const char *steps[] = {APPEND_NW, APPEND_NE, APPEND_SW, APPEND_SE};
+    for (int i = 0; i < path->length; i++) {
+        fputs(steps[path_step(path, i)], stream);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FREES a path from the heap
+ * @param[out]  path    The path to free
+*/
+void
+path_free(path_t *path) {
+    free(path->words);
+    free(path);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - GROWS a path to AT LEAST 'word_count' words
+ * @param[out]  path        The path
+ * @param[in]   word_count  The number of words needed
+*/
+void
+path_grow(path_t *path, int word_count) {
+
+    int new_count = path->word_count;
+    while (new_count < word_count) {
+        new_count *= REALLOC_FACTOR;
+    }
+    path->words = (uint64_t *)realloc(path->words, 
+        new_count * sizeof(uint64_t));
+    assert(path->words != NULL);
+    path->word_count = new_count;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - EXTRACTS ONE quadrant of a path
+ * @param[in]   path    The path
+ * @param[in]   i       The position of the quadrant (less than the length)
+ * @return      Either NW, NE, SW or SE
+*/
+int
+path_step(path_t *path, int i) {
+    return (path->words[i / PATH_QUADRANTS_PER_WORD] 
+        >> (2 * (i % PATH_QUADRANTS_PER_WORD))) & 3;
+}
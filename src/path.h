@@ -0,0 +1,102 @@
+/**
+ * @file    path.h
+ * @brief   A HEADER file for the implementation of a PACKED traversal path
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          A path is the sequence of quadrants a query traversed, kept as 2
+ *          bits per quadrant (in the same order as the quad-tree's NW, NE,
+ *          SW & SE flags) with a length counter, so appending a quadrant is
+ *          O(1). It is only RENDERED as text (e.g. " SW NE") when printed
+*/
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#ifndef _PATH_H_
+#define _PATH_H_
+
+#define PATH_QUADRANTS_PER_WORD 32  // 2-bit quadrants held by ONE word
+#define PATH_INIT_WORDS 4           // Words a new path has room for
+
+#define APPEND_NW " NW"         // Renders a NORTH-WEST step of the path
+#define APPEND_NE " NE"         // Renders a NORTH-EAST step of the path
+#define APPEND_SW " SW"         // Renders a SOUTH-WEST step of the path
+#define APPEND_SE " SE"         // Renders a SOUTH-EAST step of the path
+
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT FILES
+#include <stdio.h>
+#include <stdint.h>
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   A PACKED traversal path
+ * @param   words       The quadrants of the path (quadrant i is in bits 
+ *                      2*(i%32) & 2*(i%32)+1 of word i/32)
+ * @param   length      The number of quadrants in the path
+ * @param   word_count  The number of words allocated
+*/
+typedef struct path path_t;
+struct path {
+    uint64_t        *words;
+    int             length;
+    int             word_count;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// PATH OPERATIONS:
+
+/**
+ * @brief       INITIALISES an EMPTY path on the heap
+ * @return      A POINTER to a heap-allocated path
+*/
+path_t* path_init(void);
+
+/**
+ * @brief       APPENDS a traversed quadrant to a path
+ * @param[out]  path        The path
+ * @param[in]   quadrant    Either NW, NE, SW or SE
+*/
+void path_append(path_t *path, int quadrant);
+
+/**
+ * @brief       APPENDS EVERY quadrant of another path to a path
+ * @param[out]  path    The path to extend
+ * @param[in]   suffix  The quadrants to append
+*/
+void path_extend(path_t *path, path_t *suffix);
+
+/**
+ * @brief       SHORTENS a path to it's 1st 'length' quadrants
+ * @param[out]  path    The path
+ * @param[in]   length  The new length (at most the current length), where 0
+ *                      EMPTIES the path
+*/
+void path_truncate(path_t *path, int length);
+
+/**
+ * @brief       COPIES a path
+ * @param[in]   path    The path to copy
+ * @return      A POINTER to a heap-allocated copy of path
+*/
+path_t* path_copy(path_t *path);
+
+/**
+ * @brief       RENDERS a path as text (e.g. " SW NE NW")
+ * @param[out]  stream  Where to print the path
+ * @param[in]   path    The path to print
+*/
+void path_print(FILE *stream, path_t *path);
+
+/**
+ * @brief       FREES a path from the heap
+ * @param[out]  path    The path to free
+*/
+void path_free(path_t *path);
+
+#endif
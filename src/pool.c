@@ -0,0 +1,239 @@
+/**
+ * @file    pool.c
+ * @brief   A file for the implementation of a fixed-size block pool
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "pool.h"
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+pool_chunk_t* pool_chunk_init(pool_t *pool);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       INITIALISES an EMPTY pool on the heap
+ * @param[in]   block_size  The size (in bytes) of every block
+ * @param[in]   capacity    The number of blocks per chunk
+ * @return      A POINTER to a heap-allocated pool
+*/
+pool_t*
+pool_init(size_t block_size, int capacity) {
+
+    assert((block_size >= sizeof(void *)) && (capacity > 0));
+    pool_t *new_pool = (pool_t *)malloc(sizeof(pool_t));
+    assert(new_pool != NULL);
+
+    // NOTE: chunks are only allocated once the 1st block is requested
+    new_pool->block_size = block_size;
+    new_pool->capacity = capacity;
+    new_pool->chunks = NULL;
+    new_pool->free_list = NULL;
+    new_pool->block_count = 0;
+    return new_pool;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       ALLOCATES a single block from the pool
+ * @param[out]  pool    The pool to carve a block from
+ * @return      A POINTER to an UNINITIALISED block of 'block_size' bytes
+*/
+void*
+pool_alloc(pool_t *pool) {
+
+    // STEP 1: Re-use a RELEASED block if there is one
+    assert(pool != NULL);
+    if (pool->free_list != NULL) {
+        void *block = pool->free_list;
+        pool->free_list = *(void **)block;
+        pool->block_count++;
+        return block;
+    }
+
+    // STEP 2: Grab a new chunk if the current one is exhausted
+    if ((pool->chunks == NULL) || (pool->chunks->used == pool->capacity)) {
+        pool->chunks = pool_chunk_init(pool);
+    }
+
+    // STEP 3: Hand out the next unused block of the current chunk
+    void *block = pool->chunks->blocks
+        + ((size_t)pool->chunks->used * pool->block_size);
+    pool->chunks->used++;
+    pool->block_count++;
+    return block;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       RELEASES a single block back to the pool for re-use
+ * @param[out]  pool    The pool the block was allocated from
+ * @param[in]   block   The block to release
+ * @note        The block's first bytes are overwritten by the free list
+*/
+void
+pool_release(pool_t *pool, void *block) {
+    assert((pool != NULL) && (block != NULL));
+    *(void **)block = pool->free_list;
+    pool->free_list = block;
+    pool->block_count--;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       MEASURES the bytes of every chunk a pool holds
+ * @param[in]   pool    The pool
+ * @return      The bytes held (whether the blocks are handed out or not)
+*/
+size_t
+pool_bytes(pool_t *pool) {
+    size_t bytes = 0;
+    for (pool_chunk_t *chunk = pool->chunks; chunk != NULL; 
+        chunk = chunk->next) {
+        bytes += sizeof(pool_chunk_t) + pool->block_size * pool->capacity;
+    }
+    return bytes;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FREES the pool & EVERY block it has handed out
+ * @param[out]  pool    The pool to free
+*/
+void
+pool_free(pool_t *pool) {
+
+    // STEP 1: Release the chunks (& hence their blocks) one-by-one
+    pool_chunk_t *current_chunk = pool->chunks;
+    pool_chunk_t *next_chunk;
+    while (current_chunk != NULL) {
+        next_chunk = current_chunk->next;
+        free(current_chunk->blocks);
+        free(current_chunk);
+        current_chunk = next_chunk;
+    }
+
+    // STEP 2: Free the pool itself
+    free(pool);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       INITIALISES EMPTY size classes on the heap
+ * @param[in]   base_size   The size (in bytes) of a block of class 0
+ * @param[in]   capacity    The number of blocks per chunk of class 0
+ * @return      A POINTER to heap-allocated size classes
+*/
+pool_classes_t*
+pool_classes_init(size_t base_size, int capacity) {
+    assert((base_size >= sizeof(void *)) && (capacity > 0));
+    pool_classes_t *new_classes = (pool_classes_t *)calloc(1, 
+        sizeof(pool_classes_t));
+    assert(new_classes != NULL);
+    new_classes->base_size = base_size;
+    new_classes->capacity = capacity;
+    return new_classes;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       ALLOCATES a single block of a size class
+ * @param[out]  classes     The size classes
+ * @param[in]   size_class  The class of the block
+ * @return      A POINTER to an UNINITIALISED block of 'base_size << 
+ *              size_class' bytes
+*/
+void*
+pool_classes_alloc(pool_classes_t *classes, int size_class) {
+
+    // NOTE: a class's pool is only made once it's 1st block is requested
+    assert((size_class >= 0) && (size_class < POOL_CLASSES));
+    if (classes->pools[size_class] == NULL) {
+        int capacity = classes->capacity >> size_class;
+        classes->pools[size_class] = pool_init(
+            classes->base_size << size_class, (capacity > 0) ? capacity : 1);
+    }
+    return pool_alloc(classes->pools[size_class]);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       RELEASES a single block back to it's size class for re-use
+ * @param[out]  classes     The size classes
+ * @param[in]   size_class  The class the block was allocated from
+ * @param[in]   block       The block to release
+*/
+void
+pool_classes_release(pool_classes_t *classes, int size_class, void *block) {
+    assert((size_class >= 0) && (size_class < POOL_CLASSES) 
+        && (classes->pools[size_class] != NULL));
+    pool_release(classes->pools[size_class], block);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       MEASURES the bytes of every chunk a range of classes holds
+ * @param[in]   classes     The size classes
+ * @param[in]   first       The 1st class measured
+ * @param[in]   last        The last class measured
+ * @return      The bytes held (whether the blocks are handed out or not)
+*/
+size_t
+pool_classes_bytes(pool_classes_t *classes, int first, int last) {
+    size_t bytes = 0;
+    for (int c = first; c <= last; c++) {
+        if (classes->pools[c] != NULL) bytes += pool_bytes(classes->pools[c]);
+    }
+    return bytes;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FREES the size classes & EVERY block they have handed out
+ * @param[out]  classes     The size classes to free
+*/
+void
+pool_classes_free(pool_classes_t *classes) {
+    for (int c = 0; c < POOL_CLASSES; c++) {
+        if (classes->pools[c] != NULL) pool_free(classes->pools[c]);
+    }
+    free(classes);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - ALLOCATES a new chunk & links it to the pool
+ * @param[in]   pool    The pool that will own the chunk
+ * @return      A POINTER to the new (EMPTY) chunk
+*/
+pool_chunk_t*
+pool_chunk_init(pool_t *pool) {
+
+    pool_chunk_t *new_chunk = (pool_chunk_t *)malloc(sizeof(pool_chunk_t));
+    assert(new_chunk != NULL);
+
+    new_chunk->blocks = (char *)malloc(pool->block_size * pool->capacity);
+    assert(new_chunk->blocks != NULL);
+    new_chunk->used = 0;
+    new_chunk->next = pool->chunks;
+    return new_chunk;
+}
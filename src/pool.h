@@ -0,0 +1,152 @@
+/**
+ * @file    pool.h
+ * @brief   A HEADER file for the implementation of a fixed-size block pool
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#ifndef _POOL_H_
+#define _POOL_H_
+
+#define POOL_BLOCKS_PER_CHUNK 1024  // Number of blocks carved from ONE chunk
+#define POOL_CLASSES 32             // Size classes of a pool_classes_t
+
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT FILES
+#include <stddef.h>
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   A single heap allocation that blocks are carved out of
+ * @param   blocks  The CONTIGUOUS memory holding 'capacity' blocks
+ * @param   used    The number of blocks handed out so far
+ * @param   next    The previously allocated chunk
+*/
+typedef struct pool_chunk pool_chunk_t;
+struct pool_chunk {
+    char            *blocks;
+    int             used;
+    pool_chunk_t    *next;
+};
+
+/**
+ * @brief   A POOL that hands out fixed-size blocks & releases them all at once
+ * @param   block_size      The size (in bytes) of every block
+ * @param   capacity        The number of blocks per chunk
+ * @param   chunks          The most recently allocated chunk
+ * @param   free_list       Blocks RELEASED back to the pool (for re-use)
+ * @param   block_count     The number of blocks currently handed out
+*/
+typedef struct pool pool_t;
+struct pool {
+    size_t          block_size;
+    int             capacity;
+    pool_chunk_t    *chunks;
+    void            *free_list;
+    unsigned long   block_count;
+};
+
+/**
+ * @brief   POOLS of blocks whose size DOUBLES from one class to the next (i.e.
+ *          class c hands out blocks of 'base_size << c' bytes), for blocks
+ *          that GROW but must still be released all at once
+ * @param   base_size   The size (in bytes) of a block of class 0
+ * @param   capacity    The number of blocks per chunk of class 0 (HALVED for
+ *                      each larger class, down to 1)
+ * @param   pools       The pool of each class, & NULL until it is 1st used
+*/
+typedef struct pool_classes pool_classes_t;
+struct pool_classes {
+    size_t          base_size;
+    int             capacity;
+    pool_t          *pools[POOL_CLASSES];
+};
+
+/* -------------------------------------------------------------------------- */
+
+// POOL OPERATIONS:
+
+/**
+ * @brief       INITIALISES an EMPTY pool on the heap
+ * @param[in]   block_size  The size (in bytes) of every block
+ * @param[in]   capacity    The number of blocks per chunk
+ * @return      A POINTER to a heap-allocated pool
+*/
+pool_t* pool_init(size_t block_size, int capacity);
+
+/**
+ * @brief       ALLOCATES a single block from the pool
+ * @param[out]  pool    The pool to carve a block from
+ * @return      A POINTER to an UNINITIALISED block of 'block_size' bytes
+*/
+void* pool_alloc(pool_t *pool);
+
+/**
+ * @brief       RELEASES a single block back to the pool for re-use
+ * @param[out]  pool    The pool the block was allocated from
+ * @param[in]   block   The block to release
+ * @note        The block's first bytes are overwritten by the free list
+*/
+void pool_release(pool_t *pool, void *block);
+
+/**
+ * @brief       MEASURES the bytes of every chunk a pool holds
+ * @param[in]   pool    The pool
+ * @return      The bytes held (whether the blocks are handed out or not)
+*/
+size_t pool_bytes(pool_t *pool);
+
+/**
+ * @brief       FREES the pool & EVERY block it has handed out
+ * @param[out]  pool    The pool to free
+*/
+void pool_free(pool_t *pool);
+
+/**
+ * @brief       INITIALISES EMPTY size classes on the heap
+ * @param[in]   base_size   The size (in bytes) of a block of class 0
+ * @param[in]   capacity    The number of blocks per chunk of class 0
+ * @return      A POINTER to heap-allocated size classes
+*/
+pool_classes_t* pool_classes_init(size_t base_size, int capacity);
+
+/**
+ * @brief       ALLOCATES a single block of a size class
+ * @param[out]  classes     The size classes
+ * @param[in]   size_class  The class of the block
+ * @return      A POINTER to an UNINITIALISED block of 'base_size << 
+ *              size_class' bytes
+*/
+void* pool_classes_alloc(pool_classes_t *classes, int size_class);
+
+/**
+ * @brief       RELEASES a single block back to it's size class for re-use
+ * @param[out]  classes     The size classes
+ * @param[in]   size_class  The class the block was allocated from
+ * @param[in]   block       The block to release
+*/
+void pool_classes_release(pool_classes_t *classes, int size_class, 
+    void *block);
+
+/**
+ * @brief       MEASURES the bytes of every chunk a range of classes holds
+ * @param[in]   classes     The size classes
+ * @param[in]   first       The 1st class measured
+ * @param[in]   last        The last class measured
+ * @return      The bytes held (whether the blocks are handed out or not)
+*/
+size_t pool_classes_bytes(pool_classes_t *classes, int first, int last);
+
+/**
+ * @brief       FREES the size classes & EVERY block they have handed out
+ * @param[out]  classes     The size classes to free
+*/
+void pool_classes_free(pool_classes_t *classes);
+
+#endif
@@ -0,0 +1,158 @@
+/**
+ * @file    priority-queue.c
+ * @brief   A file for the implementation of a priority queue
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "priority-queue.h"
+#include "dynamic-array.h"
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+int pq_key_less(pq_key_t *k1, pq_key_t *k2);
+void pq_grow(pq_t *pq);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       INITIALISES an EMPTY priority queue on the heap
+ * @param[in]   entry_size  The size of ONE entry
+ * @return      A POINTER to a heap-allocated priority queue
+*/
+pq_t*
+pq_init(size_t entry_size) {
+
+    pq_t *new_pq = (pq_t *)malloc(sizeof(pq_t));
+    assert(new_pq != NULL);
+    new_pq->capacity = PQ_INIT_CAPACITY;
+    new_pq->entry_size = entry_size;
+    new_pq->keys = (pq_key_t *)malloc(sizeof(pq_key_t) * PQ_INIT_CAPACITY);
+    new_pq->entries = (char *)malloc(entry_size * PQ_INIT_CAPACITY);
+    new_pq->free_slots = (int *)malloc(sizeof(int) * PQ_INIT_CAPACITY);
+    assert((new_pq->keys != NULL) && (new_pq->entries != NULL)
+        && (new_pq->free_slots != NULL));
+    new_pq->count = 0;
+    new_pq->free_count = 0;
+    new_pq->pushed = 0;
+    return new_pq;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       PUSHES an entry onto a priority queue
+ * @param[out]  pq          The priority queue
+ * @param[in]   priority    The entry's priority
+ * @param[in]   entry       The entry (it is COPIED)
+*/
+void
+pq_push(pq_t *pq, long double priority, const void *entry) {
+
+    // STEP 1: Store the entry in a popped slot, or the next unused one
+    if (pq->count == pq->capacity) {
+        pq_grow(pq);
+    }
+    int slot = (pq->free_count > 0)
+        ? pq->free_slots[--pq->free_count] : pq->count;
+    memcpy(pq->entries + slot * pq->entry_size, entry, pq->entry_size);
+
+    // STEP 2: Sift the new key UP the heap until it's parent is lower
+    pq_key_t key = {priority, pq->pushed++, slot};
+    int i = pq->count++;
+    while ((i > 0) && pq_key_less(&key, &pq->keys[(i - 1) / 2])) {
+        pq->keys[i] = pq->keys[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    pq->keys[i] = key;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       POPS the entry with the LOWEST priority
+ * @param[out]  pq          The (non-empty) priority queue
+ * @param[out]  entry       Filled with the popped entry
+ * @return      The popped entry's priority
+*/
+long double
+pq_pop(pq_t *pq, void *entry) {
+
+    // STEP 1: Copy out the top entry & hand it's slot back
+    assert(pq->count > 0);
+    pq_key_t top = pq->keys[0];
+    memcpy(entry, pq->entries + top.slot * pq->entry_size, pq->entry_size);
+    pq->free_slots[pq->free_count++] = top.slot;
+
+    // STEP 2: Sift the last key DOWN from the top until it's children are
+    //         higher
+    pq_key_t last = pq->keys[--pq->count];
+    int i = 0, child;
+    while ((child = 2 * i + 1) < pq->count) {
+        if ((child + 1 < pq->count)
+            && pq_key_less(&pq->keys[child + 1], &pq->keys[child])) {
+            child++;
+        }
+        if (! pq_key_less(&pq->keys[child], &last)) break;
+        pq->keys[i] = pq->keys[child];
+        i = child;
+    }
+    pq->keys[i] = last;
+    return top.priority;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FREES a priority queue from the heap
+ * @param[out]  pq  The priority queue to free
+*/
+void
+pq_free(pq_t *pq) {
+    free(pq->keys);
+    free(pq->entries);
+    free(pq->free_slots);
+    free(pq);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - COMPARES the keys of TWO entries
+ * @param[in]   k1  1st key
+ * @param[in]   k2  2nd key
+ * @return      1 if k1 is popped BEFORE k2, & 0 otherwise
+*/
+int
+pq_key_less(pq_key_t *k1, pq_key_t *k2) {
+    if (k1->priority != k2->priority) {
+        return k1->priority < k2->priority;
+    }
+    return k1->sequence < k2->sequence;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - DOUBLES the number of entries there is room for
+ * @param[out]  pq  The (full) priority queue
+*/
+void
+pq_grow(pq_t *pq) {
+    pq->capacity *= REALLOC_FACTOR;
+    pq->keys = (pq_key_t *)realloc(pq->keys, sizeof(pq_key_t) * pq->capacity);
+    pq->entries = (char *)realloc(pq->entries,
+        pq->entry_size * pq->capacity);
+    pq->free_slots = (int *)realloc(pq->free_slots,
+        sizeof(int) * pq->capacity);
+    assert((pq->keys != NULL) && (pq->entries != NULL)
+        && (pq->free_slots != NULL));
+}
@@ -0,0 +1,98 @@
+/**
+ * @file    priority-queue.h
+ * @brief   A HEADER file for the implementation of a priority queue
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          A BINARY min-heap of fixed-size entries, each with a long double
+ *          priority. Entries of EQUAL priority are popped in the order they
+ *          were pushed, so a search using the queue is deterministic
+*/
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#ifndef _PRIORITY_QUEUE_H_
+#define _PRIORITY_QUEUE_H_
+
+#define PQ_INIT_CAPACITY 64     // Entries a new priority queue has room for
+
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT FILES
+#include <stddef.h>
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   The priority of ONE entry of a priority queue
+ * @param   priority    The entry's priority (LOWEST is popped first)
+ * @param   sequence    The number of entries pushed before it
+ * @param   slot        Where the entry is stored in the queue's entries
+*/
+typedef struct pq_key pq_key_t;
+struct pq_key {
+    long double     priority;
+    long            sequence;
+    int             slot;
+};
+
+/**
+ * @brief   A priority queue
+ * @param   keys        The heap of priorities
+ * @param   entries     The entries, 'entry_size' bytes each (they are NOT
+ *                      moved whilst the heap is reordered)
+ * @param   free_slots  The slots of entries that have been popped
+ * @param   count       The number of entries queued
+ * @param   free_count  The number of free slots
+ * @param   capacity    The number of entries there is room for
+ * @param   entry_size  The size of ONE entry
+ * @param   pushed      The number of entries EVER pushed
+*/
+typedef struct pq pq_t;
+struct pq {
+    pq_key_t        *keys;
+    char            *entries;
+    int             *free_slots;
+    int             count;
+    int             free_count;
+    int             capacity;
+    size_t          entry_size;
+    long            pushed;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// PRIORITY QUEUE OPERATIONS:
+
+/**
+ * @brief       INITIALISES an EMPTY priority queue on the heap
+ * @param[in]   entry_size  The size of ONE entry
+ * @return      A POINTER to a heap-allocated priority queue
+*/
+pq_t* pq_init(size_t entry_size);
+
+/**
+ * @brief       PUSHES an entry onto a priority queue
+ * @param[out]  pq          The priority queue
+ * @param[in]   priority    The entry's priority
+ * @param[in]   entry       The entry (it is COPIED)
+*/
+void pq_push(pq_t *pq, long double priority, const void *entry);
+
+/**
+ * @brief       POPS the entry with the LOWEST priority
+ * @param[out]  pq          The (non-empty) priority queue
+ * @param[out]  entry       Filled with the popped entry
+ * @return      The popped entry's priority
+*/
+long double pq_pop(pq_t *pq, void *entry);
+
+/**
+ * @brief       FREES a priority queue from the heap
+ * @param[out]  pq  The priority queue to free
+*/
+void pq_free(pq_t *pq);
+
+#endif
@@ -21,63 +21,147 @@
 #include <string.h>
 
 #include "quad-tree.h"
+#include "linear-quad-tree.h"
+#include "priority-queue.h"
 
 /* -------------------------------------------------------------------------- */
 
 // AUXILLARY PROTOTYPE FUNCTIONS:
-int qt_recursive_insert(qt_tree_t *tree, qt_node_t *root, point_2d_t *point, data_t *data);
-void qt_recursive_range_query(qt_node_t *root, char *path, rectangle_t *range, array_t *matches);
-void qt_recursive_free(qt_tree_t *tree, qt_node_t *root);
+void qt_node_reset(qt_node_t *node);
+void qt_pools_init(qt_tree_t *tree);
+void qt_pools_free(qt_tree_t *tree);
+void qt_free_nodes(qt_tree_t *tree);
 void qt_subdivide(qt_tree_t *tree, qt_node_t *root);
-int qt_determine_quadrant(qt_node_t *root, point_2d_t *point);
-void qt_repair_internal(qt_node_t *root);
-
+int qt_pick_quadrant(rectangle_t *children, point_2d_t *point);
+void qt_repair_internal(qt_tree_t *tree, qt_node_t *root, 
+    rectangle_t *bounds);
+int qt_leaf_find(qt_node_t *node, point_2d_t *point);
+int qt_holds(qt_tree_t *tree, point_2d_t *point, int footpath_id);
+int qt_leaf_is_full(qt_tree_t *tree, qt_node_t *node, int depth);
+int qt_slot_class(qt_tree_t *tree, int point_count);
+int qt_depth_limit(qt_tree_t *tree);
+void qt_leaf_add(qt_tree_t *tree, qt_node_t *node, point_2d_t *point, 
+    array_t *items);
+array_t* qt_items_init(qt_tree_t *tree);
+void qt_items_add(qt_tree_t *tree, array_t *items, record_ref_t data);
+array_t* qt_items_copy(qt_tree_t *tree, array_t *items);
+void qt_items_free(qt_tree_t *tree, array_t *items);
+void qt_leaf_remove(qt_tree_t *tree, qt_node_t *node, int slot);
+int qt_can_coalesce(qt_tree_t *tree, qt_node_t *root);
+void qt_coalesce(qt_tree_t *tree, qt_node_t *root);
+qt_node_t* qt_cow_begin(qt_tree_t *tree);
+void qt_cow_publish(qt_tree_t *tree, qt_node_t *root);
+void qt_cow_own_children(qt_tree_t *tree, qt_node_t *node);
+void qt_cow_own_slots(qt_tree_t *tree, qt_node_t *node);
+void qt_cow_own_items(qt_tree_t *tree, qt_slot_t *slot);
+void qt_reclaim(void *block, int kind, void *context);
+bitmap_t* qt_seen_acquire(qt_tree_t *tree);
+void qt_seen_release(qt_tree_t *tree, bitmap_t *seen);
+void qt_subtree_range_batch(qt_node_t *root, rectangle_t *bounds, 
+    rectangle_t *ranges, int n, array_t **results, path_t **paths);
+void qt_bulk_build(qt_tree_t *tree, qt_node_t *root, rectangle_t *bounds, 
+    int depth, point_2d_t *points, record_ref_t *data, 
+    morton_entry_t *entries, morton_entry_t *scratch, int n);
+void qt_bulk_leaf(qt_tree_t *tree, qt_node_t *root, point_2d_t *points, 
+    record_ref_t *data, morton_entry_t *entries, int n);
+int qt_cmp_entry_index(const void *e1, const void *e2);
+void qt_append_match(record_ref_t item, void *matches);
+array_t* qt_finger_search(qt_tree_t *tree, point_2d_t *point, path_t *path, 
+    qt_finger_t **fingers, int *capacity, int *depth);
+morton_entry_t* qt_batch_order(qt_tree_t *tree, point_2d_t *points, 
+    rectangle_t *ranges, int n);
+array_t* qt_copy_items(array_t *items);
+array_t* qt_range_collect(qt_tree_t *tree, path_t *path, rectangle_t *range,
+    bitmap_t *seen);
+array_t* qt_finish_matches(array_t *matches, bitmap_t *seen);
+void qt_knn_expand(pq_t *queue, qt_knn_t *knn, qt_knn_entry_t *entry);
 
 /* -------------------------------------------------------------------------- */
 
 /**
  * @brief       INITIALISES an EMPTY quad-tree NODE
  * @param[out]  tree    The quad-tree which will have a new node
- * @param[in]   bounds  The boundary for which the quad-tree node is defined
  * @return      A POINTER to a heap-allocated quad-tree NODE
 */
 qt_node_t* 
-qt_node_init(qt_tree_t *tree, rectangle_t bounds) {
+qt_node_init(qt_tree_t *tree) {
 
     qt_node_t *new_node = (qt_node_t *)malloc(sizeof(qt_node_t));
     assert(new_node != NULL);
 
-    // NOTE: we do not initialise 'point' as new nodes are WHITE (i.e. empty)
-    new_node->color = WHITE;
-    new_node->bounds = bounds;
-    new_node->point = NULL;
-    new_node->items = NULL;
-    new_node->ne = new_node->nw = new_node->se = new_node->sw = NULL;
-
+    qt_node_reset(new_node);
     tree->node_count++;
     return new_node;
 }
 
 /* -------------------------------------------------------------------------- */
 
+/**
+ * @brief       AUXILLARY - RESETS a quad-tree NODE to be EMPTY (i.e. WHITE)
+ * @param[out]  node    The node to reset
+*/
+void 
+qt_node_reset(qt_node_t *node) {
+
+    // NOTE: new nodes are WHITE (i.e. empty) so they have NO slots
+    node->color = WHITE;
+    node->point_count = 0;
+    node->slots = NULL;
+    node->children = NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+
 /**
  * @brief       INITIALISES a quad-tree INTERFACE
- * @param[in]   bounds  The boundary for which the quad-tree node is defined
+ * @param[in]   bounds          The boundary for which the quad-tree is defined
+ * @param[in]   leaf_capacity   The DISTINCT points a leaf holds before it 
+ *                              splits (QT_DEFAULT_LEAF_CAPACITY gives the 
+ *                              classic 1 point per BLACK node)
+ * @param[in]   max_depth       The depth at which leaves stop splitting, or
+ *                              QT_UNLIMITED_DEPTH
  * @return      A POINTER to a heap-allocated quad-tree INTERFACE
 */
 qt_tree_t* 
-qt_tree_init(rectangle_t bounds) {
+qt_tree_init(rectangle_t bounds, int leaf_capacity, int max_depth) {
 
+    assert((leaf_capacity >= 1) && (max_depth >= QT_UNLIMITED_DEPTH) 
+        && (max_depth <= QT_MAX_DEPTH));
     qt_tree_t *new_tree = (qt_tree_t *)malloc(sizeof(qt_tree_t));
     assert(new_tree != NULL);
 
+    new_tree->bounds = bounds;
     new_tree->node_count = 0;
-    new_tree->root = qt_node_init(new_tree, bounds);
+    new_tree->leaf_capacity = leaf_capacity;
+    new_tree->max_depth = max_depth;
+    qt_pools_init(new_tree);
+    new_tree->root = qt_node_init(new_tree);
+    new_tree->linear = NULL;
+    new_tree->seen = bitmap_init();
+    new_tree->epoch = NULL;
     return new_tree;
 }
 
 /* -------------------------------------------------------------------------- */
 
+/**
+ * @brief       SWITCHES a quad-tree to CONCURRENT mode, where ONE writer 
+ *              updates it whilst ANY number of readers query it, lock-free
+ * @param[out]  tree    The (pointer-based) quad-tree to share
+ * @note        Updates then COPY the nodes on their root-to-leaf path & 
+ *              publish a new root, so readers only ever see whole versions.
+ *              A reader registers ONCE via epoch_register(tree->epoch), & 
+ *              brackets each query (& it's use of the results) with 
+ *              epoch_enter() & epoch_exit()
+*/
+void 
+qt_concurrent_init(qt_tree_t *tree) {
+    assert((tree != NULL) && (tree->linear == NULL) && (tree->epoch == NULL));
+    tree->epoch = epoch_init(qt_reclaim, tree);
+}
+
+/* -------------------------------------------------------------------------- */
+
 /**
  * @brief       INSERTS a 2D point & new nodes into the quad-tree
  * @param[out]  tree    The quad-tree to insert new points & nodes into
@@ -87,81 +171,459 @@ qt_tree_init(rectangle_t bounds) {
  *              1 means SUCCESSFUL insertion
 */
 int 
-qt_insert(qt_tree_t *tree, point_2d_t *point, data_t *data) {
-    assert(tree != NULL);
+qt_insert(qt_tree_t *tree, point_2d_t *point, record_ref_t data) {
+    assert((tree != NULL) && (tree->linear == NULL));
     int integer_flag;
-    integer_flag = qt_recursive_insert(tree, tree->root, point, data);
+
+    // CASE 1: Readers may be inside, so update a COPY & then publish it
+    if (tree->epoch != NULL) {
+        qt_node_t *root = qt_cow_begin(tree);
+        integer_flag = qt_subtree_insert(tree, root, &tree->bounds, 0, point, 
+            data);
+        qt_cow_publish(tree, root);
+        return integer_flag;
+    }
+
+    // CASE 2: Otherwise update the nodes in place
+    integer_flag = qt_subtree_insert(tree, tree->root, &tree->bounds, 0, 
+        point, data);
     return integer_flag;
 }
 
 /* -------------------------------------------------------------------------- */
 
 /**
- * @brief       AUXILLARY - RECURSIVELY INSERTS a 2D point into the quad-tree
+ * @brief       AUXILLARY - INSERTS a 2D point into a subtree, ITERATIVELY
+ *              descending from it's root (i.e. in bounded stack space)
  * @param[out]  tree    The quad-tree to insert new points & nodes into
- * @param[out]  root    The current root node of subtree
+ * @param[out]  root    The root node of the subtree
+ * @param[in]   bounds  The bounds of root
+ * @param[in]   depth   The depth of root
  * @param[in]   point   The point to insert in the quad-tree
  * @param[in]   data    The DATA associated with the POINT
  * @return      An integer flag where: 0 means UNSUCCESSFUL insertion &
  *              1 means SUCCESSFUL insertion
+ * @note        In a CONCURRENT quad-tree, root is an unpublished copy & every
+ *              node below it readers may reach is COPIED before it changes
 */
 int 
-qt_recursive_insert(qt_tree_t *tree, 
-    qt_node_t *root, point_2d_t *point, data_t *data) {
+qt_subtree_insert(qt_tree_t *tree, qt_node_t *root, rectangle_t *bounds,
+    int depth, point_2d_t *point, record_ref_t data) {
 
     // STEP 1: Check if node is within bounds
-    if (! rectangle_contains(root->bounds, *point)) {
-        free(point);
+    if (! rectangle_contains(*bounds, *point)) {
         return UNSUCCESSFUL;
     }
+    rectangle_t node_bounds = *bounds;
+    int shared = (tree->epoch != NULL);
+
+    // STEP 2: Keep descending until the point is placed (leaves at the
+    //         maximum depth NEVER split, so this terminates)
+    while (1) {
+
+        // CASE 2A: We have an EMPTY (i.e. WHITE) node 
+        if (root->color == WHITE) {
+            array_t *items = qt_items_init(tree);
+            qt_items_add(tree, items, data);
+            qt_leaf_add(tree, root, point, items);
+            return SUCCESSFUL;
+        }
+
+        // CASE 2B: We have a LEAF node (i.e. BLACK)
+        if (root->color == BLACK) {
+            if (shared) qt_cow_own_slots(tree, root);
+
+            // CASE 2B-1: The point is ALREADY in the leaf
+            int slot = qt_leaf_find(root, point);
+            if (slot >= 0) {
+                if (shared) qt_cow_own_items(tree, &root->slots[slot]);
+                qt_items_add(tree, root->slots[slot].items, data);
+                return SUCCESSFUL;
+
+            // CASE 2B-2: The point is NEW & the leaf has room for it
+            } else if (! qt_leaf_is_full(tree, root, depth)) {
+                array_t *items = qt_items_init(tree);
+                qt_items_add(tree, items, data);
+                qt_leaf_add(tree, root, point, items);
+                return SUCCESSFUL;
+
+            // CASE 2B-3: The point is NEW but the leaf is FULL (NOTE: the new
+            //            children are NOT reachable by readers)
+            } else {
+                root->color = GREY;
+                qt_subdivide(tree, root);
+                qt_repair_internal(tree, root, &node_bounds);
+                shared = 0;
+            }
+        }
 
-    // STEP 2: We have an EMPTY (i.e. WHITE) node 
-    if (root->color == WHITE) {
-        root->color = BLACK;
-        root->point = point;
-        root->items = array_init();
-        array_sort_append(root->items, data);
-        return SUCCESSFUL;
+        // CASE 2C: We have to traverse to the next node (i.e. GREY)
+        if (shared) qt_cow_own_children(tree, root);
+        int child_flag = qt_determine_quadrant(&node_bounds, point, 
+            &node_bounds);
+        root = &root->children[child_flag];
+        depth++;
     }
+}
 
-    // STEP 3: We have a node with 1 point (i.e. BLACK)
-    if (root->color == BLACK) {
+/* -------------------------------------------------------------------------- */
 
-        // CASE 3A: Points are the SAME
-        if (equal_point_2d(*root->point, *point)) {
-            array_sort_append(root->items, data);
-            free(point);
-            return SUCCESSFUL;
+/**
+ * @brief       REMOVES the DATA with a footpath_id from a 2D point, COALESCING
+ *              any GREY node whose children then fit in ONE leaf
+ * @param[out]  tree        The quad-tree to remove from
+ * @param[in]   point       The point the data was inserted at
+ * @param[in]   footpath_id The footpath_id of the data to remove
+ * @return      An integer flag where: 0 means the data was NOT at the point &
+ *              1 means SUCCESSFUL removal
+ * @note        A point is dropped from it's leaf once it has NO data left
+*/
+int 
+qt_remove(qt_tree_t *tree, point_2d_t *point, int footpath_id) {
+    assert((tree != NULL) && (tree->linear == NULL));
+
+    // CASE 1: Readers may be inside, so update a COPY & then publish it
+    //         (NOTE: a removal that changes NOTHING copies & publishes NOTHING)
+    if (tree->epoch != NULL) {
+        if (! qt_holds(tree, point, footpath_id)) {
+            return UNSUCCESSFUL;
+        }
+        qt_node_t *root = qt_cow_begin(tree);
+        int integer_flag = qt_subtree_remove(tree, root, &tree->bounds, point, 
+            footpath_id);
+        qt_cow_publish(tree, root);
+        return integer_flag;
+    }
 
-        // CASE 3B: Points are NOT the same
-        } else {
-            root->color = GREY;
-            qt_subdivide(tree, root);
-            qt_repair_internal(root);
+    // CASE 2: Otherwise update the nodes in place
+    return qt_subtree_remove(tree, tree->root, &tree->bounds, point, 
+        footpath_id);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - REMOVES the DATA with a footpath_id from a 2D point
+ *              in a subtree, ITERATIVELY descending from it's root
+ * @param[out]  tree        The quad-tree to remove from
+ * @param[out]  root        The root node of the subtree
+ * @param[in]   bounds      The bounds of root
+ * @param[in]   point       The point the data was inserted at
+ * @param[in]   footpath_id The footpath_id of the data to remove
+ * @return      An integer flag where: 0 means the data was NOT at the point &
+ *              1 means SUCCESSFUL removal
+ * @note        In a CONCURRENT quad-tree, root is an unpublished copy & every
+ *              node below it readers may reach is COPIED before it changes
+*/
+int 
+qt_subtree_remove(qt_tree_t *tree, qt_node_t *root, rectangle_t *bounds,
+    point_2d_t *point, int footpath_id) {
+
+    // STEP 1: Check if node is within bounds
+    if (! rectangle_contains(*bounds, *point)) {
+        return UNSUCCESSFUL;
+    }
+    qt_node_t *ancestors[QT_MAX_DEPTH];
+    int ancestor_count = 0;
+    rectangle_t node_bounds = *bounds;
+    int shared = (tree->epoch != NULL);
+
+    // STEP 2: Descend to the leaf, remembering the INTERNAL (i.e. GREY) nodes
+    //         passed on the way
+    while (root->color == GREY) {
+        assert(ancestor_count < QT_MAX_DEPTH);
+        if (shared) qt_cow_own_children(tree, root);
+        ancestors[ancestor_count++] = root;
+        int child_flag = qt_determine_quadrant(&node_bounds, point, 
+            &node_bounds);
+        root = &root->children[child_flag];
+    }
+
+    // STEP 3: We have a LEAF (i.e. BLACK) node, so find the point's data
+    int slot;
+    if ((root->color != BLACK) || ((slot = qt_leaf_find(root, point)) < 0)
+        || (array_binary_search(root->slots[slot].items, footpath_id) 
+        == NULL)) {
+        return UNSUCCESSFUL;
+    }
+    if (shared) {
+        qt_cow_own_slots(tree, root);
+        qt_cow_own_items(tree, &root->slots[slot]);
+    }
+
+    // STEP 4: Remove the data & drop the point once it has NO data left
+    array_remove(root->slots[slot].items, footpath_id);
+    if (root->slots[slot].items->logical_size == 0) {
+        qt_items_free(tree, root->slots[slot].items);
+        qt_leaf_remove(tree, root, slot);
+    }
+
+    // STEP 5: MERGE the ancestors back into leaves from the BOTTOM up, until
+    //         one still has too many points (so all above it do too)
+    while ((ancestor_count > 0) 
+        && qt_can_coalesce(tree, ancestors[ancestor_count - 1])) {
+        qt_node_t *grey = ancestors[--ancestor_count];
+
+        // NOTE: merging hands the children's slots back, so copy them 1st
+        for (int q = 0; shared && (q < QUADRANTS); q++) {
+            if (grey->children[q].color == BLACK) {
+                qt_cow_own_slots(tree, &grey->children[q]);
+            }
+        }
+        qt_coalesce(tree, grey);
+    }
+    return SUCCESSFUL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       MOVES DATA from one 2D point to another (i.e. an UPDATE)
+ * @param[out]  tree        The quad-tree to update
+ * @param[in]   old_point   The point the data was inserted at
+ * @param[in]   new_point   The point to move the data to (it is COPIED)
+ * @param[in]   data        The DATA to move (matched by it's footpath_id)
+ * @return      An integer flag where: 0 means the data was NOT at old_point
+ *              or new_point is out of bounds (the tree is UNCHANGED) & 1 
+ *              means SUCCESSFUL movement
+*/
+int 
+qt_move(qt_tree_t *tree, point_2d_t *old_point, point_2d_t *new_point,
+    record_ref_t data) {
+
+    // NOTE: the new point is checked 1st so a failed move changes NOTHING
+    assert((tree != NULL) && (tree->linear == NULL));
+    if (! rectangle_contains(tree->bounds, *new_point)) {
+        return UNSUCCESSFUL;
+    }
+
+    // CASE 1: Readers may be inside, so publish BOTH halves of the move as
+    //         ONE version (i.e. the data is NEVER seen at neither point),
+    //         unless the data is NOT at old_point (so NOTHING is published)
+    if (tree->epoch != NULL) {
+        if (! qt_holds(tree, old_point, data.foothpath_id)) {
+            return UNSUCCESSFUL;
+        }
+        qt_node_t *root = qt_cow_begin(tree);
+        int integer_flag = qt_subtree_remove(tree, root, &tree->bounds, 
+            old_point, data.foothpath_id) && qt_subtree_insert(tree, root, 
+            &tree->bounds, 0, new_point, data);
+        qt_cow_publish(tree, root);
+        return integer_flag;
+    }
+
+    // CASE 2: Otherwise update the nodes in place
+    if (! qt_remove(tree, old_point, data.foothpath_id)) {
+        return UNSUCCESSFUL;
+    }
+    return qt_insert(tree, new_point, data);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       BULK LOADS many 2D points into an EMPTY quad-tree in ONE pass
+ * @param[out]  tree    The EMPTY quad-tree to build
+ * @param[in]   points  The points to insert (they are COPIED)
+ * @param[in]   data    The DATA associated with each POINT (i.e. data[i] 
+ *                      belongs to points[i])
+ * @param[in]   n       The number of points
+ * @return      An integer flag where: 0 means at least ONE point lay outside
+ *              the root's bounds & 1 means ALL points were inserted
+ * @note        Builds the SAME tree (shape, paths & item order) as calling 
+ *              qt_insert() on points[0], points[1], ... in turn
+*/
+int 
+qt_bulk_load(qt_tree_t *tree, point_2d_t *points, record_ref_t *data, 
+    int n) {
+
+    // STEP 1: Bulk loading is only defined for an EMPTY quad-tree
+    assert((tree != NULL) && (tree->linear == NULL) 
+        && (tree->root->color == WHITE));
+    rectangle_t *bounds = &tree->bounds;
+
+    // STEP 2: Key every point that lies within the root's bounds
+    morton_entry_t *entries = (morton_entry_t *)malloc(
+        sizeof(morton_entry_t) * (n > 0 ? n : 1));
+    morton_entry_t *scratch = (morton_entry_t *)malloc(
+        sizeof(morton_entry_t) * (n > 0 ? n : 1));
+    assert((entries != NULL) && (scratch != NULL));
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        if (rectangle_contains(*bounds, points[i])) {
+            entries[count].key = morton_encode(bounds, points[i]);
+            entries[count++].index = i;
         }
     }
 
-    // STEP 4: We have to traverse to the next valid node (i.e. GREY)
-    if (root->color == GREY) {
+    // STEP 3: Sort in Z-order so every subtree is a CONTIGUOUS run of entries
+    morton_sort(entries, count);
+
+    // STEP 4: Build the quad-tree top-down WITHOUT re-descending from the root
+    qt_bulk_build(tree, tree->root, bounds, 0, points, data, entries, scratch, 
+        count);
+    free(entries);
+    free(scratch);
+    return (count == n) ? SUCCESSFUL : UNSUCCESSFUL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - BUILDS a subtree from a run of Z-ordered entries,
+ *              ITERATIVELY via an explicit stack of the subtrees left to build
+ * @param[out]  tree    The quad-tree being built
+ * @param[out]  root    The (WHITE) root of the subtree to build
+ * @param[in]   bounds  The bounds of root
+ * @param[in]   depth   The depth of root
+ * @param[in]   points  ALL the points being loaded
+ * @param[in]   data    The DATA associated with each point
+ * @param[out]  entries The entries that fall within root's bounds
+ * @param[out]  scratch A buffer at least as long as 'entries'
+ * @param[in]   n       The number of entries
+ * @note        Children are built in quadrant order, as a recursive build 
+ *              would (so nodes are allocated in the SAME order)
+*/
+void 
+qt_bulk_build(qt_tree_t *tree, qt_node_t *root, rectangle_t *bounds, 
+    int depth, point_2d_t *points, record_ref_t *data, 
+    morton_entry_t *entries, morton_entry_t *scratch, int n) {
+
+    qt_build_frame_t stack[QT_STACK_FRAMES];
+    int top = 0;
+    stack[top].node = root;
+    stack[top].bounds = *bounds;
+    stack[top].depth = depth;
+    stack[top].offset = 0;
+    stack[top++].count = n;
+    while (top > 0) {
+        qt_build_frame_t frame = stack[--top];
+        morton_entry_t *run = entries + frame.offset;
+        morton_entry_t *buffer = scratch + frame.offset;
+        int count = frame.count;
+
+        // STEP 1: No points means the node stays EMPTY (i.e. WHITE)
+        if (count == 0) continue;
+
+        // STEP 2: Count the DISTINCT points (up to 1 more than a leaf can 
+        //         hold), starting from the EARLIEST as incremental insertion 
+        //         would
+        int first = 0;
+        for (int i = 1; i < count; i++) {
+            if (run[i].index < run[first].index) first = i;
+        }
+        int distinct = 0;
+        buffer[distinct++] = run[first];
+        for (int i = 0; (i < count) && (distinct <= tree->leaf_capacity); 
+            i++) {
+            point_2d_t *point = &points[run[i].index];
+            int seen = 0;
+            for (int j = 0; (j < distinct) && (! seen); j++) {
+                seen = equal_point_2d(points[buffer[j].index], *point);
+            }
+            if (! seen) buffer[distinct++] = run[i];
+        }
+
+        // CASE 2A: The points fit in ONE leaf (i.e. BLACK)
+        if ((distinct <= tree->leaf_capacity) 
+            || (frame.depth >= qt_depth_limit(tree))) {
+            qt_bulk_leaf(tree, frame.node, points, data, run, count);
+            continue;
+        }
+
+        // CASE 2B: Points DIFFER so the node must be INTERNAL (i.e. GREY)
+        frame.node->color = GREY;
+        qt_subdivide(tree, frame.node);
 
-        // STEP 4A: Determine which quadrant to traverse to
-        int child_flag = qt_determine_quadrant(root, point);
+        // STEP 3: Count the entries per quadrant (using the EXACT bounds 
+        //         test) & check that the Z-order already groups them
+        rectangle_t children[QUADRANTS];
+        for (int q = 0; q < QUADRANTS; q++) {
+            children[q] = qt_child_bounds(&frame.bounds, q);
+        }
+        int counts[QUADRANTS] = {0};
+        int grouped = 1, previous = NW;
+        for (int i = 0; i < count; i++) {
+            int child_flag = qt_pick_quadrant(children, &points[run[i].index]);
+            if (child_flag < previous) grouped = 0;
+            previous = child_flag;
+            counts[child_flag]++;
+        }
 
-        // STEP 4B: traverse the the next node
-        if (child_flag == NW) {
-            return qt_recursive_insert(tree, root->nw, point, data);
+        // EXCEPTION: a point within rounding of an edge was keyed to the 
+        //            wrong side, so STABLY regroup the entries by quadrant
+        int offsets[QUADRANTS] = {0};
+        for (int q = 1; q < QUADRANTS; q++) {
+            offsets[q] = offsets[q - 1] + counts[q - 1];
         }
-        if (child_flag == NE) {
-            return qt_recursive_insert(tree, root->ne, point, data);
+        if (! grouped) {
+            int next[QUADRANTS];
+            memcpy(next, offsets, sizeof(next));
+            for (int i = 0; i < count; i++) {
+                int child_flag = qt_pick_quadrant(children, 
+                    &points[run[i].index]);
+                buffer[next[child_flag]++] = run[i];
+            }
+            memcpy(run, buffer, sizeof(morton_entry_t) * count);
         }
-        if (child_flag == SW) {
-            return qt_recursive_insert(tree, root->sw, point, data);
+
+        // STEP 4: Stack each child with it's own run of entries, LAST first
+        //         so they are built in quadrant order
+        for (int q = QUADRANTS - 1; q >= 0; q--) {
+            assert(top < QT_STACK_FRAMES);
+            stack[top].node = &frame.node->children[q];
+            stack[top].bounds = children[q];
+            stack[top].depth = frame.depth + 1;
+            stack[top].offset = frame.offset + offsets[q];
+            stack[top++].count = counts[q];
         }
-        if (child_flag == SE) {
-            return qt_recursive_insert(tree, root->se, point, data);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - FILLS a BLACK leaf with a run of points
+ * @param[out]  tree    The quad-tree being built
+ * @param[out]  root    The (WHITE) node to turn BLACK
+ * @param[in]   points  ALL the points being loaded
+ * @param[in]   data    The DATA associated with each point
+ * @param[out]  entries The entries whose points belong in the leaf
+ * @param[in]   n       The number of entries
+*/
+void 
+qt_bulk_leaf(qt_tree_t *tree, qt_node_t *root, point_2d_t *points, 
+    record_ref_t *data, morton_entry_t *entries, int n) {
+
+    // STEP 1: Restore input order so items are appended as qt_insert() would
+    if (n > 1) {
+        qsort(entries, n, sizeof(morton_entry_t), qt_cmp_entry_index);
+    }
+
+    // STEP 2: The EARLIEST of several EQUAL points is the one that is kept
+    for (int i = 0; i < n; i++) {
+        point_2d_t *point = &points[entries[i].index];
+        int slot = (root->color == BLACK) ? qt_leaf_find(root, point) : -1;
+        if (slot < 0) {
+            qt_leaf_add(tree, root, point, qt_items_init(tree));
+            slot = root->point_count - 1;
         }
+        qt_items_add(tree, root->slots[slot].items, data[entries[i].index]);
     }
-    exit(EXIT_FAILURE);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - COMPARES Morton entries by their input index
+ * @param[in]   e1  A pointer to the 1st morton_entry_t
+ * @param[in]   e2  A pointer to the 2nd morton_entry_t
+ * @return      -1, 0 or 1 as for cmp_int()
+*/
+int 
+qt_cmp_entry_index(const void *e1, const void *e2) {
+    return cmp_int(((const morton_entry_t *)e1)->index, 
+        ((const morton_entry_t *)e2)->index);
 }
 
 /* -------------------------------------------------------------------------- */
@@ -170,49 +632,186 @@ qt_recursive_insert(qt_tree_t *tree,
  * @brief       SEARCHES a quad-tree for a xy-point
  * @param[in]   tree    The quad-tree to be queried
  * @param[in]   point   The point to find in the quad-tree
- * @return      A pointer to a qt_node_t containing the point, & NULL otherwise
- * @note        Also PRINTS the path to STDOUT
+ * @param[out]  path    The path of the point (& NULL to skip tracking it)
+ * @return      A pointer to the items stored at the point, & NULL otherwise
 */
-qt_node_t* 
-qt_search(qt_tree_t *tree, point_2d_t *point, char *path) {
+array_t* 
+qt_search(qt_tree_t *tree, point_2d_t *point, path_t *path) {
     
     qt_node_t *search = tree->root;
+    rectangle_t bounds = tree->bounds;
     int child_flag;
+    stats_query_begin();
+
+    // EXCEPTION: the LINEAR backend answers the query instead
+    if (tree->linear != NULL) {
+        array_t *found = lqt_search(tree->linear, point, path, 
+            &tree->linear->found);
+        stats_query_end(STATS_POINT);
+        return found;
+    }
 
     // STEP 1: Check if the point lies in the boundary
-    if (! rectangle_contains(tree->root->bounds, *point)) {
+    if (! rectangle_contains(bounds, *point)) {
+        stats_query_end(STATS_POINT);
         return NULL;
     }
 
     // STEP 2: Keep travsering the quad-tree
+    STATS_COUNT(nodes_visited, 1);
     while (search->color == GREY) {
         
-        // STEP 3: Need to figure out which quadrant to traverse
-        child_flag = qt_determine_quadrant(search, point);
+        // STEP 3: Need to figure out which quadrant (& bounds) to traverse
+        child_flag = qt_determine_quadrant(&bounds, point, &bounds);
 
         // STEP 4: Traverse to the appropriate quadrant
-        if (child_flag == NW) {
-            strcat(path, APPEND_NW);
-            search = search->nw;
+        qt_path_append(path, child_flag);
+        search = &search->children[child_flag];
+        STATS_COUNT(nodes_visited, 1);
+    }
+
+    // STEP 5: Check if the leaf holds an equivalent point
+    int slot;
+    stats_query_end(STATS_POINT);
+    if ((search->color == BLACK) && ((slot = qt_leaf_find(search, point)) >= 0)) {
+        return search->slots[slot].items;
+    }
+    return NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       SEARCHES a quad-tree for a BATCH of xy-points, answering them
+ *              in Morton order so consecutive searches share their descents
+ * @param[in]   tree    The quad-tree to be queried
+ * @param[in]   points  The points to find in the quad-tree
+ * @param[in]   n       The number of points
+ * @param[out]  results The items stored at each point (as a heap-allocated
+ *                      COPY), & NULL where qt_search() would return NULL
+ * @param[out]  paths   The (heap-allocated) path of each point, & NULL to
+ *                      skip tracking them
+ * @note        results & paths are filled in the SAME order as points
+ * @note        Batches may be searched on SEVERAL threads at once (as long as
+ *              NO points are inserted meanwhile)
+*/
+void 
+qt_search_batch(qt_tree_t *tree, point_2d_t *points, int n,
+    array_t **results, path_t **paths) {
+
+    // STEP 1: Order the points along the Z-order curve
+    morton_entry_t *entries = qt_batch_order(tree, points, NULL, n);
+    path_t *path = (paths != NULL) ? path_init() : NULL;
+    int capacity = QT_INIT_FINGERS;
+    qt_finger_t *fingers = (qt_finger_t *)malloc(
+        sizeof(qt_finger_t) * capacity);
+    assert(fingers != NULL);
+
+    // STEP 2: Every descent starts at the root
+    fingers[0].node = tree->root;
+    fingers[0].bounds = tree->bounds;
+    int depth = 0;
+
+    // STEP 3: Answer the points in that order (the LINEAR backend has no 
+    //         nodes to resume from, but still benefits from the locality)
+    array_t view;
+    for (int i = 0; i < n; i++) {
+        int query = entries[i].index;
+        array_t *items;
+        stats_query_begin();
+        if (tree->linear != NULL) {
+            if (path != NULL) path_truncate(path, 0);
+            items = lqt_search(tree->linear, &points[query], path, &view);
+        } else {
+            items = qt_finger_search(tree, &points[query], path, &fingers, 
+                &capacity, &depth);
         }
-        if (child_flag == NE) {
-            strcat(path, APPEND_NE);
-            search = search->ne;
+        stats_query_end(STATS_POINT);
+        results[query] = qt_copy_items(items);
+        if (paths != NULL) paths[query] = path_copy(path);
+    }
+    free(entries);
+    free(fingers);
+    if (path != NULL) path_free(path);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - SEARCHES for a xy-point by RESUMING the descent 
+ *              of the previous search from the deepest node both share
+ * @param[in]   tree        The quad-tree to be queried
+ * @param[in]   point       The point to find in the quad-tree
+ * @param[out]  path        The path of the PREVIOUS point (which becomes the
+ *                          path of this one), & NULL if NOT tracked
+ * @param[out]  fingers     The nodes on the previous descent (which become
+ *                          the nodes on this one)
+ * @param[out]  capacity    The number of fingers there is room for
+ * @param[out]  depth       The depth the previous descent reached
+ * @return      A pointer to the items stored at the point, & NULL otherwise
+*/
+array_t* 
+qt_finger_search(qt_tree_t *tree, point_2d_t *point, path_t *path, 
+    qt_finger_t **fingers, int *capacity, int *depth) {
+
+    // STEP 1: Check if the point lies in the boundary (if not, the next 
+    //         search starts afresh from the root)
+    if (! rectangle_contains(tree->bounds, *point)) {
+        if (path != NULL) path_truncate(path, 0);
+        *depth = 0;
+        return NULL;
+    }
+
+    // STEP 2: Keep the descents the previous point ALSO took, testing only
+    //         the child bounds remembered by the fingers (NOT the nodes), in
+    //         the same order as qt_determine_quadrant()
+    int d = 0;
+    while (d < *depth) {
+        qt_finger_t *finger = &(*fingers)[d];
+        int child_flag = 0;
+        while ((child_flag < QUADRANTS) 
+            && (! rectangle_contains(finger->children[child_flag], *point))) {
+            child_flag++;
         }
-        if (child_flag == SW) {
-            strcat(path, APPEND_SW);
-            search = search->sw;
+        if (child_flag != finger->quadrant) break;
+        d++;
+    }
+    qt_node_t *search = (*fingers)[d].node;
+    if (path != NULL) path_truncate(path, d);
+    STATS_COUNT(nodes_visited, 1);
+
+    // STEP 3: Descend the rest of the way, remembering each node reached
+    while (search->color == GREY) {
+        qt_finger_t *finger = &(*fingers)[d];
+        finger->quadrant = -1;
+        for (int q = 0; q < QUADRANTS; q++) {
+            finger->children[q] = qt_child_bounds(&finger->bounds, q);
+            if ((finger->quadrant < 0) 
+                && rectangle_contains(finger->children[q], *point)) {
+                finger->quadrant = q;
+            }
         }
-        if (child_flag == SE) {
-            strcat(path, APPEND_SE);
-            search = search->se;
+        assert(finger->quadrant >= 0);
+        qt_path_append(path, finger->quadrant);
+        search = &search->children[finger->quadrant];
+        STATS_COUNT(nodes_visited, 1);
+        if (++d == *capacity) {
+            *capacity *= REALLOC_FACTOR;
+            *fingers = (qt_finger_t *)realloc(*fingers, 
+                sizeof(qt_finger_t) * (*capacity));
+            assert(*fingers != NULL);
+            finger = &(*fingers)[d - 1];
         }
+        (*fingers)[d].node = search;
+        (*fingers)[d].bounds = finger->children[finger->quadrant];
     }
+    *depth = d;
 
-    // STEP 5: Check if the points are equivalent:
+    // STEP 4: Check if the leaf holds an equivalent point
+    int slot;
     if ((search->color == BLACK) 
-        && (equal_point_2d(*search->point, *point))) {
-        return search;
+        && ((slot = qt_leaf_find(search, point)) >= 0)) {
+        return search->slots[slot].items;
     }
     return NULL;
 }
@@ -220,224 +819,1403 @@ qt_search(qt_tree_t *tree, point_2d_t *point, char *path) {
 /* -------------------------------------------------------------------------- */
 
 /**
- * @brief       FINDS all the points within a bounded RANGE
+ * @brief       FINDS all the points within a BATCH of ranges in ONE shared
+ *              traversal, so each node is visited ONCE for every range that
+ *              reaches it (rather than once per range)
  * @param[in]   tree    The quad-tree to query
- * @param[in]   path    A string of all the directions traversed in the search
- * @param[in]   range   The bounded rectangle that defines a range
- * @return      A pointer of type array_t with the matched query data
+ * @param[in]   ranges  The bounded rectangles that define each range
+ * @param[in]   n       The number of ranges
+ * @param[out]  results The matches of each range (as qt_range_query() 
+ *                      returns them)
+ * @param[out]  paths   The (heap-allocated) path of each range, & NULL to
+ *                      skip tracking them
+ * @note        results & paths are filled in the SAME order as ranges
+ * @note        Batches may be queried on SEVERAL threads at once (as long as
+ *              NO points are inserted meanwhile)
 */
-array_t* 
-qt_range_query(qt_tree_t *tree, char *path, rectangle_t *range) {
-
-    // STEP 1: Initialises the container to store the matches
-    assert(tree != NULL);
-    array_t *matches = array_init();
+void 
+qt_range_query_batch(qt_tree_t *tree, rectangle_t *ranges, int n,
+    array_t **results, path_t **paths) {
+
+    // EXCEPTION: the LINEAR backend answers the ranges one at a time (in the
+    //            Morton order of their centres, de-duplicating with a bitmap
+    //            of this batch's OWN, rather than the tree's)
+    if (tree->linear != NULL) {
+        morton_entry_t *entries = qt_batch_order(tree, NULL, ranges, n);
+        bitmap_t *seen = bitmap_init();
+        for (int i = 0; i < n; i++) {
+            int query = entries[i].index;
+            path_t *path = (paths != NULL) ? path_init() : NULL;
+            results[query] = qt_range_collect(tree, path, &ranges[query], 
+                seen);
+            if (paths != NULL) paths[query] = path;
+        }
+        bitmap_free(seen);
+        free(entries);
+        return;
+    }
 
-    // STEP 2: Recursively search for the points in the quad-tree
-    if (tree->root) {
-        qt_recursive_range_query(tree->root, path, range, matches);
+    // STEP 1: Start EVERY range with NO matches & an EMPTY path
+    for (int i = 0; i < n; i++) {
+        results[i] = array_init();
+        if (paths != NULL) paths[i] = path_init();
     }
 
-    // STEP 3: Ensure that the matches has entries
-    if (! matches->logical_size) {
-        return NULL;
+    // STEP 2: Descend ONCE, splitting the ranges among the children
+    stats_query_begin();
+    qt_subtree_range_batch(tree->root, &tree->bounds, ranges, n, results, 
+        paths);
+
+    // STEP 3: Sort & de-duplicate each range's matches (NOTE: the nodes the
+    //         batch visited are counted ONCE, under it's 1st range)
+    for (int i = 0; i < n; i++) {
+        stats_query_end(STATS_RANGE);
+        results[i] = qt_finish_matches(results[i], NULL);
     }
-    return matches;
 }
 
 /* -------------------------------------------------------------------------- */
 
 /**
- * @brief       AUXILLARY - RECURSIVELY finds all the points within a range
- * @param[in]   root    The current subtree's root to find matching points
- * @param[in]   path    A string of all the directions traversed in the search
- * @param[in]   range   The bounded rectangle that defines a range
- * @param[in]   matches A pointer to all the matches
+ * @brief       AUXILLARY - FINDS all the points within a BATCH of ranges in a
+ *              subtree, ITERATIVELY visiting each node ONCE with the ranges
+ *              that reach it
+ * @param[in]   root    The root node of the subtree
+ * @param[in]   bounds  The bounds of root
+ * @param[in]   ranges  The bounded rectangles that define each range
+ * @param[in]   n       The number of ranges
+ * @param[out]  results The (unsorted) matches of each range so far
+ * @param[out]  paths   The path of each range, & NULL to skip tracking them
+ * @note        Each range visits the SAME nodes (in the SAME order) as 
+ *              qt_subtree_range_query() would, so it's path is identical
 */
 void 
-qt_recursive_range_query(qt_node_t *root, char *path, rectangle_t *range, 
-    array_t *matches) {
-
-    // STEP 1: Check if this root's boundary intersects with query range
-    if (! rectangle_intersect(&root->bounds, range)) {
+qt_subtree_range_batch(qt_node_t *root, rectangle_t *bounds, 
+    rectangle_t *ranges, int n, array_t **results, path_t **paths) {
+
+    // STEP 1: Stack the ranges reaching root (each node's ranges sit on a 
+    //         stack of range indices ABOVE those of the nodes stacked before
+    //         it, so popping a node frees everything above it's ranges)
+    int capacity = QUADRANTS * (n > 0 ? n : 1);
+    int *active = (int *)malloc(sizeof(int) * capacity);
+    assert(active != NULL);
+    int used = 0;
+    for (int i = 0; i < n; i++) {
+        if (rectangle_intersect(bounds, &ranges[i])) active[used++] = i;
+    }
+    if (used == 0) {
+        free(active);
         return;
     }
+    qt_batch_frame_t stack[QT_STACK_FRAMES];
+    int top = 0;
+    stack[top].node = root;
+    stack[top].bounds = *bounds;
+    stack[top].quadrant = -1;
+    stack[top].first = 0;
+    stack[top++].count = used;
+
+    // STEP 2: Visit the nodes in depth-first order
+    int order[QUADRANTS] = {SW, NW, NE, SE};
+    while (top > 0) {
+        qt_batch_frame_t frame = stack[--top];
+        qt_node_t *node = frame.node;
+        used = frame.first + frame.count;
+        STATS_COUNT(nodes_visited, 1);
+        for (int r = frame.first; (paths != NULL) && (frame.quadrant >= 0) 
+            && (r < used); r++) {
+            path_append(paths[active[r]], frame.quadrant);
+        }
+
+        // STEP 3: Check which ranges the points at this node lie within
+        for (int i = 0; (node->color == BLACK) && (i < node->point_count); 
+            i++) {
+            for (int r = frame.first; r < used; r++) {
+                if (rectangle_contains(ranges[active[r]], 
+                    node->slots[i].point)) {
+                    qt_visitor_t visitor = {qt_append_match, 
+                        results[active[r]], NULL};
+                    qt_collect_items(&visitor, node->slots[i].items);
+                }
+            }
+        }
 
-    // STEP 2: Check if the points at this current root lie within the range
-    if ((root->color == BLACK) && (rectangle_contains(*range, *root->point))) {
-        for (int i = 0; i < root->items->logical_size; i++) {
+        // STEP 4: Stop here if we have reached a LEAF node
+        if (node->color != GREY) {
+            continue;
+        }
 
-            // NOTE: we do NOT add DUPLICATE values
-            if (array_binary_search(matches, 
-                get_foothpath_id(root->items->data[i])) == NULL) {
-                array_sort_append(matches, root->items->data[i]);
+        // STEP 5: Otherwise stack ONLY the non-EMPTY children some range
+        //         reaches (with just those ranges), LAST first so they are
+        //         visited in order
+        for (int i = QUADRANTS - 1; i >= 0; i--) {
+            qt_node_t *child = &node->children[order[i]];
+            if (child->color == WHITE) continue;
+
+            rectangle_t child_bounds = qt_child_bounds(&frame.bounds, 
+                order[i]);
+            if (used + frame.count > capacity) {
+                capacity = (used + frame.count) * REALLOC_FACTOR;
+                active = (int *)realloc(active, sizeof(int) * capacity);
+                assert(active != NULL);
+            }
+            int first = used;
+            for (int r = frame.first; r < frame.first + frame.count; r++) {
+                if (rectangle_intersect(&child_bounds, &ranges[active[r]])) {
+                    active[used++] = active[r];
+                }
+            }
+            if (used > first) {
+                assert(top < QT_STACK_FRAMES);
+                stack[top].node = child;
+                stack[top].bounds = child_bounds;
+                stack[top].quadrant = order[i];
+                stack[top].first = first;
+                stack[top++].count = used - first;
             }
         }
     }
+    free(active);
+}
 
-    // STEP 4: Stop here if we have reached a LEAF node
-    if (root->color != GREY) {
-        return;
-    }
+/* -------------------------------------------------------------------------- */
 
-    // STEP 5: Otherwise traverse to ONLY BLACK nodes
-    if ((root->sw->color != WHITE) 
-        && rectangle_intersect(&root->sw->bounds, range)) {
-        strcat(path, APPEND_SW);
-        qt_recursive_range_query(root->sw, path, range, matches);
-    }
-    if ((root->nw->color != WHITE) 
-        && rectangle_intersect(&root->nw->bounds, range)) {
-        strcat(path, APPEND_NW);
-        qt_recursive_range_query(root->nw, path, range, matches);
-    }
-    if ((root->ne->color != WHITE) 
-        && rectangle_intersect(&root->ne->bounds, range)) {
-        strcat(path, APPEND_NE);
-        qt_recursive_range_query(root->ne, path, range, matches);
-    }
-    if ((root->se->color != WHITE) 
-        && rectangle_intersect(&root->se->bounds, range)) {
-        strcat(path, APPEND_SE);
-        qt_recursive_range_query(root->se, path, range, matches);
+/**
+ * @brief       AUXILLARY - ORDERS a batch of queries along the Z-order curve
+ * @param[in]   tree    The quad-tree to be queried
+ * @param[in]   points  The points of a point batch, & NULL otherwise
+ * @param[in]   ranges  The ranges of a range batch (ordered by their centre),
+ *                      & NULL otherwise
+ * @param[in]   n       The number of queries
+ * @return      A heap-allocated array of the query indices, SORTED by key
+*/
+morton_entry_t* 
+qt_batch_order(qt_tree_t *tree, point_2d_t *points, rectangle_t *ranges, 
+    int n) {
+    morton_entry_t *entries = (morton_entry_t *)malloc(
+        sizeof(morton_entry_t) * (n > 0 ? n : 1));
+    assert(entries != NULL);
+    for (int i = 0; i < n; i++) {
+        entries[i].key = morton_encode(&tree->bounds, 
+            (points != NULL) ? points[i] : ranges[i].ctr);
+        entries[i].index = i;
     }
-    return;
-}   
+    morton_sort(entries, n);
+    return entries;
+}
 
 /* -------------------------------------------------------------------------- */
 
 /**
- * @brief       FREES a quad-tree INTERFACE from the heap
- * @param[out]  tree    The quad-tree to free
+ * @brief       AUXILLARY - COPIES the items found at a point
+ * @param[in]   items   The items (as qt_search() returns them), or NULL
+ * @return      A heap-allocated copy of items, & NULL if items is NULL
 */
-void 
-qt_free(qt_tree_t *tree) {
-
-    // Free ALL the tree's nodes & finally the tree itself
-    if (tree->root != NULL) qt_recursive_free(tree, tree->root);
-    free(tree);
+array_t* 
+qt_copy_items(array_t *items) {
+    if (items == NULL) {
+        return NULL;
+    }
+    array_t *copy = array_init();
+    for (int i = 0; i < items->logical_size; i++) {
+        array_append(copy, items->data[i]);
+    }
+    return copy;
 }
 
 /* -------------------------------------------------------------------------- */
 
 /**
- * @brief       AUXILLARY - RECUSIVELY FREES a quad-tree NODE from the heap
- * @param[out]  tree    The quad-tree to free
- * @param[out]  root    The current root of a subtree to free
+ * @brief       CONVERTS a built quad-tree to the LINEAR backend
+ * @param[out]  tree    The quad-tree whose nodes are replaced
+ * @return      An integer flag where: 0 means the quad-tree was too DEEP to
+ *              be linearised (& is left untouched) & 1 means SUCCESSFUL
+ * @note        Queries keep working through qt_search() & qt_range_query(),
+ *              but NO further points may be inserted
 */
-void 
-qt_recursive_free(qt_tree_t *tree, qt_node_t *root) {
-    
-    // STEP 1: Free any heap-allocated components
-    if (root->point != NULL) free(root->point);
-    //if (root->items != NULL) array_free(root->items);
+int 
+qt_linearise(qt_tree_t *tree) {
 
-    // STEP 2: Traverse to existing child nodes to free them too
-    if (root->nw != NULL) {
-        qt_recursive_free(tree, root->nw);
-        qt_recursive_free(tree, root->ne);
-        qt_recursive_free(tree, root->sw);
-        qt_recursive_free(tree, root->se);
+    // STEP 1: Flatten the leaves into a sorted Morton-key array
+    assert((tree != NULL) && (tree->linear == NULL) && (tree->epoch == NULL));
+    lqt_t *linear = lqt_build(tree->root, &tree->bounds);
+    if (linear == NULL) {
+        return UNSUCCESSFUL;
     }
 
-    // STEP 3: Free the node itself
-    free(root);
+    // STEP 2: The nodes are no longer needed to answer queries
+    qt_free_nodes(tree);
+    tree->linear = linear;
+    return SUCCESSFUL;
 }
 
 /* -------------------------------------------------------------------------- */
 
 /**
- * @brief       AUXILLARY - SUBDIVIDES a quad-tree's node into more children
- * @param[out]  tree    The quad-tree where node subdivision occurs
- * @param[out]  root    The root of a subtree that will have 4 new children
+ * @brief       FINDS all the points within a bounded RANGE
+ * @param[in]   tree    The quad-tree to query
+ * @param[in]   path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   range   The bounded rectangle that defines a range
+ * @return      A pointer of type array_t with the matched query data
 */
-void 
-qt_subdivide(qt_tree_t *tree, qt_node_t *root) {
-
-    long double ctr_x = root->bounds.ctr.x;
-    long double ctr_y = root->bounds.ctr.y;
-    long double hw = root->bounds.hw;
-    long double hh = root->bounds.hh;
+array_t* 
+qt_range_query(qt_tree_t *tree, path_t *path, rectangle_t *range) {
+    assert(tree != NULL);
+    bitmap_t *seen = qt_seen_acquire(tree);
+    array_t *matches = qt_range_collect(tree, path, range, seen);
+    qt_seen_release(tree, seen);
+    return matches;
+}
 
-    // Initialising the NORTH-WEST node
-    point_2d_t nw_bl = point_2d_init(ctr_x - hw, ctr_y);
-    point_2d_t nw_tr = point_2d_init(ctr_x, ctr_y + hh);
-    rectangle_t nw_bounds = rectangle_init(nw_bl, nw_tr);
-    root->nw = qt_node_init(tree, nw_bounds);
+/* -------------------------------------------------------------------------- */
 
-    // Initialising the NORTH-EAST node
-    point_2d_t ne_bl = point_2d_init(ctr_x, ctr_y);
-    point_2d_t ne_tr = point_2d_init(ctr_x + hw, ctr_y + hh);
-    rectangle_t ne_bounds = rectangle_init(ne_bl, ne_tr);
-    root->ne = qt_node_init(tree, ne_bounds);
+/**
+ * @brief       AUXILLARY - FINDS all the points within a bounded RANGE using
+ *              the caller's seen-set
+ * @param[in]   tree    The quad-tree to query
+ * @param[in]   path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   range   The bounded rectangle that defines a range
+ * @param[out]  seen    An EMPTY bitmap (left empty upon returning)
+ * @return      A pointer of type array_t with the matched query data
+*/
+array_t* 
+qt_range_collect(qt_tree_t *tree, path_t *path, rectangle_t *range,
+    bitmap_t *seen) {
 
-    // Initialising the SOUTH-WEST node
-    point_2d_t sw_bl = point_2d_init(ctr_x - hw, ctr_y - hh);
-    point_2d_t sw_tr = point_2d_init(ctr_x, ctr_y);
-    rectangle_t sw_bounds = rectangle_init(sw_bl, sw_tr);
-    root->sw = qt_node_init(tree, sw_bounds);
+    // STEP 1: Initialises the container to store the matches
+    array_t *matches = array_init();
+    qt_visitor_t visitor = {qt_append_match, matches, seen};
+    stats_query_begin();
+
+    // STEP 2: Recursively search for the points in the quad-tree (or the 
+    //         LINEAR backend if it has replaced the nodes)
+    // NOTE: the root is loaded ONCE, as a concurrent writer may publish a
+    //       new one between 2 loads
+    qt_node_t *root = tree->root;
+    if (tree->linear != NULL) {
+        lqt_range_query(tree->linear, path, range, &visitor);
+    } else if (root != NULL) {
+        qt_subtree_range_query(root, &tree->bounds, path, range, &visitor);
+    }
 
-    // Initialising the SOUTH-EAST node
-    point_2d_t se_bl = point_2d_init(ctr_x, ctr_y - hh);
-    point_2d_t se_tr = point_2d_init(ctr_x + hw, ctr_y);
-    rectangle_t se_bounds = rectangle_init(se_bl, se_tr);
-    root->se = qt_node_init(tree, se_bounds);
+    // STEP 3: Sort the matches & empty the seen records
+    stats_query_end(STATS_RANGE);
+    return qt_finish_matches(matches, seen);
 }
 
 /* -------------------------------------------------------------------------- */
 
 /**
- * @brief       AUXILLARY - DETERMINES which quadrant a point belongs to
- * @param[in]   root    The current node at the traversal
- * @param[in]   point   The point we try to determine where it belongs
- * @return      An INTEGER FLAG where: 0 indicates NW node, 1 indicates NE
- *              node, 2 indicates SW node & 3 indicates the SE node
+ * @brief       AUXILLARY - FINISHES the matches collected by a range query
+ * @param[out]  matches The matches (in the order they were found)
+ * @param[out]  seen    The records matched (left empty upon returning), &
+ *                      NULL if matches were NOT de-duplicated as found
+ * @return      matches in footpath_id order, & NULL if there were none
 */
-int 
-qt_determine_quadrant(qt_node_t *root, point_2d_t *point) {
-    
-    // STEP 1: Need to ensure child nodes exist
-    assert((root->nw) && (root->ne) && (root->sw) && (root->se));
+array_t* 
+qt_finish_matches(array_t *matches, bitmap_t *seen) {
 
-    // STEP 2: Test the point with each subchild
-    if (rectangle_contains(root->nw->bounds, *point)) return NW;
-    if (rectangle_contains(root->ne->bounds, *point)) return NE;
-    if (rectangle_contains(root->sw->bounds, *point)) return SW;
-    if (rectangle_contains(root->se->bounds, *point)) return SE;
+    // STEP 1: Ensure that the matches has entries
+    if (! matches->logical_size) {
+        array_free(matches);
+        return NULL;
+    }
 
-    // EXCEPTION: does not belong in any bounds
-    exit(EXIT_FAILURE);
+    // STEP 2: Empty the seen records (for the next query) & put the matches
+    //         in footpath_id order, keeping the 1st record found of each
+    for (int i = 0; (seen != NULL) && (i < matches->logical_size); i++) {
+        bitmap_clear(seen, matches->data[i].record);
+    }
+    array_sort(matches);
+    array_unique(matches);
+    return matches;
 }
 
 /* -------------------------------------------------------------------------- */
 
 /**
- * @brief       AUXILLARY - REPAIRS a grey node by TRANSFERRING it's data into
- *              one of it's recently SUBDIVIDED child nodes.
- * @param[out]  root    The GREY root node to repair
+ * @brief       FINDS all the points within a CIRCLE (e.g. within 200 metres
+ *              of a point), pruning the quadrants it does NOT intersect
+ * @param[in]   tree    The quad-tree to query
+ * @param[out]  path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   circle  The circle that defines the range
+ * @return      A pointer of type array_t with the matched query data (as
+ *              qt_range_query() returns them), & NULL if nothing matched
 */
-void 
-qt_repair_internal(qt_node_t *root) {
-
-    // STEP 1: Ensure the root is an INTERNAL (i.e. GREY) node
-    assert(root->color == GREY);
+array_t* 
+qt_radius_query(qt_tree_t *tree, path_t *path, circle_t *circle) {
 
-    // STEP 2: Determine the new quadrant the grey nodes's point belongs to
-    int child_flag = qt_determine_quadrant(root, root->point);
+    // STEP 1: Initialises the container to store the matches
+    assert(tree != NULL);
+    array_t *matches = array_init();
+    bitmap_t *seen = qt_seen_acquire(tree);
+    qt_visitor_t visitor = {qt_append_match, matches, seen};
+    stats_query_begin();
+
+    // STEP 2: Recursively search the quad-tree (or it's LINEAR backend)
+    qt_node_t *root = tree->root;
+    if (tree->linear != NULL) {
+        lqt_radius_query(tree->linear, path, circle, &visitor);
+    } else if (root != NULL) {
+        qt_subtree_radius_query(root, &tree->bounds, path, circle, &visitor);
+    }
+    stats_query_end(STATS_RADIUS);
 
-    // STEP 3: Assign the node pointer to the appropriate child quadrant
-    qt_node_t *child = NULL;
-    if (child_flag == NW) child = root->nw;
-    if (child_flag == NE) child = root->ne;
-    if (child_flag == SW) child = root->sw;
-    if (child_flag == SE) child = root->se;
+    // STEP 3: Sort the matches & empty the seen records
+    matches = qt_finish_matches(matches, seen);
+    qt_seen_release(tree, seen);
+    return matches;
+}
 
-    // STEP 4: TRANSFER the points accordingly
-    child->color = BLACK;
-    child->point = root->point;
-    child->items = root->items;
+/* -------------------------------------------------------------------------- */
 
-    // STEP 5: Assign NULL values to grey node
-    root->point = NULL;
-    root->items = NULL;
+/**
+ * @brief       VISITS all the points within a bounded RANGE, WITHOUT
+ *              collecting them
+ * @param[in]   tree    The quad-tree to query
+ * @param[out]  path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   range   The bounded rectangle that defines a range
+ * @param[in]   visit   Called once per match, in the order they are found
+ *                      (i.e. NOT sorted by footpath_id)
+ * @param[in]   context Passed to every call of visit
+ * @param[in]   dedupe  1 to visit each record ONCE, & 0 to visit it once
+ *                      per endpoint within the range
+*/
+void 
+qt_range_visit(qt_tree_t *tree, path_t *path, rectangle_t *range,
+    qt_visit_t visit, void *context, int dedupe) {
+
+    // STEP 1: Send the matches straight to the caller's callback
+    assert((tree != NULL) && (visit != NULL));
+    bitmap_t *seen = dedupe ? qt_seen_acquire(tree) : NULL;
+    qt_visitor_t visitor = {visit, context, seen};
+    stats_query_begin();
+
+    // STEP 2: Traverse the quad-tree (or it's LINEAR backend)
+    qt_node_t *root = tree->root;
+    if (tree->linear != NULL) {
+        lqt_range_query(tree->linear, path, range, &visitor);
+    } else if (root != NULL) {
+        qt_subtree_range_query(root, &tree->bounds, path, range, &visitor);
+    }
+    stats_query_end(STATS_RANGE);
+
+    // STEP 3: The matches were NOT kept, so empty the seen records wholesale
+    if (dedupe) {
+        bitmap_reset(seen);
+        qt_seen_release(tree, seen);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FINDS the k records NEAREST to a point, by a BEST-FIRST search
+ *              expanding nodes in order of their distance from the point
+ * @param[in]   tree        The quad-tree to query
+ * @param[in]   point       The point whose neighbours are sought
+ * @param[in]   k           The number of records sought (at least 1)
+ * @param[in]   metric      Either DISTANCE_PLANAR or DISTANCE_HAVERSINE
+ * @param[out]  distances   Filled with the distance of each record (to it's 
+ *                          NEARER endpoint), & NULL if not wanted
+ * @return      A pointer of type array_t with up to k records, NEAREST 
+ *              first, & NULL if the quad-tree is EMPTY
+*/
+array_t* 
+qt_knn(qt_tree_t *tree, point_2d_t *point, int k, int metric,
+    long double *distances) {
+
+    // STEP 1: Initialise the search
+    assert((tree != NULL) && (k >= 1));
+    qt_knn_t knn = {*point, k, metric, array_init(), distances, 
+        qt_seen_acquire(tree)};
+    stats_query_begin();
+
+    // STEP 2: Search the LINEAR backend if it has replaced the nodes
+    if (tree->linear != NULL) {
+        lqt_knn(tree->linear, &knn);
+
+    // STEP 3: Otherwise pop the NEAREST node (or point) until k records are
+    //         matched, as a node is NEVER nearer than it's bounds
+    } else {
+        pq_t *queue = pq_init(sizeof(qt_knn_entry_t));
+        qt_knn_entry_t entry = {tree->root, tree->bounds, NULL};
+        pq_push(queue, rectangle_distance(&tree->bounds, *point, metric), 
+            &entry);
+        while ((queue->count > 0) && (knn.matches->logical_size < k)) {
+            long double distance = pq_pop(queue, &entry);
+            if (entry.node == NULL) {
+                qt_knn_collect(&knn, entry.items, distance);
+            } else {
+                qt_knn_expand(queue, &knn, &entry);
+            }
+        }
+        pq_free(queue);
+    }
+
+    // STEP 4: Empty the seen records (for the next query)
+    stats_query_end(STATS_KNN);
+    for (int i = 0; i < knn.matches->logical_size; i++) {
+        bitmap_clear(knn.seen, knn.matches->data[i].record);
+    }
+    qt_seen_release(tree, knn.seen);
+    if (! knn.matches->logical_size) {
+        array_free(knn.matches);
+        return NULL;
+    }
+    return knn.matches;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - EXPANDS a node popped by a k-nearest-neighbour 
+ *              search, queueing it's points (if BLACK) or it's non-EMPTY
+ *              children (if GREY)
+ * @param[out]  queue   The search's priority queue
+ * @param[in]   knn     The search
+ * @param[in]   entry   The popped node
+*/
+void 
+qt_knn_expand(pq_t *queue, qt_knn_t *knn, qt_knn_entry_t *entry) {
+
+    // CASE 1: A BLACK leaf queues each of it's points
+    qt_node_t *root = entry->node;
+    STATS_COUNT(nodes_visited, 1);
+    for (int i = 0; (root->color == BLACK) && (i < root->point_count); i++) {
+        qt_knn_entry_t point = {NULL, entry->bounds, root->slots[i].items};
+        pq_push(queue, point_2d_distance(knn->point, root->slots[i].point, 
+            knn->metric), &point);
+    }
+
+    // CASE 2: A GREY node queues each child by the distance to it's bounds
+    for (int q = 0; (root->color == GREY) && (q < QUADRANTS); q++) {
+        if (root->children[q].color == WHITE) continue;
+        qt_knn_entry_t child = {&root->children[q], 
+            qt_child_bounds(&entry->bounds, q), NULL};
+        pq_push(queue, rectangle_distance(&child.bounds, knn->point, 
+            knn->metric), &child);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - MATCHES the items of the NEAREST point left to a
+ *              k-nearest-neighbour search
+ * @param[out]  knn         The search
+ * @param[in]   items       The items stored at the point
+ * @param[in]   distance    The distance of the point
+ * @note        Records ALREADY matched (at their other endpoint) are skipped,
+ *              as are ALL items once k records have been matched
+*/
+void 
+qt_knn_collect(qt_knn_t *knn, array_t *items, long double distance) {
+    for (int i = 0; (i < items->logical_size) 
+        && (knn->matches->logical_size < knn->k); i++) {
+        if (bitmap_test_and_set(knn->seen, items->data[i].record)) {
+            if (knn->distances != NULL) {
+                knn->distances[knn->matches->logical_size] = distance;
+            }
+            array_append(knn->matches, items->data[i]);
+        } else {
+            STATS_COUNT(duplicates, 1);
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - finds all the points of a subtree within a range,
+ *              ITERATIVELY over an explicit stack of nodes
+ * @param[in]   root    The subtree's root to find matching points
+ * @param[in]   bounds  The bounds of root
+ * @param[in]   path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   range   The bounded rectangle that defines a range
+ * @param[in]   visitor Where the matches are sent
+ * @note        Visits nodes (& extends path) in the same depth-first order
+ *              as a recursive traversal
+*/
+void 
+qt_subtree_range_query(qt_node_t *root, rectangle_t *bounds, path_t *path, 
+    rectangle_t *range, qt_visitor_t *visitor) {
+
+    // STEP 1: Check if the root's boundary intersects with query range
+    if (! rectangle_intersect(bounds, range)) {
+        return;
+    }
+    qt_frame_t stack[QT_STACK_FRAMES];
+    int top = 0;
+    stack[top].node = root;
+    stack[top].bounds = *bounds;
+    stack[top++].quadrant = -1;
+
+    // STEP 2: Visit the nodes in depth-first order
+    int order[QUADRANTS] = {SW, NW, NE, SE};
+    while (top > 0) {
+        qt_frame_t *frame = &stack[--top];
+        qt_node_t *node = frame->node;
+        STATS_COUNT(nodes_visited, 1);
+        if (frame->quadrant >= 0) {
+            qt_path_append(path, frame->quadrant);
+        }
+
+        // STEP 3: Check if the points at this node lie within the range
+        for (int i = 0; (node->color == BLACK) && (i < node->point_count); 
+            i++) {
+            if (rectangle_contains(*range, node->slots[i].point)) {
+                qt_collect_items(visitor, node->slots[i].items);
+            }
+        }
+
+        // STEP 4: Stop here if we have reached a LEAF node
+        if (node->color != GREY) {
+            continue;
+        }
+
+        // STEP 5: Otherwise stack ONLY the non-EMPTY children the range
+        //         reaches, LAST first so they are visited in order (NOTE:
+        //         the frame is overwritten, so it's bounds are copied)
+        rectangle_t node_bounds = frame->bounds;
+        for (int i = QUADRANTS - 1; i >= 0; i--) {
+            qt_node_t *child = &node->children[order[i]];
+            if (child->color == WHITE) continue;
+
+            rectangle_t child_bounds = qt_child_bounds(&node_bounds, 
+                order[i]);
+            if (rectangle_intersect(&child_bounds, range)) {
+                assert(top < QT_STACK_FRAMES);
+                stack[top].node = child;
+                stack[top].bounds = child_bounds;
+                stack[top++].quadrant = order[i];
+            }
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - finds all the points of a subtree within a circle,
+ *              ITERATIVELY over an explicit stack of nodes
+ * @param[in]   root    The subtree's root to find matching points
+ * @param[in]   bounds  The bounds of root
+ * @param[out]  path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   circle  The circle that defines the range
+ * @param[in]   visitor Where the matches are sent
+ * @note        Visits nodes in the same order as a range query
+*/
+void 
+qt_subtree_radius_query(qt_node_t *root, rectangle_t *bounds, path_t *path,
+    circle_t *circle, qt_visitor_t *visitor) {
+
+    // STEP 1: Check if the root's boundary intersects with the circle
+    if (! circle_intersect(circle, bounds)) {
+        return;
+    }
+    qt_frame_t stack[QT_STACK_FRAMES];
+    int top = 0;
+    stack[top].node = root;
+    stack[top].bounds = *bounds;
+    stack[top++].quadrant = -1;
+
+    // STEP 2: Visit the nodes in depth-first order
+    int order[QUADRANTS] = {SW, NW, NE, SE};
+    while (top > 0) {
+        qt_frame_t *frame = &stack[--top];
+        qt_node_t *node = frame->node;
+        STATS_COUNT(nodes_visited, 1);
+        if (frame->quadrant >= 0) {
+            qt_path_append(path, frame->quadrant);
+        }
+
+        // STEP 3: Check if the points at this node lie within the circle
+        for (int i = 0; (node->color == BLACK) && (i < node->point_count); 
+            i++) {
+            if (circle_contains(circle, node->slots[i].point)) {
+                qt_collect_items(visitor, node->slots[i].items);
+            }
+        }
+
+        // STEP 4: Stop here if we have reached a LEAF node
+        if (node->color != GREY) {
+            continue;
+        }
+
+        // STEP 5: Otherwise stack ONLY the non-EMPTY children the circle
+        //         reaches, LAST first so they are visited in order
+        rectangle_t node_bounds = frame->bounds;
+        for (int i = QUADRANTS - 1; i >= 0; i--) {
+            qt_node_t *child = &node->children[order[i]];
+            if (child->color == WHITE) continue;
+
+            rectangle_t child_bounds = qt_child_bounds(&node_bounds, 
+                order[i]);
+            if (circle_intersect(circle, &child_bounds)) {
+                assert(top < QT_STACK_FRAMES);
+                stack[top].node = child;
+                stack[top].bounds = child_bounds;
+                stack[top++].quadrant = order[i];
+            }
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       MEASURES the shape of a quad-tree (or it's LINEAR backend) &
+ *              the bytes it's nodes, slots & items hold
+ * @param[in]   tree    The quad-tree (NOT being written concurrently)
+ * @param[out]  shape   Filled with the shape
+ * @param[out]  bytes   Filled with the bytes held (EXCEPT by the records)
+*/
+void
+qt_stats(qt_tree_t *tree, stats_shape_t *shape, stats_bytes_t *bytes) {
+
+    // STEP 1: The pools hold EVERYTHING below the root (i.e. the children,
+    //         the slots of each leaf & the items of each point)
+    memset(shape, 0, sizeof(stats_shape_t));
+    memset(bytes, 0, sizeof(stats_bytes_t));
+    bytes->nodes = pool_bytes(tree->pool);
+    bytes->slots = pool_classes_bytes(tree->slot_pools, 0, 0);
+    bytes->grown_slots = pool_classes_bytes(tree->slot_pools, 1, 
+        POOL_CLASSES - 1);
+    bytes->items = pool_bytes(tree->array_pool) 
+        + pool_classes_bytes(tree->item_pools, 0, POOL_CLASSES - 1);
+    if (tree->linear != NULL) {
+        lqt_stats(tree->linear, shape, bytes);
+        return;
+    }
+
+    // STEP 2: Otherwise walk EVERY node depth-first (NOT the pools, as a
+    //         released block is no longer a node)
+    qt_node_t *nodes[QT_STACK_FRAMES];
+    int depths[QT_STACK_FRAMES];
+    int top = 0;
+    nodes[top] = tree->root;
+    depths[top++] = 0;
+    while (top > 0) {
+        qt_node_t *node = nodes[--top];
+        int depth = depths[top];
+        shape->colours[node->color]++;
+
+        // CASE 1: A GREY node stacks ALL of it's children
+        if (node->color == GREY) {
+            for (int q = 0; q < QUADRANTS; q++) {
+                assert(top < QT_STACK_FRAMES);
+                nodes[top] = &node->children[q];
+                depths[top++] = depth + 1;
+            }
+
+        // CASE 2: A BLACK leaf holds items
+        } else if (node->color == BLACK) {
+            long items = 0;
+            for (int i = 0; i < node->point_count; i++) {
+                items += node->slots[i].items->logical_size;
+            }
+            stats_shape_leaf(shape, depth, node->point_count, items);
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FREES a quad-tree INTERFACE from the heap
+ * @param[out]  tree    The quad-tree to free
+ * @note        Nodes, slots & items are released chunk-by-chunk via the 
+ *              tree's pools, so NO node of the quad-tree is visited
+*/
+void 
+qt_free(qt_tree_t *tree) {
+
+    // Free the retired blocks (back to the pools), the pools & finally the 
+    // tree itself
+    if (tree->epoch != NULL) epoch_free(tree->epoch);
+    if (tree->linear != NULL) lqt_free(tree->linear);
+    qt_pools_free(tree);
+    bitmap_free(tree->seen);
+    free(tree->root);
+    free(tree);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - CREATES the (EMPTY) pools of a quad-tree
+ * @param[out]  tree    The quad-tree to give the pools to
+*/
+void 
+qt_pools_init(qt_tree_t *tree) {
+    tree->pool = pool_init(QUADRANTS * sizeof(qt_node_t), 
+        POOL_BLOCKS_PER_CHUNK);
+    tree->slot_pools = pool_classes_init(
+        tree->leaf_capacity * sizeof(qt_slot_t), POOL_BLOCKS_PER_CHUNK);
+    tree->array_pool = pool_init(sizeof(array_t), POOL_BLOCKS_PER_CHUNK);
+    tree->item_pools = pool_classes_init(sizeof(record_ref_t), 
+        POOL_BLOCKS_PER_CHUNK);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - FREES the pools of a quad-tree (& so EVERYTHING 
+ *              below it's root)
+ * @param[out]  tree    The quad-tree whose pools are to be freed
+*/
+void 
+qt_pools_free(qt_tree_t *tree) {
+    pool_free(tree->pool);
+    pool_classes_free(tree->slot_pools);
+    pool_free(tree->array_pool);
+    pool_classes_free(tree->item_pools);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - FREES every node below the root & EMPTIES the root
+ * @param[out]  tree    The quad-tree whose nodes are to be freed
+*/
+void 
+qt_free_nodes(qt_tree_t *tree) {
+
+    // STEP 1: Hand the blocks retired by a concurrent writer back to the pools
+    //         (NO reader may still be inside), as the roots among them are on
+    //         the heap
+    if (tree->epoch != NULL) {
+        epoch_reclaim(tree->epoch, 1);
+    }
+
+    // STEP 2: Release ALL the children, slots & items at once via FRESH pools
+    qt_pools_free(tree);
+    qt_pools_init(tree);
+    qt_node_reset(tree->root);
+    tree->node_count = 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - SUBDIVIDES a quad-tree's node into more children
+ * @param[out]  tree    The quad-tree where node subdivision occurs
+ * @param[out]  root    The root of a subtree that will have 4 new children
+*/
+void 
+qt_subdivide(qt_tree_t *tree, qt_node_t *root) {
+
+    // NOTE: the 4 children are handed out as ONE contiguous pooled block
+    qt_node_t *children = (qt_node_t *)pool_alloc(tree->pool);
+    for (int q = 0; q < QUADRANTS; q++) {
+        qt_node_reset(&children[q]);
+    }
+    root->children = children;
+    tree->node_count += QUADRANTS;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - COMPUTES the bounds of ONE quadrant of a node
+ * @param[in]   bounds      The bounds of the node being subdivided
+ * @param[in]   quadrant    Either NW, NE, SW or SE
+ * @return      The bounds of the child node in that quadrant
+*/
+rectangle_t 
+qt_child_bounds(rectangle_t *bounds, int quadrant) {
+
+    coord_t ctr_x = bounds->ctr.x;
+    coord_t ctr_y = bounds->ctr.y;
+    coord_t hw = bounds->hw;
+    coord_t hh = bounds->hh;
+
+    // CASE 1: The NORTH-WEST node
+    if (quadrant == NW) {
+        return rectangle_init(point_2d_init(ctr_x - hw, ctr_y), 
+            point_2d_init(ctr_x, ctr_y + hh));
+    }
+    // CASE 2: The NORTH-EAST node
+    if (quadrant == NE) {
+        return rectangle_init(point_2d_init(ctr_x, ctr_y), 
+            point_2d_init(ctr_x + hw, ctr_y + hh));
+    }
+    // CASE 3: The SOUTH-WEST node
+    if (quadrant == SW) {
+        return rectangle_init(point_2d_init(ctr_x - hw, ctr_y - hh), 
+            point_2d_init(ctr_x, ctr_y));
+    }
+    // CASE 4: The SOUTH-EAST node
+    assert(quadrant == SE);
+    return rectangle_init(point_2d_init(ctr_x, ctr_y - hh), 
+        point_2d_init(ctr_x + hw, ctr_y));
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - APPENDS a traversed quadrant to a path
+ * @param[out]  path        The path traversed so far, & NULL if it is NOT
+ *                          being tracked
+ * @param[in]   quadrant    Either NW, NE, SW or SE
+*/
+void 
+qt_path_append(path_t *path, int quadrant) {
+    if (path != NULL) path_append(path, quadrant);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - VISITS the items of a point lying within a range
+ * @param[out]  visitor Where the matches are sent
+ * @param[in]   items   The items of a BLACK node lying within the range
+ * @note        A de-duplicating visitor skips the records ALREADY visited
+ *              (i.e. a footpath whose start & end both lie within the range)
+*/
+void 
+qt_collect_items(qt_visitor_t *visitor, array_t *items) {
+    for (int i = 0; i < items->logical_size; i++) {
+        if ((visitor->seen == NULL) 
+            || bitmap_test_and_set(visitor->seen, items->data[i].record)) {
+            visitor->visit(items->data[i], visitor->context);
+        } else {
+            STATS_COUNT(duplicates, 1);
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - APPENDS a match to the array of a range query
+ * @param[in]   item    The reference to the matched record
+ * @param[out]  matches The array_t of matches
+*/
+void 
+qt_append_match(record_ref_t item, void *matches) {
+    array_append((array_t *)matches, item);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - DETERMINES which quadrant a point belongs to
+ * @param[in]   bounds          The bounds of the node being traversed
+ * @param[in]   point           The point we try to determine where it belongs
+ * @param[out]  child_bounds    The bounds of the quadrant the point is in
+ * @return      An INTEGER FLAG where: 0 indicates NW node, 1 indicates NE
+ *              node, 2 indicates SW node & 3 indicates the SE node
+*/
+int 
+qt_determine_quadrant(rectangle_t *bounds, point_2d_t *point, 
+    rectangle_t *child_bounds) {
+
+    // NOTE: bounds & child_bounds may be the SAME rectangle
+    for (int q = 0; q < QUADRANTS; q++) {
+        rectangle_t child = qt_child_bounds(bounds, q);
+        if (rectangle_contains(child, *point)) {
+            *child_bounds = child;
+            return q;
+        }
+    }
+
+    // EXCEPTION: does not belong in any bounds
+    exit(EXIT_FAILURE);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - PICKS which of 4 known quadrants a point belongs to
+ * @param[in]   children    The bounds of the NW, NE, SW & SE quadrants
+ * @param[in]   point       The point we try to determine where it belongs
+ * @return      An INTEGER FLAG where: 0 indicates NW node, 1 indicates NE
+ *              node, 2 indicates SW node & 3 indicates the SE node
+*/
+int 
+qt_pick_quadrant(rectangle_t *children, point_2d_t *point) {
+    for (int q = 0; q < QUADRANTS; q++) {
+        if (rectangle_contains(children[q], *point)) return q;
+    }
+
+    // EXCEPTION: does not belong in any bounds
+    exit(EXIT_FAILURE);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - REPAIRS a grey node by TRANSFERRING it's points into
+ *              it's recently SUBDIVIDED child nodes.
+ * @param[out]  tree    The quad-tree the node belongs to
+ * @param[out]  root    The GREY root node to repair
+ * @param[in]   bounds  The bounds of root
+*/
+void 
+qt_repair_internal(qt_tree_t *tree, qt_node_t *root, rectangle_t *bounds) {
+
+    // STEP 1: Ensure the root is an INTERNAL (i.e. GREY) node
+    assert(root->color == GREY);
+    rectangle_t children[QUADRANTS];
+    for (int q = 0; q < QUADRANTS; q++) {
+        children[q] = qt_child_bounds(bounds, q);
+    }
+
+    // STEP 2: TRANSFER each point (in order) to the quadrant it belongs to
+    for (int i = 0; i < root->point_count; i++) {
+        int child_flag = qt_pick_quadrant(children, &root->slots[i].point);
+        qt_leaf_add(tree, &root->children[child_flag], 
+            &root->slots[i].point, root->slots[i].items);
+    }
+
+    // STEP 3: Hand the grey node's (now empty) slots back to the pool
+    pool_classes_release(tree->slot_pools, 
+        qt_slot_class(tree, root->point_count), root->slots);
+    root->slots = NULL;
+    root->point_count = 0;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - FINDS the slot of a leaf holding a point
+ * @param[in]   node    The BLACK node to look in
+ * @param[in]   point   The point to look for
+ * @return      The index of the slot EQUAL to point, & -1 otherwise
+*/
+int 
+qt_leaf_find(qt_node_t *node, point_2d_t *point) {
+    for (int i = 0; i < node->point_count; i++) {
+        if (equal_point_2d(node->slots[i].point, *point)) return i;
+    }
+    return -1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - CHECKS (WITHOUT copying or changing any node) 
+ *              whether a 2D point holds the DATA with a footpath_id
+ * @param[in]   tree        The quad-tree to look in
+ * @param[in]   point       The point the data was inserted at
+ * @param[in]   footpath_id The footpath_id of the data
+ * @return      1 if the point holds the data, & 0 otherwise
+*/
+int 
+qt_holds(qt_tree_t *tree, point_2d_t *point, int footpath_id) {
+    if (! rectangle_contains(tree->bounds, *point)) {
+        return 0;
+    }
+    qt_node_t *node = tree->root;
+    rectangle_t bounds = tree->bounds;
+    while (node->color == GREY) {
+        node = &node->children[qt_determine_quadrant(&bounds, point, &bounds)];
+    }
+    int slot;
+    return (node->color == BLACK) && ((slot = qt_leaf_find(node, point)) >= 0)
+        && (array_binary_search(node->slots[slot].items, footpath_id) != NULL);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - CHECKS whether a NEW point forces a leaf to split
+ * @param[in]   tree    The quad-tree the node belongs to
+ * @param[in]   node    The BLACK node to check
+ * @param[in]   depth   The depth of node
+ * @return      1 if the leaf must subdivide, & 0 if it can take the point
+ * @note        Leaves at the maximum depth NEVER split
+*/
+int 
+qt_leaf_is_full(qt_tree_t *tree, qt_node_t *node, int depth) {
+    if (depth >= qt_depth_limit(tree)) {
+        return 0;
+    }
+    return node->point_count >= tree->leaf_capacity;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - COMPUTES the depth at which leaves stop splitting
+ * @param[in]   tree    The quad-tree
+ * @return      The tree's maximum depth, or QT_MAX_DEPTH if it is unlimited
+ * @note        Beyond QT_MAX_DEPTH, near-coincident points SHARE a leaf
+ *              rather than forcing ever more subdivisions
+*/
+int 
+qt_depth_limit(qt_tree_t *tree) {
+    return (tree->max_depth == QT_UNLIMITED_DEPTH) 
+        ? QT_MAX_DEPTH : tree->max_depth;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - COMPUTES the size class of a leaf's slots
+ * @param[in]   tree        The quad-tree the leaf belongs to
+ * @param[in]   point_count The number of points the leaf holds
+ * @return      The SMALLEST class whose block holds 'point_count' slots
+ * @note        Class 0 holds 'leaf_capacity' slots; beyond that (only at the
+ *              maximum depth) each class DOUBLES the slots of the last
+*/
+int 
+qt_slot_class(qt_tree_t *tree, int point_count) {
+    int size_class = 0;
+    while ((tree->leaf_capacity << size_class) < point_count) size_class++;
+    return size_class;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - ADDS a NEW point (& it's items) to a leaf
+ * @param[out]  tree    The quad-tree the node belongs to
+ * @param[out]  node    The WHITE or BLACK node to add to (becomes BLACK)
+ * @param[in]   point   The point to add (it is COPIED)
+ * @param[in]   items   DATA associated with the point (now owned by node)
+*/
+void 
+qt_leaf_add(qt_tree_t *tree, qt_node_t *node, point_2d_t *point, 
+    array_t *items) {
+
+    // CASE 1: A WHITE node needs a fresh block of slots
+    if (node->color == WHITE) {
+        node->color = BLACK;
+        node->slots = (qt_slot_t *)pool_classes_alloc(tree->slot_pools, 0);
+
+    // CASE 2: A leaf at the maximum depth has outgrown it's slots, so move
+    //         them to the NEXT class
+    } else {
+        int size_class = qt_slot_class(tree, node->point_count);
+        if (node->point_count == (tree->leaf_capacity << size_class)) {
+            qt_slot_t *slots = (qt_slot_t *)pool_classes_alloc(
+                tree->slot_pools, size_class + 1);
+            memcpy(slots, node->slots, sizeof(qt_slot_t) * node->point_count);
+            pool_classes_release(tree->slot_pools, size_class, node->slots);
+            node->slots = slots;
+        }
+    }
+
+    // STEP 2: Fill the next slot
+    node->slots[node->point_count].point = *point;
+    node->slots[node->point_count].items = items;
+    node->point_count++;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - INITIALISES an EMPTY array of a point's items from
+ *              the tree's pools
+ * @param[out]  tree    The quad-tree the point belongs to
+ * @return      A POINTER to a pooled array_t (with room for 1 item)
+ * @note        A pooled array's physical size is ALWAYS a power of 2, which
+ *              is also it's size class
+*/
+array_t* 
+qt_items_init(qt_tree_t *tree) {
+    array_t *items = (array_t *)pool_alloc(tree->array_pool);
+    items->data = (record_ref_t *)pool_classes_alloc(tree->item_pools, 0);
+    items->logical_size = 0;
+    items->physical_size = 1;
+    return items;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - ADDS an item to a pooled array (in footpath_id
+ *              order, as array_sort_append() does)
+ * @param[out]  tree    The quad-tree the point belongs to
+ * @param[out]  items   The array returned by qt_items_init()
+ * @param[in]   data    The item to add
+*/
+void 
+qt_items_add(qt_tree_t *tree, array_t *items, record_ref_t data) {
+
+    // STEP 1: A FULL array moves to the NEXT class (so array_sort_append()
+    //         never reallocs it)
+    if (items->logical_size == items->physical_size) {
+        int size_class = __builtin_ctz(items->physical_size);
+        record_ref_t *grown = (record_ref_t *)pool_classes_alloc(
+            tree->item_pools, size_class + 1);
+        memcpy(grown, items->data, sizeof(record_ref_t) * items->logical_size);
+        pool_classes_release(tree->item_pools, size_class, items->data);
+        items->data = grown;
+        items->physical_size *= REALLOC_FACTOR;
+    }
+
+    // STEP 2: Insert the item in order
+    array_sort_append(items, data);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - COPIES a pooled array of items
+ * @param[out]  tree    The quad-tree the point belongs to
+ * @param[in]   items   The array to copy
+ * @return      A POINTER to a pooled copy of the array
+*/
+array_t* 
+qt_items_copy(qt_tree_t *tree, array_t *items) {
+    array_t *copy = (array_t *)pool_alloc(tree->array_pool);
+    *copy = *items;
+    copy->data = (record_ref_t *)pool_classes_alloc(tree->item_pools, 
+        __builtin_ctz(items->physical_size));
+    memcpy(copy->data, items->data, sizeof(record_ref_t) * items->logical_size);
+    return copy;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - HANDS a pooled array of items back to the pools
+ * @param[out]  tree    The quad-tree the point belonged to
+ * @param[in]   items   The array to release
+*/
+void 
+qt_items_free(qt_tree_t *tree, array_t *items) {
+    pool_classes_release(tree->item_pools, 
+        __builtin_ctz(items->physical_size), items->data);
+    pool_release(tree->array_pool, items);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - REMOVES a point (but NOT it's items) from a leaf
+ * @param[out]  tree    The quad-tree the node belongs to
+ * @param[out]  node    The BLACK node to remove from (becomes WHITE if EMPTY)
+ * @param[in]   slot    The index of the point's slot
+ * @note        The remaining points KEEP their order
+*/
+void 
+qt_leaf_remove(qt_tree_t *tree, qt_node_t *node, int slot) {
+
+    // STEP 1: Close the gap left by the point
+    int size_class = qt_slot_class(tree, node->point_count);
+    memmove(&node->slots[slot], &node->slots[slot + 1], 
+        sizeof(qt_slot_t) * (node->point_count - slot - 1));
+    node->point_count--;
+
+    // CASE 1: The leaf is now EMPTY, so hand it's slots back to the pool
+    if (node->point_count == 0) {
+        pool_classes_release(tree->slot_pools, size_class, node->slots);
+        node->color = WHITE;
+        node->slots = NULL;
+
+    // CASE 2: A leaf at the maximum depth fits in a SMALLER class once more
+    } else if (qt_slot_class(tree, node->point_count) < size_class) {
+        qt_slot_t *slots = (qt_slot_t *)pool_classes_alloc(tree->slot_pools, 
+            size_class - 1);
+        memcpy(slots, node->slots, sizeof(qt_slot_t) * node->point_count);
+        pool_classes_release(tree->slot_pools, size_class, node->slots);
+        node->slots = slots;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - CHECKS whether a GREY node's children are LEAVES
+ *              whose points fit in ONE leaf
+ * @param[in]   tree    The quad-tree the node belongs to
+ * @param[in]   root    The GREY node to check
+ * @return      1 if the node can be coalesced, & 0 otherwise
+*/
+int 
+qt_can_coalesce(qt_tree_t *tree, qt_node_t *root) {
+    int point_count = 0;
+    for (int q = 0; q < QUADRANTS; q++) {
+        if (root->children[q].color == GREY) return 0;
+        point_count += root->children[q].point_count;
+    }
+    return point_count <= tree->leaf_capacity;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - MERGES a GREY node's children back into ONE leaf
+ *              (i.e. the REVERSE of qt_repair_internal) if their points fit
+ * @param[out]  tree    The quad-tree the node belongs to
+ * @param[out]  root    The GREY node to coalesce (becomes WHITE or BLACK)
+ * @note        Children are merged in quadrant order, so the node's points
+ *              are NOT necessarily in their original insertion order
+*/
+void 
+qt_coalesce(qt_tree_t *tree, qt_node_t *root) {
+
+    // STEP 1: Only merge LEAF children whose points fit in ONE leaf
+    if (! qt_can_coalesce(tree, root)) {
+        return;
+    }
+
+    // STEP 2: TRANSFER each child's points (in order) up to the root
+    qt_node_t *children = root->children;
+    root->color = WHITE;
+    root->children = NULL;
+    for (int q = 0; q < QUADRANTS; q++) {
+        for (int i = 0; i < children[q].point_count; i++) {
+            qt_leaf_add(tree, root, &children[q].slots[i].point, 
+                children[q].slots[i].items);
+        }
+        if (children[q].color == BLACK) {
+            pool_classes_release(tree->slot_pools, 
+                qt_slot_class(tree, children[q].point_count), 
+                children[q].slots);
+        }
+        qt_node_reset(&children[q]);
+    }
+
+    // STEP 3: Hand the (now empty) children back to the pool
+    pool_release(tree->pool, children);
+    tree->node_count -= QUADRANTS;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - STARTS a copy-on-write update by COPYING the root
+ * @param[in]   tree    The CONCURRENT quad-tree to update
+ * @return      The (unpublished) copy of the root to update
+*/
+qt_node_t* 
+qt_cow_begin(qt_tree_t *tree) {
+    qt_node_t *root = (qt_node_t *)malloc(sizeof(qt_node_t));
+    assert(root != NULL);
+    *root = *tree->root;
+    return root;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - PUBLISHES an updated copy of the root (in ONE
+ *              atomic store) & retires the root it replaces
+ * @param[out]  tree    The CONCURRENT quad-tree being updated
+ * @param[in]   root    The root returned by qt_cow_begin()
+*/
+void 
+qt_cow_publish(qt_tree_t *tree, qt_node_t *root) {
+    epoch_retire(tree->epoch, tree->root, QT_RETIRE_ROOT);
+    tree->root = root;
+    epoch_advance(tree->epoch);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - COPIES the children of a node (copied earlier in
+ *              the update) & retires the originals
+ * @param[out]  tree    The CONCURRENT quad-tree being updated
+ * @param[out]  node    The GREY node to give it's own children
+*/
+void 
+qt_cow_own_children(qt_tree_t *tree, qt_node_t *node) {
+    qt_node_t *children = (qt_node_t *)pool_alloc(tree->pool);
+    memcpy(children, node->children, QUADRANTS * sizeof(qt_node_t));
+    epoch_retire(tree->epoch, node->children, QT_RETIRE_CHILDREN);
+    node->children = children;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - COPIES the slots of a leaf (copied earlier in the
+ *              update) & retires the originals
+ * @param[out]  tree    The CONCURRENT quad-tree being updated
+ * @param[out]  node    The BLACK node to give it's own slots
+ * @note        The items are SHARED with the original slots
+*/
+void 
+qt_cow_own_slots(qt_tree_t *tree, qt_node_t *node) {
+
+    // NOTE: the size class is retired along with the slots
+    int size_class = qt_slot_class(tree, node->point_count);
+    qt_slot_t *slots = (qt_slot_t *)pool_classes_alloc(tree->slot_pools, 
+        size_class);
+    epoch_retire(tree->epoch, node->slots, QT_RETIRE_SLOTS + size_class);
+    memcpy(slots, node->slots, sizeof(qt_slot_t) * node->point_count);
+    node->slots = slots;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - COPIES the items of a slot (copied earlier in the
+ *              update) & retires the originals
+ * @param[out]  tree    The CONCURRENT quad-tree being updated
+ * @param[out]  slot    The slot to give it's own items
+*/
+void 
+qt_cow_own_items(qt_tree_t *tree, qt_slot_t *slot) {
+    array_t *items = qt_items_copy(tree, slot->items);
+    epoch_retire(tree->epoch, slot->items, QT_RETIRE_ITEMS);
+    slot->items = items;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - FREES a block retired by a concurrent writer, once
+ *              NO reader can still reach it
+ * @param[out]  block   The block to free
+ * @param[in]   kind    Either QT_RETIRE_ROOT, QT_RETIRE_CHILDREN,
+ *                      QT_RETIRE_ITEMS or QT_RETIRE_SLOTS (plus the size
+ *                      class of the slots)
+ * @param[out]  context The quad-tree the block belonged to
+*/
+void 
+qt_reclaim(void *block, int kind, void *context) {
+    qt_tree_t *tree = (qt_tree_t *)context;
+
+    // CASE 1: The children's slots & items are SHARED with the new version,
+    //         so ONLY the block itself is handed back
+    if (kind == QT_RETIRE_CHILDREN) {
+        pool_release(tree->pool, block);
+
+    // CASE 2: Slots go back to the pool of their size class
+    } else if (kind >= QT_RETIRE_SLOTS) {
+        pool_classes_release(tree->slot_pools, kind - QT_RETIRE_SLOTS, block);
+
+    // CASE 3: Items go back to their pools
+    } else if (kind == QT_RETIRE_ITEMS) {
+        qt_items_free(tree, (array_t *)block);
+
+    // CASE 4: Roots are on the heap
+    } else {
+        free(block);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - PROVIDES an EMPTY seen-set for ONE query
+ * @param[in]   tree    The quad-tree being queried
+ * @return      The quad-tree's own seen-set, or a fresh one if CONCURRENT
+ *              readers would otherwise share it
+*/
+bitmap_t* 
+qt_seen_acquire(qt_tree_t *tree) {
+    return (tree->epoch != NULL) ? bitmap_init() : tree->seen;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - HANDS BACK a seen-set from qt_seen_acquire()
+ * @param[in]   tree    The quad-tree that was queried
+ * @param[out]  seen    The (EMPTY) seen-set
+*/
+void 
+qt_seen_release(qt_tree_t *tree, bitmap_t *seen) {
+    if (seen != tree->seen) {
+        bitmap_free(seen);
+    }
 }
\ No newline at end of file
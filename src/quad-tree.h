@@ -19,7 +19,7 @@
 #define _QUAD_TREE_H_
 
 #define WHITE 0     // Indicates that a quad-tree NODE has ZERO points
-#define BLACK 1     // Indicates that a quad-tree NODE has ONE point
+#define BLACK 1     // Indicates that a quad-tree NODE is a LEAF with points
 #define GREY 2      // Indicates that a quad-tree NODE is INTERNAL
 
 #define UNSUCCESSFUL 0  // Indicates function terminated INCORRECTLY
@@ -29,12 +29,19 @@
 #define NE 1    // Flag to traverse to NORTH-EAST child node
 #define SW 2    // Flag to traverse to SOUTH-WEST child node
 #define SE 3    // Flag to traverse to SOUTH-EAST child node
+#define QUADRANTS 4 // Number of children a GREY node subdivides into
 
-#define MAX_PATH_LENGTH 100000  // Maximum number of characters to add to path
-#define APPEND_NW " NW"         // Adds NORTH-WEST string to the path
-#define APPEND_NE " NE"         // Adds NORTH-EAST string to the path
-#define APPEND_SW " SW"         // Adds SOUTH-WEST string to the path
-#define APPEND_SE " SE"         // Adds SOUTH-EAST string to the path
+#define QT_DEFAULT_LEAF_CAPACITY 1  // DISTINCT points a leaf holds by default
+#define QT_UNLIMITED_DEPTH -1       // Leaves subdivide down to QT_MAX_DEPTH
+#define QT_MAX_DEPTH 64             // HARD limit on the depth of any leaf
+#define QT_STACK_FRAMES (3 * QT_MAX_DEPTH + 1) // Most a traversal stacks
+#define QT_INIT_FINGERS 64          // Initial depth a batch search tracks
+
+#define QT_RETIRE_ROOT 0        // A retired root node (on the heap)
+#define QT_RETIRE_CHILDREN 1    // A retired block of 4 children (pooled)
+#define QT_RETIRE_ITEMS 2       // A retired array of items (pooled)
+#define QT_RETIRE_SLOTS 3       // A retired block of leaf slots (pooled),
+                                // PLUS the size class of the block
 
 /* -------------------------------------------------------------------------- */
 
@@ -42,43 +49,212 @@
 #include "data.h"
 #include "coordinates.h"
 #include "dynamic-array.h"
+#include "bitmap.h"
+#include "pool.h"
+#include "morton.h"
+#include "path.h"
+#include "epoch.h"
+#include "stats.h"
 
 /* -------------------------------------------------------------------------- */
 
 // STRUCTURE DEFINITIONS:
 
+/**
+ * @brief   A DISTINCT point stored in a quad-tree LEAF (i.e. BLACK node)
+ * @param   point       A point that is bound by the quad-tree node's bounds
+ * @param   items       DATA (i.e. record references) associated with the
+ *                      point
+*/
+typedef struct qt_slot qt_slot_t;
+struct qt_slot {
+    point_2d_t      point;
+    array_t         *items;
+};
+
 /**
  * @brief   A quad-tree NODE
  * @param   color       Is either WHITE, BLACK or GREY
- * @param   bounds      The boundary for which a point is defined
- * @param   point       A point that is bound by the quad-tree node's bounds
- * @param   items       DATA associated with the point
- * @param   nw          NORTH-WEST child node
- * @param   ne          NORTH-EAST child node
- * @param   sw          SOUTH-WEST child node
- * @param   se          SOUTH-EAST child
+ * @param   point_count The number of DISTINCT points held by a BLACK node
+ * @param   slots       The points of a BLACK node (in insertion order)
+ * @param   children    A CONTIGUOUS block of 4 child nodes (indexed by NW, NE,
+ *                      SW & SE), & NULL for LEAF nodes
+ * @note    A node does NOT store it's bounds, they are derived from the root's
+ *          bounds (see qt_child_bounds()) whilst descending
 */
 typedef struct qt_node qt_node_t;
 struct qt_node {
     int             color;
+    int             point_count;
+    qt_slot_t       *slots;
+    qt_node_t       *children;
+};
+
+/**
+ * @brief   A CALLBACK receiving ONE match of a range query
+ * @param   item        The reference to the matched record
+ * @param   context     Whatever the caller passed to qt_range_visit()
+*/
+typedef void (*qt_visit_t)(record_ref_t item, void *context);
+
+/**
+ * @brief   Where the matches of a range query are sent
+ * @param   visit       Called once per match, in the order they are found
+ * @param   context     Passed to every call of visit
+ * @param   seen        The records ALREADY visited, & NULL to visit a record
+ *                      once per endpoint within the range
+*/
+typedef struct qt_visitor qt_visitor_t;
+struct qt_visitor {
+    qt_visit_t      visit;
+    void            *context;
+    bitmap_t        *seen;
+};
+
+/**
+ * @brief   ONE node on the descent of the previous search of a batch (the
+ *          path upon reaching the node at depth d is d quadrants long)
+ * @param   node        The node reached
+ * @param   bounds      The bounds of node
+ * @param   children    The bounds of node's children (if node is GREY)
+ * @param   quadrant    The child the descent continued to (if node is GREY)
+*/
+typedef struct qt_finger qt_finger_t;
+struct qt_finger {
+    qt_node_t       *node;
+    rectangle_t     bounds;
+    rectangle_t     children[QUADRANTS];
+    int             quadrant;
+};
+
+/**
+ * @brief   ONE node waiting on the explicit stack of a traversal
+ * @param   node        The node to visit
+ * @param   bounds      The bounds of node
+ * @param   quadrant    The quadrant of node within it's parent (appended to
+ *                      the path upon visiting it), & -1 for the root
+*/
+typedef struct qt_frame qt_frame_t;
+struct qt_frame {
+    qt_node_t       *node;
+    rectangle_t     bounds;
+    int             quadrant;
+};
+
+/**
+ * @brief   ONE node waiting on the explicit stack of a batch of ranges
+ * @param   node        The node to visit
+ * @param   bounds      The bounds of node
+ * @param   quadrant    The quadrant of node within it's parent (appended to
+ *                      the path of each range upon visiting it), & -1 for
+ *                      the root
+ * @param   first       Where the ranges reaching node start in the batch's
+ *                      stack of range indices
+ * @param   count       The number of ranges reaching node
+*/
+typedef struct qt_batch_frame qt_batch_frame_t;
+struct qt_batch_frame {
+    qt_node_t       *node;
+    rectangle_t     bounds;
+    int             quadrant;
+    int             first;
+    int             count;
+};
+
+/**
+ * @brief   ONE subtree waiting on the explicit stack of a bulk load
+ * @param   node        The (WHITE) root of the subtree to build
+ * @param   bounds      The bounds of node
+ * @param   depth       The depth of node
+ * @param   offset      The index of the 1st entry that falls within node
+ * @param   count       The number of entries that fall within node
+*/
+typedef struct qt_build_frame qt_build_frame_t;
+struct qt_build_frame {
+    qt_node_t       *node;
+    rectangle_t     bounds;
+    int             depth;
+    int             offset;
+    int             count;
+};
+
+/**
+ * @brief   The state of a k-nearest-neighbour search
+ * @param   point       The point whose neighbours are sought
+ * @param   k           The number of records sought
+ * @param   metric      Either DISTANCE_PLANAR or DISTANCE_HAVERSINE
+ * @param   matches     The records found so far, NEAREST first
+ * @param   distances   The distance of each match, & NULL if not wanted
+ * @param   seen        The records ALREADY matched (i.e. at their nearer
+ *                      endpoint)
+*/
+typedef struct qt_knn qt_knn_t;
+struct qt_knn {
+    point_2d_t      point;
+    int             k;
+    int             metric;
+    array_t         *matches;
+    long double     *distances;
+    bitmap_t        *seen;
+};
+
+/**
+ * @brief   ONE entry of the priority queue of a k-nearest-neighbour search
+ * @param   node        The node to expand, & NULL for a stored point
+ * @param   bounds      The bounds of node
+ * @param   items       The items stored at the point (if node is NULL)
+*/
+typedef struct qt_knn_entry qt_knn_entry_t;
+struct qt_knn_entry {
+    qt_node_t       *node;
     rectangle_t     bounds;
-    point_2d_t      *point;
     array_t         *items;
-    qt_node_t       *nw;
-    qt_node_t       *ne;
-    qt_node_t       *sw;
-    qt_node_t       *se;
 };
 
+/**
+ * @brief   A LINEAR quad-tree (see linear-quad-tree.h)
+*/
+typedef struct lqt lqt_t;
+
 /**
  * @brief   A quad-tree INTERFACE
  * @param   root        The 1st node in the quad-tree
+ * @param   bounds      The boundary of the root (& hence the quad-tree)
  * @param   node_count  The NUMBER of nodes stored in the quad-tree   
+ * @param   leaf_capacity   The DISTINCT points a leaf holds before it splits
+ * @param   max_depth   The depth at which leaves stop splitting (& may exceed
+ *                      leaf_capacity), or QT_UNLIMITED_DEPTH
+ * @param   pool        Hands out the 4 children of a subdivision as ONE block
+ * @param   slot_pools  Hands out the slots of a leaf ('leaf_capacity' of them
+ *                      in class 0, & DOUBLE that per class for leaves at the
+ *                      maximum depth that outgrow them)
+ * @param   array_pool  Hands out the array_t of each point's items
+ * @param   item_pools  Hands out the items of each point (2^c of them in
+ *                      class c)
+ * @param   linear      The LINEAR backend answering queries, & NULL whilst
+ *                      the (pointer-based) nodes are in use
+ * @param   seen        The records matched by the CURRENT range query (it is
+ *                      emptied before the query returns)
+ * @param   epoch       Reclaims the nodes replaced by COPY-ON-WRITE updates,
+ *                      & NULL unless the quad-tree is read concurrently
+ * @note    The root is ATOMIC so a concurrent writer can publish a new
+ *          version of the quad-tree in ONE store. Everything below the root
+ *          comes from the tree's pools, so it is freed by dropping them
 */
 typedef struct qt_tree qt_tree_t;
 struct qt_tree {
-    qt_node_t       *root;
+    qt_node_t       *_Atomic root;
+    rectangle_t     bounds;
     unsigned int    node_count;
+    int             leaf_capacity;
+    int             max_depth;
+    pool_t          *pool;
+    pool_classes_t  *slot_pools;
+    pool_t          *array_pool;
+    pool_classes_t  *item_pools;
+    lqt_t           *linear;
+    bitmap_t        *seen;
+    epoch_t         *epoch;
 };
 
 /* -------------------------------------------------------------------------- */
@@ -88,79 +264,310 @@ struct qt_tree {
 /**
  * @brief       INITIALISES an EMPTY quad-tree NODE
  * @param[out]   tree    The quad-tree which will have a new node
- * @param[in]   bounds  The boundary for which the quad-tree node is defined
  * @return      A POINTER to a heap-allocated quad-tree NODE
 */
-qt_node_t* qt_node_init(qt_tree_t *tree, rectangle_t bounds);
+qt_node_t* qt_node_init(qt_tree_t *tree);
 
 /**
  * @brief       INITIALISES a quad-tree INTERFACE
- * @param[in]   bounds  The boundary for which the quad-tree node is defined
+ * @param[in]   bounds          The boundary for which the quad-tree is defined
+ * @param[in]   leaf_capacity   The DISTINCT points a leaf holds before it 
+ *                              splits (QT_DEFAULT_LEAF_CAPACITY gives the 
+ *                              classic 1 point per BLACK node)
+ * @param[in]   max_depth       The depth at which leaves stop splitting, or
+ *                              QT_UNLIMITED_DEPTH
  * @return      A POINTER to a heap-allocated quad-tree INTERFACE
 */
-qt_tree_t* qt_tree_init(rectangle_t bounds);
+qt_tree_t* qt_tree_init(rectangle_t bounds, int leaf_capacity, int max_depth);
 
 /**
  * @brief       INSERTS a 2D point & new nodes into the quad-tree
  * @param[out]  tree    The quad-tree to insert new points & nodes into
- * @param[in]   point   The point to insert in the quad-tree
+ * @param[in]   point   The point to insert in the quad-tree (it is COPIED)
  * @param[in]   data    The DATA associated with the POINT
  * @return      An integer flag where: 0 means UNSUCCESSFUL insertion &
  *              1 means SUCCESSFUL insertion
 */
-int qt_insert(qt_tree_t *tree, point_2d_t *point, data_t *data);
+int qt_insert(qt_tree_t *tree, point_2d_t *point, record_ref_t data);
 
 /**
- * @brief       AUXILLARY - RECURSIVELY INSERTS a 2D point into the quad-tree
+ * @brief       AUXILLARY - INSERTS a 2D point into a subtree, ITERATIVELY
+ *              descending from it's root (i.e. in bounded stack space)
  * @param[out]  tree    The quad-tree to insert new points & nodes into
- * @param[out]  root    The current root node of subtree
+ * @param[out]  root    The root node of the subtree
+ * @param[in]   bounds  The bounds of root
+ * @param[in]   depth   The depth of root
  * @param[in]   point   The point to insert in the quad-tree
  * @param[in]   data    The DATA associated with the POINT
  * @return      An integer flag where: 0 means UNSUCCESSFUL insertion &
  *              1 means SUCCESSFUL insertion
+ * @note        In a CONCURRENT quad-tree, root is an unpublished copy & every
+ *              node below it readers may reach is COPIED before it changes
 */
-int qt_recursive_insert(qt_tree_t *tree, qt_node_t *root, 
-    point_2d_t *point, data_t *data);
+int qt_subtree_insert(qt_tree_t *tree, qt_node_t *root, rectangle_t *bounds,
+    int depth, point_2d_t *point, record_ref_t data);
+
+/**
+ * @brief       SWITCHES a quad-tree to CONCURRENT mode, where ONE writer 
+ *              updates it whilst ANY number of readers query it, lock-free
+ * @param[out]  tree    The (pointer-based) quad-tree to share
+ * @note        Updates then COPY the nodes on their root-to-leaf path & 
+ *              publish a new root, so readers only ever see whole versions.
+ *              A reader registers ONCE via epoch_register(tree->epoch), & 
+ *              brackets each query (& it's use of the results) with 
+ *              epoch_enter() & epoch_exit()
+*/
+void qt_concurrent_init(qt_tree_t *tree);
+
+/**
+ * @brief       REMOVES the DATA with a footpath_id from a 2D point, COALESCING
+ *              any GREY node whose children then fit in ONE leaf
+ * @param[out]  tree        The quad-tree to remove from
+ * @param[in]   point       The point the data was inserted at
+ * @param[in]   footpath_id The footpath_id of the data to remove
+ * @return      An integer flag where: 0 means the data was NOT at the point &
+ *              1 means SUCCESSFUL removal
+ * @note        A point is dropped from it's leaf once it has NO data left
+*/
+int qt_remove(qt_tree_t *tree, point_2d_t *point, int footpath_id);
+
+/**
+ * @brief       AUXILLARY - REMOVES the DATA with a footpath_id from a 2D point
+ *              in a subtree, ITERATIVELY descending from it's root
+ * @param[out]  tree        The quad-tree to remove from
+ * @param[out]  root        The root node of the subtree
+ * @param[in]   bounds      The bounds of root
+ * @param[in]   point       The point the data was inserted at
+ * @param[in]   footpath_id The footpath_id of the data to remove
+ * @return      An integer flag where: 0 means the data was NOT at the point &
+ *              1 means SUCCESSFUL removal
+ * @note        In a CONCURRENT quad-tree, root is an unpublished copy & every
+ *              node below it readers may reach is COPIED before it changes
+*/
+int qt_subtree_remove(qt_tree_t *tree, qt_node_t *root, rectangle_t *bounds,
+    point_2d_t *point, int footpath_id);
+
+/**
+ * @brief       MOVES DATA from one 2D point to another (i.e. an UPDATE)
+ * @param[out]  tree        The quad-tree to update
+ * @param[in]   old_point   The point the data was inserted at
+ * @param[in]   new_point   The point to move the data to (it is COPIED)
+ * @param[in]   data        The DATA to move (matched by it's footpath_id)
+ * @return      An integer flag where: 0 means the data was NOT at old_point
+ *              or new_point is out of bounds (the tree is UNCHANGED) & 1 
+ *              means SUCCESSFUL movement
+*/
+int qt_move(qt_tree_t *tree, point_2d_t *old_point, point_2d_t *new_point,
+    record_ref_t data);
+
+/**
+ * @brief       BULK LOADS many 2D points into an EMPTY quad-tree in ONE pass
+ * @param[out]  tree    The EMPTY quad-tree to build
+ * @param[in]   points  The points to insert (they are COPIED)
+ * @param[in]   data    The DATA associated with each POINT (i.e. data[i] 
+ *                      belongs to points[i])
+ * @param[in]   n       The number of points
+ * @return      An integer flag where: 0 means at least ONE point lay outside
+ *              the root's bounds & 1 means ALL points were inserted
+ * @note        Builds the SAME tree (shape, paths & item order) as calling 
+ *              qt_insert() on points[0], points[1], ... in turn
+*/
+int qt_bulk_load(qt_tree_t *tree, point_2d_t *points, record_ref_t *data, 
+    int n);
+
+/**
+ * @brief       SEARCHES a quad-tree for a BATCH of xy-points, answering them
+ *              in Morton order so consecutive searches share their descents
+ * @param[in]   tree    The quad-tree to be queried
+ * @param[in]   points  The points to find in the quad-tree
+ * @param[in]   n       The number of points
+ * @param[out]  results The items stored at each point (as a heap-allocated
+ *                      COPY), & NULL where qt_search() would return NULL
+ * @param[out]  paths   The (heap-allocated) path of each point, & NULL to
+ *                      skip tracking them
+ * @note        results & paths are filled in the SAME order as points
+ * @note        Batches may be searched on SEVERAL threads at once (as long as
+ *              NO points are inserted meanwhile)
+*/
+void qt_search_batch(qt_tree_t *tree, point_2d_t *points, int n,
+    array_t **results, path_t **paths);
+
+/**
+ * @brief       FINDS all the points within a BATCH of ranges in ONE shared
+ *              traversal, so each node is visited ONCE for every range that
+ *              reaches it (rather than once per range)
+ * @param[in]   tree    The quad-tree to query
+ * @param[in]   ranges  The bounded rectangles that define each range
+ * @param[in]   n       The number of ranges
+ * @param[out]  results The matches of each range (as qt_range_query() 
+ *                      returns them)
+ * @param[out]  paths   The (heap-allocated) path of each range, & NULL to
+ *                      skip tracking them
+ * @note        results & paths are filled in the SAME order as ranges
+ * @note        Batches may be queried on SEVERAL threads at once (as long as
+ *              NO points are inserted meanwhile)
+*/
+void qt_range_query_batch(qt_tree_t *tree, rectangle_t *ranges, int n,
+    array_t **results, path_t **paths);
+
+/**
+ * @brief       CONVERTS a built quad-tree to the LINEAR backend
+ * @param[out]  tree    The quad-tree whose nodes are replaced
+ * @return      An integer flag where: 0 means the quad-tree was too DEEP to
+ *              be linearised (& is left untouched) & 1 means SUCCESSFUL
+ * @note        Queries keep working through qt_search() & qt_range_query(),
+ *              but NO further points may be inserted
+*/
+int qt_linearise(qt_tree_t *tree);
 
 /**
  * @brief       FINDS all the points within a bounded RANGE
  * @param[in]   tree    The quad-tree to query
- * @param[in]   path    A string of all the directions traversed in the search
+ * @param[in]   path    The quadrants traversed (& NULL to skip tracking them)
  * @param[in]   range   The bounded rectangle that defines a range
  * @return      A pointer of type array_t with the matched query data
 */
-array_t* qt_range_query(qt_tree_t *tree, char *path, rectangle_t *range);
+array_t* qt_range_query(qt_tree_t *tree, path_t *path, rectangle_t *range);
+
+/**
+ * @brief       FINDS all the points within a CIRCLE (e.g. within 200 metres
+ *              of a point), pruning the quadrants it does NOT intersect
+ * @param[in]   tree    The quad-tree to query
+ * @param[out]  path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   circle  The circle that defines the range
+ * @return      A pointer of type array_t with the matched query data (as
+ *              qt_range_query() returns them), & NULL if nothing matched
+*/
+array_t* qt_radius_query(qt_tree_t *tree, path_t *path, circle_t *circle);
+
+/**
+ * @brief       VISITS all the points within a bounded RANGE, WITHOUT
+ *              collecting them
+ * @param[in]   tree    The quad-tree to query
+ * @param[out]  path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   range   The bounded rectangle that defines a range
+ * @param[in]   visit   Called once per match, in the order they are found
+ *                      (i.e. NOT sorted by footpath_id)
+ * @param[in]   context Passed to every call of visit
+ * @param[in]   dedupe  1 to visit each record ONCE, & 0 to visit it once
+ *                      per endpoint within the range
+*/
+void qt_range_visit(qt_tree_t *tree, path_t *path, rectangle_t *range,
+    qt_visit_t visit, void *context, int dedupe);
+
+/**
+ * @brief       FINDS the k records NEAREST to a point, by a BEST-FIRST search
+ *              expanding nodes in order of their distance from the point
+ * @param[in]   tree        The quad-tree to query
+ * @param[in]   point       The point whose neighbours are sought
+ * @param[in]   k           The number of records sought (at least 1)
+ * @param[in]   metric      Either DISTANCE_PLANAR or DISTANCE_HAVERSINE
+ * @param[out]  distances   Filled with the distance of each record (to it's 
+ *                          NEARER endpoint), & NULL if not wanted
+ * @return      A pointer of type array_t with up to k records, NEAREST 
+ *              first, & NULL if the quad-tree is EMPTY
+*/
+array_t* qt_knn(qt_tree_t *tree, point_2d_t *point, int k, int metric,
+    long double *distances);
 
 /**
- * @brief       AUXILLARY - RECURSIVELY finds all the points within a range
- * @param[in]   root    The current subtree's root to find matching points
- * @param[in]   path    A string of all the directions traversed in the search
+ * @brief       AUXILLARY - finds all the points of a subtree within a range,
+ *              ITERATIVELY over an explicit stack of nodes
+ * @param[in]   root    The subtree's root to find matching points
+ * @param[in]   bounds  The bounds of root
+ * @param[in]   path    The quadrants traversed (& NULL to skip tracking them)
  * @param[in]   range   The bounded rectangle that defines a range
- * @param[in]   matches A pointer to all the matches
+ * @param[in]   visitor Where the matches are sent
+ * @note        Visits nodes (& extends path) in the same depth-first order
+ *              as a recursive traversal
+*/
+void qt_subtree_range_query(qt_node_t *root, rectangle_t *bounds, path_t *path, 
+    rectangle_t *range, qt_visitor_t *visitor);
+
+/**
+ * @brief       AUXILLARY - finds all the points of a subtree within a circle,
+ *              ITERATIVELY over an explicit stack of nodes
+ * @param[in]   root    The subtree's root to find matching points
+ * @param[in]   bounds  The bounds of root
+ * @param[out]  path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   circle  The circle that defines the range
+ * @param[in]   visitor Where the matches are sent
+ * @note        Visits nodes in the same order as a range query
 */
-void qt_recursive_range_query(qt_node_t *root, char *path, rectangle_t *range, array_t *matches);
+void qt_subtree_radius_query(qt_node_t *root, rectangle_t *bounds, path_t *path,
+    circle_t *circle, qt_visitor_t *visitor);
 
 /**
  * @brief       SEARCHES a quad-tree for a xy-point
  * @param[in]   tree    The quad-tree to be queried
  * @param[in]   point   The point to find in the quad-tree
- * @param[out]  path    The path of the point
- * @return      A pointer to a qt_node_t containing the point, & NULL otherwise
- * @note        Also PRINTS the path to STDOUT
+ * @param[out]  path    The path of the point (& NULL to skip tracking it)
+ * @return      A pointer to the items stored at the point, & NULL otherwise
 */
-qt_node_t* qt_search(qt_tree_t *tree, point_2d_t *point, char *path);
+array_t* qt_search(qt_tree_t *tree, point_2d_t *point, path_t *path);
 
 /**
- * @brief       FREES a quad-tree INTERFACE from the heap
- * @param[out]  tree    The quad-tree to free
+ * @brief       AUXILLARY - COMPUTES the bounds of ONE quadrant of a node
+ * @param[in]   bounds      The bounds of the node being subdivided
+ * @param[in]   quadrant    Either NW, NE, SW or SE
+ * @return      The bounds of the child node in that quadrant
 */
-void qt_free(qt_tree_t *tree);
+rectangle_t qt_child_bounds(rectangle_t *bounds, int quadrant);
 
 /**
- * @brief       AUXILLARY - RECUSIVELY FREES a quad-tree NODE from the heap
+ * @brief       AUXILLARY - DETERMINES which quadrant a point belongs to
+ * @param[in]   bounds          The bounds of the node being traversed
+ * @param[in]   point           The point we try to determine where it belongs
+ * @param[out]  child_bounds    The bounds of the quadrant the point is in
+ * @return      An INTEGER FLAG where: 0 indicates NW node, 1 indicates NE
+ *              node, 2 indicates SW node & 3 indicates the SE node
+*/
+int qt_determine_quadrant(rectangle_t *bounds, point_2d_t *point, 
+    rectangle_t *child_bounds);
+
+/**
+ * @brief       AUXILLARY - APPENDS a traversed quadrant to a path
+ * @param[out]  path        The path traversed so far, & NULL if it is NOT
+ *                          being tracked
+ * @param[in]   quadrant    Either NW, NE, SW or SE
+*/
+void qt_path_append(path_t *path, int quadrant);
+
+/**
+ * @brief       AUXILLARY - VISITS the items of a point lying within a range
+ * @param[out]  visitor Where the matches are sent
+ * @param[in]   items   The items of a BLACK node lying within the range
+ * @note        A de-duplicating visitor skips the records ALREADY visited
+ *              (i.e. a footpath whose start & end both lie within the range)
+*/
+void qt_collect_items(qt_visitor_t *visitor, array_t *items);
+
+/**
+ * @brief       AUXILLARY - MATCHES the items of the NEAREST point left to a
+ *              k-nearest-neighbour search
+ * @param[out]  knn         The search
+ * @param[in]   items       The items stored at the point
+ * @param[in]   distance    The distance of the point
+ * @note        Records ALREADY matched (at their other endpoint) are skipped,
+ *              as are ALL items once k records have been matched
+*/
+void qt_knn_collect(qt_knn_t *knn, array_t *items, long double distance);
+
+/**
+ * @brief       MEASURES the shape of a quad-tree (or it's LINEAR backend) &
+ *              the bytes it's nodes, slots & items hold
+ * @param[in]   tree    The quad-tree (NOT being written concurrently)
+ * @param[out]  shape   Filled with the shape
+ * @param[out]  bytes   Filled with the bytes held (EXCEPT by the records)
+*/
+void qt_stats(qt_tree_t *tree, stats_shape_t *shape, stats_bytes_t *bytes);
+
+/**
+ * @brief       FREES a quad-tree INTERFACE from the heap
  * @param[out]  tree    The quad-tree to free
- * @param[out]  root    The current root of a subtree to free
+ * @note        Nodes are released chunk-by-chunk via the tree's pool, so NO
+ *              recursive walk of the quad-tree is required
 */
-void qt_recursive_free(qt_tree_t *tree, qt_node_t *root);
+void qt_free(qt_tree_t *tree);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,273 @@
+/**
+ * @file    query-engine.c
+ * @brief   A file for the implementation of a multi-threaded engine
+ *          answering blocks of queries from STDIN
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <pthread.h>
+
+#include "query-engine.h"
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+void* query_worker(void *arg);
+void* query_writer(void *arg);
+void query_answer_chunk(query_engine_t *engine, query_chunk_t *chunk);
+void query_write_chunk(query_engine_t *engine, query_chunk_t *chunk);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       ANSWERS every query on STDIN, printing the findings exactly as
+ *              answering them one at a time would
+ * @param[in]   output_file The file to print the matched records to
+ * @param[in]   tree        The quad-tree to query (which must NOT be modified
+ *                          until this returns)
+ * @param[in]   store       The records the quad-tree's items refer to
+ * @param[in]   kind        Either QUERY_POINT or QUERY_RANGE
+ * @param[in]   batch       The number of queries in each chunk
+ * @param[in]   threads     The number of workers answering the chunks
+*/
+void
+query_engine_run(FILE *output_file, qt_tree_t *tree, record_store_t *store,
+    int kind, int batch, int threads) {
+
+    // STEP 1: Allocate EVERY slot of the ring up front (so nothing is
+    //         allocated per chunk)
+    assert((batch >= 1) && (threads >= 1));
+    query_engine_t engine;
+    engine.tree = tree;
+    engine.store = store;
+    engine.output_file = output_file;
+    engine.kind = kind;
+    engine.slots = QUERY_SLOTS_PER_THREAD * threads + 2;
+    engine.read = engine.claimed = engine.written = 0;
+    engine.finished = 0;
+    engine.path = path_init();
+    engine.chunks =
+        (query_chunk_t *)malloc(sizeof(query_chunk_t) * engine.slots);
+    assert(engine.chunks);
+    for (int i = 0; i < engine.slots; i++) {
+        query_chunk_t *chunk = &engine.chunks[i];
+        chunk->reads = malloc(sizeof(*chunk->reads) * batch);
+        chunk->points = (point_2d_t *)malloc(sizeof(point_2d_t) * batch);
+        chunk->ranges = (rectangle_t *)malloc(sizeof(rectangle_t) * batch);
+        chunk->results = (array_t **)malloc(sizeof(array_t *) * batch);
+        chunk->paths = (path_t **)malloc(sizeof(path_t *) * batch);
+        chunk->offsets = (long *)malloc(sizeof(long) * (batch + 1));
+        assert(chunk->reads && chunk->points && chunk->ranges
+            && chunk->results && chunk->paths && chunk->offsets);
+        chunk->text = format_init();
+        chunk->count = 0;
+        chunk->answered = 0;
+    }
+    pthread_mutex_init(&engine.lock, NULL);
+    pthread_cond_init(&engine.changed, NULL);
+
+    // STEP 2: Start the workers & the writer (which live until STDIN runs
+    //         out & every chunk is written)
+    pthread_t *workers = (pthread_t *)malloc(sizeof(pthread_t) * threads);
+    pthread_t writer;
+    assert(workers);
+    for (int i = 0; i < threads; i++) {
+        pthread_create(&workers[i], NULL, query_worker, &engine);
+    }
+    pthread_create(&writer, NULL, query_writer, &engine);
+
+    // STEP 3: Read chunks into the ring whilst the other stages run, only
+    //         waiting when EVERY slot is still in flight
+    int n;
+    do {
+        pthread_mutex_lock(&engine.lock);
+        while (engine.read - engine.written == engine.slots) {
+            pthread_cond_wait(&engine.changed, &engine.lock);
+        }
+        pthread_mutex_unlock(&engine.lock);
+
+        // NOTE: the slot is free, so NO other stage touches it whilst read
+        query_chunk_t *chunk = &engine.chunks[engine.read % engine.slots];
+        for (n = 0; (n < batch)
+            && (scanf("%[^\n]\n", chunk->reads[n]) == 1); n++);
+        chunk->count = n;
+
+        pthread_mutex_lock(&engine.lock);
+        if (n > 0) engine.read++;
+        if (n < batch) engine.finished = 1;
+        pthread_cond_broadcast(&engine.changed);
+        pthread_mutex_unlock(&engine.lock);
+    } while (n == batch);
+
+    // STEP 4: Wait for the other stages to drain the ring
+    for (int i = 0; i < threads; i++) pthread_join(workers[i], NULL);
+    pthread_join(writer, NULL);
+
+    for (int i = 0; i < engine.slots; i++) {
+        query_chunk_t *chunk = &engine.chunks[i];
+        free(chunk->reads);
+        free(chunk->points);
+        free(chunk->ranges);
+        free(chunk->results);
+        free(chunk->paths);
+        free(chunk->offsets);
+        format_free(chunk->text);
+    }
+    free(engine.chunks);
+    free(workers);
+    path_free(engine.path);
+    pthread_mutex_destroy(&engine.lock);
+    pthread_cond_destroy(&engine.changed);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - A WORKER: answers the next unclaimed chunk until
+ *              STDIN runs out & every chunk is claimed
+ * @param[out]  arg     The query_engine_t of the pipeline
+ * @return      NULL (as required by pthread_create)
+*/
+void*
+query_worker(void *arg) {
+    query_engine_t *engine = (query_engine_t *)arg;
+    pthread_mutex_lock(&engine->lock);
+    while (1) {
+
+        // STEP 1: Wait for a chunk that NO other worker has claimed
+        while ((engine->claimed == engine->read) && (! engine->finished)) {
+            pthread_cond_wait(&engine->changed, &engine->lock);
+        }
+        if (engine->claimed == engine->read) break;
+        query_chunk_t *chunk =
+            &engine->chunks[engine->claimed++ % engine->slots];
+        pthread_mutex_unlock(&engine->lock);
+
+        // STEP 2: Answer it OUTSIDE the lock, & then hand it to the writer
+        query_answer_chunk(engine, chunk);
+        pthread_mutex_lock(&engine->lock);
+        chunk->answered = 1;
+        pthread_cond_broadcast(&engine->changed);
+    }
+    pthread_mutex_unlock(&engine->lock);
+    return NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - The WRITER: writes the answered chunks out in the
+ *              order they were read (freeing their slots for the reader)
+ * @param[out]  arg     The query_engine_t of the pipeline
+ * @return      NULL (as required by pthread_create)
+*/
+void*
+query_writer(void *arg) {
+    query_engine_t *engine = (query_engine_t *)arg;
+    pthread_mutex_lock(&engine->lock);
+    while (1) {
+
+        // STEP 1: Wait for the NEXT chunk (in input order) to be answered
+        query_chunk_t *chunk = &engine->chunks[engine->written % engine->slots];
+        while (((engine->written == engine->read) && (! engine->finished))
+            || ((engine->written < engine->read) && (! chunk->answered))) {
+            pthread_cond_wait(&engine->changed, &engine->lock);
+        }
+        if (engine->written == engine->read) break;
+        pthread_mutex_unlock(&engine->lock);
+
+        // STEP 2: Write it OUTSIDE the lock, & then free it's slot
+        query_write_chunk(engine, chunk);
+        pthread_mutex_lock(&engine->lock);
+        chunk->answered = 0;
+        engine->written++;
+        pthread_cond_broadcast(&engine->changed);
+    }
+    pthread_mutex_unlock(&engine->lock);
+    return NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - ANSWERS the queries of a chunk & prints their
+ *              findings into the chunk's OWN buffer
+ * @param[in]   engine  The query_engine_t of the pipeline
+ * @param[out]  chunk   The chunk to answer
+*/
+void
+query_answer_chunk(query_engine_t *engine, query_chunk_t *chunk) {
+
+    // STEP 1: Parse the query lines
+    long double x, y, tr_x, tr_y;
+    for (int i = 0; i < chunk->count; i++) {
+        if (engine->kind == QUERY_POINT) {
+            assert(sscanf(chunk->reads[i], "%Lf %Lf\n", &x, &y) == 2);
+            chunk->points[i] = point_2d_quantise(x, y);
+        } else {
+            assert(sscanf(chunk->reads[i], "%Lf %Lf %Lf %Lf\n",
+                &x, &y, &tr_x, &tr_y) == 4);
+            chunk->ranges[i] = rectangle_init(point_2d_quantise(x, y),
+                point_2d_quantise(tr_x, tr_y));
+        }
+    }
+
+    // STEP 2: Answer the queries (in Morton order)
+    if (engine->kind == QUERY_POINT) {
+        qt_search_batch(engine->tree, chunk->points, chunk->count,
+            chunk->results, chunk->paths);
+    } else {
+        qt_range_query_batch(engine->tree, chunk->ranges, chunk->count,
+            chunk->results, chunk->paths);
+    }
+
+    // STEP 3: Render the findings (in input order) into the chunk's buffer
+    format_buffer_t *text = chunk->text;
+    text->length = 0;
+    for (int i = 0; i < chunk->count; i++) {
+        chunk->offsets[i] = text->length;
+        array_t *matches = chunk->results[i];
+        if (matches == NULL) continue;
+        format_text(text, chunk->reads[i], strlen(chunk->reads[i]));
+        format_literal(text, "\n");
+        for (int j = 0; j < matches->logical_size; j++) {
+            record_store_format(text, engine->store, matches->data[j].record);
+        }
+        array_free(matches);
+    }
+    chunk->offsets[chunk->count] = text->length;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - WRITES the findings of an answered chunk to the
+ *              output file & STDOUT
+ * @param[out]  engine  The query_engine_t of the pipeline (it's path carries
+ *                      over queries which found NOTHING)
+ * @param[out]  chunk   The answered chunk (it's paths are freed)
+*/
+void
+query_write_chunk(query_engine_t *engine, query_chunk_t *chunk) {
+    path_t *path = engine->path;
+    for (int i = 0; i < chunk->count; i++) {
+        path_extend(path, chunk->paths[i]);
+        long length = chunk->offsets[i + 1] - chunk->offsets[i];
+        if (length > 0) {
+            fwrite(chunk->text->text + chunk->offsets[i], 1, length,
+                engine->output_file);
+            printf("%s -->", chunk->reads[i]);
+            path_print(stdout, path);
+            printf("\n");
+            path_truncate(path, 0);
+        }
+        path_free(chunk->paths[i]);
+    }
+}
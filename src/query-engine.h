@@ -0,0 +1,121 @@
+/**
+ * @file    query-engine.h
+ * @brief   A HEADER file for a multi-threaded engine answering blocks of
+ *          queries from STDIN
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          A PIPELINE of 3 stages that run at the SAME time: the calling
+ *          thread reads chunks of queries from STDIN into a ring of slots,
+ *          PERSISTENT workers each take the next chunk, answer it (in Morton
+ *          order) & print the findings into the slot's OWN buffer, & a writer
+ *          thread writes the answered chunks out IN INPUT ORDER (so the
+ *          output is identical to answering the queries one at a time)
+*/
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#ifndef _QUERY_ENGINE_H_
+#define _QUERY_ENGINE_H_
+
+#define QUERY_POINT 1               // Queries are xy-points (i.e. stage 1)
+#define QUERY_RANGE 2               // Queries are ranges (i.e. stage 2)
+#define QUERY_DEFAULT_BATCH 4096    // Queries per chunk
+#define QUERY_SLOTS_PER_THREAD 2    // Chunks in flight per worker (so the
+                                    // reader & writer rarely hold them up)
+
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT FILES
+#include <stdio.h>
+#include <pthread.h>
+
+#include "data.h"
+#include "format.h"
+#include "quad-tree.h"
+#include "record-store.h"
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   A chunk of queries (i.e. ONE slot of the ring)
+ * @param   reads       The query lines as read from STDIN
+ * @param   count       The number of queries
+ * @param   points      The xy-points queried (if kind is QUERY_POINT)
+ * @param   ranges      The ranges queried (if kind is QUERY_RANGE)
+ * @param   results     The matches of each query
+ * @param   paths       The (heap-allocated) path of each query
+ * @param   offsets     Where the output of each query starts in text (with
+ *                      ONE extra entry marking the end of the last), such
+ *                      that a query which found NOTHING has NO output
+ * @param   text        The output of every query, back-to-back
+ * @param   answered    Whether a worker has finished with the chunk
+*/
+typedef struct query_chunk query_chunk_t;
+struct query_chunk {
+    char            (*reads)[MAX_STR_LEN + 1];
+    int             count;
+    point_2d_t      *points;
+    rectangle_t     *ranges;
+    array_t         **results;
+    path_t          **paths;
+    long            *offsets;
+    format_buffer_t *text;
+    int             answered;
+};
+
+/**
+ * @brief   The state SHARED by the stages of the pipeline
+ * @param   tree        The quad-tree to query (which is NOT modified)
+ * @param   store       The records the quad-tree's items refer to
+ * @param   output_file The file to print the matched records to
+ * @param   kind        Either QUERY_POINT or QUERY_RANGE
+ * @param   chunks      The ring of slots (chunk i lives in slot i % slots)
+ * @param   slots       The number of slots
+ * @param   read        The chunks read so far
+ * @param   claimed     The chunks taken by a worker so far
+ * @param   written     The chunks written out so far
+ * @param   finished    Whether STDIN has run out of queries
+ * @param   path        The path carried over from queries which found 
+ *                      NOTHING (touched ONLY by the writer)
+ * @param   lock        Guards the counters & the 'answered' flags
+ * @param   changed     Signalled whenever a counter or flag changes
+*/
+typedef struct query_engine query_engine_t;
+struct query_engine {
+    qt_tree_t       *tree;
+    record_store_t  *store;
+    FILE            *output_file;
+    int             kind;
+    query_chunk_t   *chunks;
+    int             slots;
+    long            read;
+    long            claimed;
+    long            written;
+    int             finished;
+    path_t          *path;
+    pthread_mutex_t lock;
+    pthread_cond_t  changed;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// QUERY ENGINE OPERATIONS:
+
+/**
+ * @brief       ANSWERS every query on STDIN, printing the findings exactly as
+ *              answering them one at a time would
+ * @param[in]   output_file The file to print the matched records to
+ * @param[in]   tree        The quad-tree to query (which must NOT be modified
+ *                          until this returns)
+ * @param[in]   store       The records the quad-tree's items refer to
+ * @param[in]   kind        Either QUERY_POINT or QUERY_RANGE
+ * @param[in]   batch       The number of queries in each chunk
+ * @param[in]   threads     The number of workers answering the chunks
+*/
+void query_engine_run(FILE *output_file, qt_tree_t *tree, 
+    record_store_t *store, int kind, int batch, int threads);
+
+#endif
@@ -0,0 +1,366 @@
+/**
+ * @file    range-cache.c
+ * @brief   A file for the implementation of a cache of range query results
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "range-cache.h"
+
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#define RANGE_HASH_SEED 0xcbf29ce484222325ULL   // FNV-1a offset basis
+#define RANGE_HASH_PRIME 0x100000001b3ULL       // FNV-1a prime
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+uint64_t range_cache_hash(rectangle_t *range);
+uint64_t range_cache_mix(uint64_t hash, coord_t value);
+range_cache_entry_t* range_cache_find(range_cache_t *cache,
+    rectangle_t *range, uint64_t hash);
+void range_cache_insert(range_cache_t *cache, rectangle_t *range,
+    uint64_t hash, array_t *matches, path_t *path);
+void range_cache_evict(range_cache_t *cache);
+void range_cache_unlink(range_cache_t *cache, range_cache_entry_t *entry);
+void range_cache_push(range_cache_t *cache, range_cache_entry_t *entry);
+void range_cache_grow(range_cache_t *cache);
+array_t* range_cache_matches(range_cache_entry_t *entry);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       INITIALISES an EMPTY cache on the heap
+ * @param[in]   budget  The MOST bytes the entries may hold
+ * @return      A POINTER to a heap-allocated range_cache_t
+*/
+range_cache_t*
+range_cache_init(size_t budget) {
+    range_cache_t *new_cache = (range_cache_t *)calloc(1,
+        sizeof(range_cache_t));
+    assert(new_cache != NULL);
+    new_cache->buckets = (range_cache_entry_t **)calloc(
+        RANGE_CACHE_INIT_BUCKETS, sizeof(range_cache_entry_t *));
+    assert(new_cache->buckets != NULL);
+    new_cache->bucket_count = RANGE_CACHE_INIT_BUCKETS;
+    new_cache->scratch = path_init();
+    new_cache->budget = budget;
+    return new_cache;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FINDS all the points within a RANGE (as qt_range_query()
+ *              does), answering from the cache if the range is in it, &
+ *              caching the result otherwise
+ * @param[out]  cache   The cache
+ * @param[in]   tree    The quad-tree to query on a miss
+ * @param[out]  path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   range   The bounded rectangle that defines the range
+ * @return      A heap-allocated array_t of the matches (owned by the caller),
+ *              & NULL if nothing matched
+*/
+array_t*
+range_cache_query(range_cache_t *cache, qt_tree_t *tree, path_t *path,
+    rectangle_t *range) {
+
+    // CASE 1: A hit, so the range becomes the MOST recently used
+    uint64_t hash = range_cache_hash(range);
+    range_cache_entry_t *entry = range_cache_find(cache, range, hash);
+    if (entry != NULL) {
+        cache->hits++;
+        range_cache_unlink(cache, entry);
+        range_cache_push(cache, entry);
+        if (path != NULL) path_extend(path, entry->path);
+        return range_cache_matches(entry);
+    }
+
+    // CASE 2: A miss, so query the quad-tree (tracking the path on it's own,
+    //         as the caller's path may already hold quadrants) & cache it
+    cache->misses++;
+    path_truncate(cache->scratch, 0);
+    array_t *matches = qt_range_query(tree, cache->scratch, range);
+    range_cache_insert(cache, range, hash, matches, cache->scratch);
+    if (path != NULL) path_extend(path, cache->scratch);
+    return matches;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       EVICTS every entry (e.g. once the quad-tree is modified)
+ * @param[out]  cache   The cache
+*/
+void
+range_cache_clear(range_cache_t *cache) {
+    while (cache->oldest != NULL) {
+        range_cache_evict(cache);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FREES the cache (& every entry) from the heap
+ * @param[out]  cache   The cache to free
+*/
+void
+range_cache_free(range_cache_t *cache) {
+    range_cache_clear(cache);
+    path_free(cache->scratch);
+    free(cache->buckets);
+    free(cache);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - HASHES the corners of a range (FNV-1a)
+ * @param[in]   range   The range
+ * @return      A 64-bit hash
+*/
+uint64_t
+range_cache_hash(rectangle_t *range) {
+    uint64_t hash = RANGE_HASH_SEED;
+    hash = range_cache_mix(hash, range->bl.x);
+    hash = range_cache_mix(hash, range->bl.y);
+    hash = range_cache_mix(hash, range->tr.x);
+    hash = range_cache_mix(hash, range->tr.y);
+    return hash;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - MIXES a coordinate into a hash
+ * @param[in]   hash    The hash so far
+ * @param[in]   value   The coordinate
+ * @return      The new hash
+ * @note        The coordinate is mixed in as a double, as a long double has
+ *              PADDING bytes (whose contents are undefined)
+*/
+uint64_t
+range_cache_mix(uint64_t hash, coord_t value) {
+    double real = (double)value;
+    unsigned char bytes[sizeof(double)];
+    memcpy(bytes, &real, sizeof(double));
+    for (size_t i = 0; i < sizeof(double); i++) {
+        hash = (hash ^ bytes[i]) * RANGE_HASH_PRIME;
+    }
+    return hash;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - FINDS the entry of a range
+ * @param[in]   cache   The cache
+ * @param[in]   range   The range
+ * @param[in]   hash    The hash of the range
+ * @return      The range's entry, & NULL if it is NOT cached
+*/
+range_cache_entry_t*
+range_cache_find(range_cache_t *cache, rectangle_t *range, uint64_t hash) {
+
+    // NOTE: the corners are compared EXACTLY, as equal query lines quantise
+    //       to the SAME coordinates
+    range_cache_entry_t *entry =
+        cache->buckets[hash & (cache->bucket_count - 1)];
+    for (; entry != NULL; entry = entry->chain) {
+        if ((entry->hash == hash)
+            && (entry->bl.x == range->bl.x) && (entry->bl.y == range->bl.y)
+            && (entry->tr.x == range->tr.x) && (entry->tr.y == range->tr.y)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - CACHES the result of a range, evicting the LEAST
+ *              recently used entries until it fits the budget
+ * @param[out]  cache   The cache
+ * @param[in]   range   The range
+ * @param[in]   hash    The hash of the range
+ * @param[in]   matches The range's matches (& NULL if nothing matched)
+ * @param[in]   path    The quadrants the range traversed
+*/
+void
+range_cache_insert(range_cache_t *cache, rectangle_t *range, uint64_t hash,
+    array_t *matches, path_t *path) {
+
+    // STEP 1: Results LARGER than the whole budget are NOT cached
+    int match_count = (matches != NULL) ? matches->logical_size : 0;
+    size_t bytes = sizeof(range_cache_entry_t) + sizeof(path_t)
+        + sizeof(record_ref_t) * match_count
+        + sizeof(uint64_t) * path->word_count;
+    if (bytes > cache->budget) {
+        return;
+    }
+
+    // STEP 2: Make room for the entry
+    while (cache->bytes + bytes > cache->budget) {
+        range_cache_evict(cache);
+        cache->evictions++;
+    }
+
+    // STEP 3: Copy the result into a NEW entry
+    range_cache_entry_t *entry = (range_cache_entry_t *)malloc(
+        sizeof(range_cache_entry_t));
+    assert(entry != NULL);
+    entry->bl = range->bl;
+    entry->tr = range->tr;
+    entry->hash = hash;
+    entry->match_count = match_count;
+    entry->matches = NULL;
+    if (match_count > 0) {
+        entry->matches = (record_ref_t *)malloc(
+            sizeof(record_ref_t) * match_count);
+        assert(entry->matches != NULL);
+        memcpy(entry->matches, matches->data,
+            sizeof(record_ref_t) * match_count);
+    }
+    entry->path = path_copy(path);
+    entry->bytes = bytes;
+
+    // STEP 4: Chain it into it's bucket as the MOST recently used
+    range_cache_entry_t **bucket =
+        &cache->buckets[hash & (cache->bucket_count - 1)];
+    entry->chain = *bucket;
+    *bucket = entry;
+    range_cache_push(cache, entry);
+    cache->bytes += bytes;
+    cache->entries++;
+
+    // STEP 5: Keep at most ONE entry per bucket on average
+    if (cache->entries > (unsigned long)cache->bucket_count) {
+        range_cache_grow(cache);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - EVICTS the LEAST recently used entry
+ * @param[out]  cache   The cache (with at least ONE entry)
+*/
+void
+range_cache_evict(range_cache_t *cache) {
+
+    // STEP 1: Unchain the entry from it's bucket
+    range_cache_entry_t *entry = cache->oldest;
+    assert(entry != NULL);
+    range_cache_entry_t **link =
+        &cache->buckets[entry->hash & (cache->bucket_count - 1)];
+    while (*link != entry) {
+        link = &(*link)->chain;
+    }
+    *link = entry->chain;
+
+    // STEP 2: Free it
+    range_cache_unlink(cache, entry);
+    cache->bytes -= entry->bytes;
+    cache->entries--;
+    path_free(entry->path);
+    free(entry->matches);
+    free(entry);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - REMOVES an entry from the order of use
+ * @param[out]  cache   The cache
+ * @param[out]  entry   The entry
+*/
+void
+range_cache_unlink(range_cache_t *cache, range_cache_entry_t *entry) {
+    if (entry->newer != NULL) {
+        entry->newer->older = entry->older;
+    } else {
+        cache->newest = entry->older;
+    }
+    if (entry->older != NULL) {
+        entry->older->newer = entry->newer;
+    } else {
+        cache->oldest = entry->newer;
+    }
+    entry->newer = entry->older = NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - MAKES an (unlinked) entry the MOST recently used
+ * @param[out]  cache   The cache
+ * @param[out]  entry   The entry
+*/
+void
+range_cache_push(range_cache_t *cache, range_cache_entry_t *entry) {
+    entry->newer = NULL;
+    entry->older = cache->newest;
+    if (cache->newest != NULL) {
+        cache->newest->newer = entry;
+    } else {
+        cache->oldest = entry;
+    }
+    cache->newest = entry;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - DOUBLES the buckets of the cache's table
+ * @param[out]  cache   The cache
+*/
+void
+range_cache_grow(range_cache_t *cache) {
+    int size = cache->bucket_count * REALLOC_FACTOR;
+    range_cache_entry_t **buckets = (range_cache_entry_t **)calloc(size,
+        sizeof(range_cache_entry_t *));
+    assert(buckets != NULL);
+    for (range_cache_entry_t *entry = cache->newest; entry != NULL;
+        entry = entry->older) {
+        range_cache_entry_t **bucket = &buckets[entry->hash & (size - 1)];
+        entry->chain = *bucket;
+        *bucket = entry;
+    }
+    free(cache->buckets);
+    cache->buckets = buckets;
+    cache->bucket_count = size;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - COPIES the matches of an entry
+ * @param[in]   entry   The entry
+ * @return      A heap-allocated array_t of the matches, & NULL if there are
+ *              none
+*/
+array_t*
+range_cache_matches(range_cache_entry_t *entry) {
+    if (entry->match_count == 0) {
+        return NULL;
+    }
+    array_t *matches = array_init();
+    free(matches->data);
+    matches->data = (record_ref_t *)malloc(
+        sizeof(record_ref_t) * entry->match_count);
+    assert(matches->data != NULL);
+    memcpy(matches->data, entry->matches,
+        sizeof(record_ref_t) * entry->match_count);
+    matches->logical_size = matches->physical_size = entry->match_count;
+    return matches;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file    range-cache.h
+ * @brief   A HEADER file for the implementation of a cache of range query
+ *          results
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          Repeated range queries (e.g. dashboards polling the SAME boxes)
+ *          are answered from a bounded cache keyed on the QUANTISED range.
+ *          Each entry keeps the range's de-duplicated matches & the path it
+ *          traversed, & the LEAST recently used entries are evicted once
+ *          the entries outgrow the cache's budget of bytes. The cache is
+ *          only valid whilst the quad-tree is NOT modified
+*/
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#ifndef _RANGE_CACHE_H_
+#define _RANGE_CACHE_H_
+
+#define RANGE_CACHE_INIT_BUCKETS 64     // Buckets of a new cache's table
+
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT FILES
+#include <stddef.h>
+#include <stdint.h>
+
+#include "coordinates.h"
+#include "dynamic-array.h"
+#include "path.h"
+#include "quad-tree.h"
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   The cached result of ONE range
+ * @param   bl          The BOTTOM-LEFT (quantised) corner of the range
+ * @param   tr          The TOP-RIGHT (quantised) corner of the range
+ * @param   hash        The hash of the range
+ * @param   matches     The range's matches (in footpath_id order)
+ * @param   match_count The number of matches (0 if nothing matched)
+ * @param   path        The quadrants the range traversed
+ * @param   bytes       The heap bytes the entry holds
+ * @param   chain       The next entry in the SAME bucket
+ * @param   newer       The entry used just AFTER this one
+ * @param   older       The entry used just BEFORE this one
+*/
+typedef struct range_cache_entry range_cache_entry_t;
+struct range_cache_entry {
+    point_2d_t      bl;
+    point_2d_t      tr;
+    uint64_t        hash;
+    record_ref_t    *matches;
+    int             match_count;
+    path_t          *path;
+    size_t          bytes;
+    range_cache_entry_t *chain;
+    range_cache_entry_t *newer;
+    range_cache_entry_t *older;
+};
+
+/**
+ * @brief   A bounded, LEAST recently used cache of range query results
+ * @param   buckets     A table of chains of entries, indexed by hash
+ * @param   bucket_count    The number of buckets (a power of 2)
+ * @param   newest      The MOST recently used entry
+ * @param   oldest      The LEAST recently used entry (evicted 1st)
+ * @param   scratch     Where a missed range's path is tracked
+ * @param   budget      The MOST bytes the entries may hold
+ * @param   bytes       The bytes the entries hold
+ * @param   entries     The number of entries
+ * @param   hits        The ranges answered from the cache
+ * @param   misses      The ranges answered from the quad-tree
+ * @param   evictions   The entries evicted to make room for others
+*/
+typedef struct range_cache range_cache_t;
+struct range_cache {
+    range_cache_entry_t **buckets;
+    int             bucket_count;
+    range_cache_entry_t *newest;
+    range_cache_entry_t *oldest;
+    path_t          *scratch;
+    size_t          budget;
+    size_t          bytes;
+    unsigned long   entries;
+    unsigned long   hits;
+    unsigned long   misses;
+    unsigned long   evictions;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// RANGE CACHE OPERATIONS:
+
+/**
+ * @brief       INITIALISES an EMPTY cache on the heap
+ * @param[in]   budget  The MOST bytes the entries may hold
+ * @return      A POINTER to a heap-allocated range_cache_t
+*/
+range_cache_t* range_cache_init(size_t budget);
+
+/**
+ * @brief       FINDS all the points within a RANGE (as qt_range_query()
+ *              does), answering from the cache if the range is in it, &
+ *              caching the result otherwise
+ * @param[out]  cache   The cache
+ * @param[in]   tree    The quad-tree to query on a miss
+ * @param[out]  path    The quadrants traversed (& NULL to skip tracking them)
+ * @param[in]   range   The bounded rectangle that defines the range
+ * @return      A heap-allocated array_t of the matches (owned by the caller),
+ *              & NULL if nothing matched
+*/
+array_t* range_cache_query(range_cache_t *cache, qt_tree_t *tree,
+    path_t *path, rectangle_t *range);
+
+/**
+ * @brief       EVICTS every entry (e.g. once the quad-tree is modified)
+ * @param[out]  cache   The cache
+*/
+void range_cache_clear(range_cache_t *cache);
+
+/**
+ * @brief       FREES the cache (& every entry) from the heap
+ * @param[out]  cache   The cache to free
+*/
+void range_cache_free(range_cache_t *cache);
+
+#endif
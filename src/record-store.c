@@ -0,0 +1,534 @@
+/**
+ * @file    record-store.c
+ * @brief   A file for the implementation of a COLUMNAR record store
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#include "record-store.h"
+#include "dynamic-array.h"
+
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#define STORE_HASH_SEED 0xcbf29ce484222325ULL   // FNV-1a offset basis
+#define STORE_HASH_PRIME 0x100000001b3ULL       // FNV-1a prime
+#define STORE_INIT_TABLE 64         // Initial slots of the dictionary's table
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+void* record_store_resize(void *array, size_t size);
+void record_store_grow(record_store_t *store);
+uint64_t record_store_text_append(char **text, uint64_t *capacity,
+    uint64_t used, const char *characters, int length);
+int record_store_intern(record_store_t *store, const char *text, int length);
+void record_store_rehash(record_store_t *store);
+uint64_t record_store_hash(const char *text, int length);
+const char* record_store_word(record_store_t *store, int code, int *length);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       INITIALISES an EMPTY record store
+ * @param[in]   capacity    The number of records to make room for (the store
+ *                          grows beyond it if needed)
+ * @return      A POINTER to a heap-allocated record store
+*/
+record_store_t*
+record_store_init(int capacity) {
+
+    // STEP 1: Every column starts EMPTY (with room for 'capacity' records)
+    record_store_t *new_store = (record_store_t *)calloc(1,
+        sizeof(record_store_t));
+    assert(new_store != NULL);
+    new_store->owner = 1;
+    new_store->capacity = 0;
+    new_store->address_start = (uint64_t *)record_store_resize(NULL,
+        sizeof(uint64_t));
+    new_store->address_start[0] = 0;
+    new_store->address_capacity = STORE_INIT_CAPACITY;
+    new_store->address_text = (char *)record_store_resize(NULL,
+        STORE_INIT_CAPACITY);
+    while (new_store->capacity < capacity) record_store_grow(new_store);
+
+    // STEP 2: As does the dictionary
+    new_store->dict_table_size = STORE_INIT_TABLE;
+    new_store->dict_table = (int *)record_store_resize(NULL,
+        sizeof(int) * STORE_INIT_TABLE);
+    for (int i = 0; i < STORE_INIT_TABLE; i++) {
+        new_store->dict_table[i] = STORE_EMPTY_SLOT;
+    }
+    new_store->dict_start = (uint64_t *)record_store_resize(NULL,
+        sizeof(uint64_t) * (STORE_INIT_TABLE + 1));
+    new_store->dict_start[0] = 0;
+    new_store->dict_capacity = STORE_INIT_CAPACITY;
+    new_store->dict_text = (char *)record_store_resize(NULL,
+        STORE_INIT_CAPACITY);
+    return new_store;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       APPENDS a record to the store (COPYING it's strings)
+ * @param[out]  store   The record store
+ * @param[in]   base    The 1st byte of the CSV the record was read from
+ * @param[in]   data    The record as read from the CSV
+ * @return      A reference to the new record
+*/
+record_ref_t
+record_store_append(record_store_t *store, const char *base,
+    data_t *data) {
+
+    // STEP 1: Ensure there is room for the record
+    assert(store->owner);
+    if (store->count == store->capacity) record_store_grow(store);
+    int r = store->count++;
+
+    // STEP 2: Pack the address into the arena & intern the other strings
+    store->address_start[r + 1] = record_store_text_append(
+        &store->address_text, &store->address_capacity,
+        store->address_start[r], base + data->address.offset,
+        data->address.length);
+    store->clue_sa[r] = record_store_intern(store,
+        base + data->clue_sa.offset, data->clue_sa.length);
+    store->asset_type[r] = record_store_intern(store,
+        base + data->asset_type.offset,
+        data->asset_type.length);
+    store->segside[r] = record_store_intern(store,
+        base + data->segside.offset, data->segside.length);
+
+    // STEP 3: Copy the numeric fields into their columns
+    store->foothpath_id[r] = data->foothpath_id;
+    store->deltaz[r] = data->deltaz;
+    store->distance[r] = data->distance;
+    store->grade1in[r] = data->grade1in;
+    store->mcc_id[r] = data->mcc_id;
+    store->mccid_int[r] = data->mccid_int;
+    store->rlmax[r] = data->rlmax;
+    store->rlmin[r] = data->rlmin;
+    store->statusid[r] = data->statusid;
+    store->streetid[r] = data->streetid;
+    store->street_group[r] = data->street_group;
+    store->start_lat[r] = data->start_lat;
+    store->start_lon[r] = data->start_lon;
+    store->end_lat[r] = data->end_lat;
+    store->end_lon[r] = data->end_lon;
+
+    record_ref_t ref = {data->foothpath_id, r};
+    return ref;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       PRINTS a record (in the SAME format as the original data_t)
+ * @param[in]   output_file The file to print to
+ * @param[in]   store       The record store
+ * @param[in]   record      The record's number
+ * @note        Printing MANY records is faster via record_store_format()
+*/
+void
+record_store_print(FILE *output_file, record_store_t *store, int record) {
+    format_buffer_t *buffer = format_init();
+    record_store_format(buffer, store, record);
+    format_flush(buffer, output_file);
+    format_free(buffer);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       RENDERS a record (in the SAME format as record_store_print())
+ *              onto the end of a buffer
+ * @param[out]  buffer  The buffer
+ * @param[in]   store   The record store
+ * @param[in]   record  The record's number
+*/
+void
+record_store_format(format_buffer_t *buffer, record_store_t *store, 
+    int record) {
+
+    int r = record, clue_sa_length, asset_type_length, segside_length;
+    const char *clue_sa = record_store_word(store, store->clue_sa[r],
+        &clue_sa_length);
+    const char *asset_type = record_store_word(store, store->asset_type[r],
+        &asset_type_length);
+    const char *segside = record_store_word(store, store->segside[r],
+        &segside_length);
+
+    format_literal(buffer, "--> footpath_id: ");
+    format_int(buffer, store->foothpath_id[r]);
+    format_literal(buffer, " || address: ");
+    format_text(buffer, store->address_text + store->address_start[r],
+        store->address_start[r + 1] - store->address_start[r]);
+    format_literal(buffer, " || clue_sa: ");
+    format_text(buffer, clue_sa, clue_sa_length);
+    format_literal(buffer, " || asset_type: ");
+    format_text(buffer, asset_type, asset_type_length);
+    format_literal(buffer, " || deltaz: ");
+    format_fixed(buffer, store->deltaz[r], 2);
+    format_literal(buffer, " || distance: ");
+    format_fixed(buffer, store->distance[r], 2);
+    format_literal(buffer, " || grade1in: ");
+    format_fixed(buffer, store->grade1in[r], 1);
+    format_literal(buffer, " || mcc_id: ");
+    format_fixed(buffer, store->mcc_id[r], 0);
+    format_literal(buffer, " || mccid_int: ");
+    format_int(buffer, store->mccid_int[r]);
+    format_literal(buffer, " || rlmax: ");
+    format_fixed(buffer, store->rlmax[r], 2);
+    format_literal(buffer, " || rlmin: ");
+    format_fixed(buffer, store->rlmin[r], 2);
+    format_literal(buffer, " || segside: ");
+    format_text(buffer, segside, segside_length);
+    format_literal(buffer, " || statusid: ");
+    format_int(buffer, store->statusid[r]);
+    format_literal(buffer, " || streetid: ");
+    format_int(buffer, store->streetid[r]);
+    format_literal(buffer, " || street_group: ");
+    format_int(buffer, store->street_group[r]);
+    format_literal(buffer, " || start_lat: ");
+    format_fixed(buffer, store->start_lat[r], 6);
+    format_literal(buffer, " || start_lon: ");
+    format_fixed(buffer, store->start_lon[r], 6);
+    format_literal(buffer, " || end_lat: ");
+    format_fixed(buffer, store->end_lat[r], 6);
+    format_literal(buffer, " || end_lon: ");
+    format_fixed(buffer, store->end_lon[r], 6);
+    format_literal(buffer, " || \n");
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       LISTS the arrays of a store, so they can be written out as is
+ * @param[in]   store   The record store
+ * @param[out]  columns Filled with STORE_COLUMNS arrays (in a FIXED order)
+*/
+void
+record_store_columns(record_store_t *store, store_column_t *columns) {
+
+    uint64_t n = store->count, d = store->dict_count;
+    uint64_t reals = n * sizeof(long double), ints = n * sizeof(int);
+    uint64_t codes = n * sizeof(uint16_t);
+    store_column_t list[STORE_COLUMNS] = {
+        {store->foothpath_id, ints},
+        {store->address_start, (n + 1) * sizeof(uint64_t)},
+        {store->address_text, store->address_start[n]},
+        {store->clue_sa, codes},
+        {store->asset_type, codes},
+        {store->deltaz, reals},
+        {store->distance, reals},
+        {store->grade1in, reals},
+        {store->mcc_id, reals},
+        {store->mccid_int, ints},
+        {store->rlmax, reals},
+        {store->rlmin, reals},
+        {store->segside, codes},
+        {store->statusid, ints},
+        {store->streetid, ints},
+        {store->street_group, ints},
+        {store->start_lat, reals},
+        {store->start_lon, reals},
+        {store->end_lat, reals},
+        {store->end_lon, reals},
+        {store->dict_start, (d + 1) * sizeof(uint64_t)},
+        {store->dict_text, store->dict_start[d]}
+    };
+    memcpy(columns, list, sizeof(list));
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       WRAPS arrays listed by record_store_columns() as a READ-ONLY
+ *              store, WITHOUT copying them
+ * @param[in]   columns     STORE_COLUMNS arrays (in the SAME order)
+ * @param[in]   count       The number of records
+ * @param[in]   dict_count  The number of DISTINCT dictionary strings
+ * @return      A POINTER to a heap-allocated record store, & NULL if a
+ *              column's size is INCONSISTENT with the counts
+*/
+record_store_t*
+record_store_view(store_column_t *columns, int count, int dict_count) {
+
+    // STEP 1: The offset columns must be checked BEFORE they are read
+    if ((count < 0) || (dict_count < 0)
+        || (columns[1].size != ((uint64_t)count + 1) * sizeof(uint64_t))
+        || (columns[20].size != ((uint64_t)dict_count + 1)
+            * sizeof(uint64_t))) {
+        return NULL;
+    }
+
+    // STEP 2: Point every column of the view at the arrays
+    record_store_t *view = (record_store_t *)calloc(1,
+        sizeof(record_store_t));
+    assert(view != NULL);
+    view->count = view->capacity = count;
+    view->dict_count = dict_count;
+    view->owner = 0;
+    view->foothpath_id = (int *)columns[0].data;
+    view->address_start = (uint64_t *)columns[1].data;
+    view->address_text = (char *)columns[2].data;
+    view->clue_sa = (uint16_t *)columns[3].data;
+    view->asset_type = (uint16_t *)columns[4].data;
+    view->deltaz = (long double *)columns[5].data;
+    view->distance = (long double *)columns[6].data;
+    view->grade1in = (long double *)columns[7].data;
+    view->mcc_id = (long double *)columns[8].data;
+    view->mccid_int = (int *)columns[9].data;
+    view->rlmax = (long double *)columns[10].data;
+    view->rlmin = (long double *)columns[11].data;
+    view->segside = (uint16_t *)columns[12].data;
+    view->statusid = (int *)columns[13].data;
+    view->streetid = (int *)columns[14].data;
+    view->street_group = (int *)columns[15].data;
+    view->start_lat = (long double *)columns[16].data;
+    view->start_lon = (long double *)columns[17].data;
+    view->end_lat = (long double *)columns[18].data;
+    view->end_lon = (long double *)columns[19].data;
+    view->dict_start = (uint64_t *)columns[20].data;
+    view->dict_text = (char *)columns[21].data;
+
+    // STEP 3: Every column must be EXACTLY the size the counts imply
+    store_column_t expected[STORE_COLUMNS];
+    record_store_columns(view, expected);
+    for (int i = 0; i < STORE_COLUMNS; i++) {
+        if (expected[i].size != columns[i].size) {
+            free(view);
+            return NULL;
+        }
+    }
+    return view;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       MEASURES the heap bytes a record store's columns hold
+ * @param[in]   store   The record store
+ * @return      The bytes held, & 0 for a view (whose arrays belong to
+ *              whatever it wraps)
+*/
+size_t
+record_store_bytes(record_store_t *store) {
+
+    // NOTE: the columns have room for 'capacity' records, whilst the text
+    //       arenas & the dictionary grow separately
+    if (! store->owner) {
+        return 0;
+    }
+    size_t record = 8 * sizeof(long double) + 5 * sizeof(int) 
+        + 3 * sizeof(uint16_t);
+    return record * store->capacity 
+        + sizeof(uint64_t) * (store->capacity + 1) + store->address_capacity
+        + sizeof(int) * store->dict_table_size
+        + sizeof(uint64_t) * (store->dict_table_size + 1) 
+        + store->dict_capacity;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       FREES a record store from the heap
+ * @param[out]  store   The record store to free
+*/
+void
+record_store_free(record_store_t *store) {
+
+    // NOTE: a view's arrays belong to whatever it wraps
+    if (store->owner) {
+        store_column_t columns[STORE_COLUMNS];
+        record_store_columns(store, columns);
+        for (int i = 0; i < STORE_COLUMNS; i++) free(columns[i].data);
+        free(store->dict_table);
+    }
+    free(store);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - RESIZES a heap-allocated array
+ * @param[out]  array   The array to resize (or NULL to allocate a new one)
+ * @param[in]   size    The new size (in bytes)
+ * @return      A pointer to the resized array
+*/
+void*
+record_store_resize(void *array, size_t size) {
+    array = realloc(array, size > 0 ? size : 1);
+    assert(array != NULL);
+    return array;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - DOUBLES the number of records a store has room for
+ * @param[out]  store   The record store
+*/
+void
+record_store_grow(record_store_t *store) {
+
+    int c = store->capacity ? store->capacity * REALLOC_FACTOR
+        : STORE_INIT_CAPACITY;
+    size_t reals = sizeof(long double) * c, ints = sizeof(int) * c;
+    size_t codes = sizeof(uint16_t) * c;
+    store->foothpath_id = record_store_resize(store->foothpath_id, ints);
+    store->address_start = record_store_resize(store->address_start,
+        sizeof(uint64_t) * (c + 1));
+    store->clue_sa = record_store_resize(store->clue_sa, codes);
+    store->asset_type = record_store_resize(store->asset_type, codes);
+    store->deltaz = record_store_resize(store->deltaz, reals);
+    store->distance = record_store_resize(store->distance, reals);
+    store->grade1in = record_store_resize(store->grade1in, reals);
+    store->mcc_id = record_store_resize(store->mcc_id, reals);
+    store->mccid_int = record_store_resize(store->mccid_int, ints);
+    store->rlmax = record_store_resize(store->rlmax, reals);
+    store->rlmin = record_store_resize(store->rlmin, reals);
+    store->segside = record_store_resize(store->segside, codes);
+    store->statusid = record_store_resize(store->statusid, ints);
+    store->streetid = record_store_resize(store->streetid, ints);
+    store->street_group = record_store_resize(store->street_group, ints);
+    store->start_lat = record_store_resize(store->start_lat, reals);
+    store->start_lon = record_store_resize(store->start_lon, reals);
+    store->end_lat = record_store_resize(store->end_lat, reals);
+    store->end_lon = record_store_resize(store->end_lon, reals);
+    store->capacity = c;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - APPENDS characters to a text arena
+ * @param[out]  text        The arena (grown when full)
+ * @param[out]  capacity    The number of characters the arena has room for
+ * @param[in]   used        The number of characters already in the arena
+ * @param[in]   characters  The characters to append
+ * @param[in]   length      The number of characters
+ * @return      The number of characters in the arena afterwards
+*/
+uint64_t
+record_store_text_append(char **text, uint64_t *capacity, uint64_t used,
+    const char *characters, int length) {
+
+    if (used + length > *capacity) {
+        while (used + length > *capacity) {
+            *capacity = *capacity ? *capacity * REALLOC_FACTOR
+                : STORE_INIT_CAPACITY;
+        }
+        *text = record_store_resize(*text, *capacity);
+    }
+    if (length > 0) memcpy(*text + used, characters, length);
+    return used + length;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - INTERNS a string into the store's dictionary
+ * @param[out]  store   The record store
+ * @param[in]   text    The string's characters
+ * @param[in]   length  The number of characters
+ * @return      The string's code (the SAME for every equal string)
+*/
+int
+record_store_intern(record_store_t *store, const char *text, int length) {
+
+    // STEP 1: Probe for an EQUAL string that is already interned
+    int mask = store->dict_table_size - 1;
+    int slot = (int)(record_store_hash(text, length) & mask);
+    for (; store->dict_table[slot] != STORE_EMPTY_SLOT;
+        slot = (slot + 1) & mask) {
+        int code = store->dict_table[slot], code_length;
+        const char *word = record_store_word(store, code, &code_length);
+        if ((code_length == length) && (memcmp(word, text, length) == 0)) {
+            return code;
+        }
+    }
+
+    // STEP 2: Otherwise give it the next code
+    assert(store->dict_count < STORE_MAX_CODES);
+    int code = store->dict_count++;
+    store->dict_start[code + 1] = record_store_text_append(
+        &store->dict_text, &store->dict_capacity, store->dict_start[code],
+        text, length);
+    store->dict_table[slot] = code;
+
+    // STEP 3: Keep the table at most HALF full
+    if (store->dict_count * 2 > store->dict_table_size) {
+        record_store_rehash(store);
+    }
+    return code;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - DOUBLES the slots of the dictionary's hash table
+ * @param[out]  store   The record store
+*/
+void
+record_store_rehash(record_store_t *store) {
+
+    // STEP 1: Make a larger EMPTY table (& room for as many codes)
+    int size = store->dict_table_size * REALLOC_FACTOR;
+    free(store->dict_table);
+    store->dict_table = (int *)record_store_resize(NULL, sizeof(int) * size);
+    for (int i = 0; i < size; i++) store->dict_table[i] = STORE_EMPTY_SLOT;
+    store->dict_table_size = size;
+    store->dict_start = record_store_resize(store->dict_start,
+        sizeof(uint64_t) * (size + 1));
+
+    // STEP 2: Re-insert every code
+    for (int code = 0; code < store->dict_count; code++) {
+        int length;
+        const char *word = record_store_word(store, code, &length);
+        int slot = (int)(record_store_hash(word, length) & (size - 1));
+        while (store->dict_table[slot] != STORE_EMPTY_SLOT) {
+            slot = (slot + 1) & (size - 1);
+        }
+        store->dict_table[slot] = code;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - HASHES a string (FNV-1a)
+ * @param[in]   text    The string's characters
+ * @param[in]   length  The number of characters
+ * @return      A 64-bit hash
+*/
+uint64_t
+record_store_hash(const char *text, int length) {
+    uint64_t hash = STORE_HASH_SEED;
+    for (int i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char)text[i]) * STORE_HASH_PRIME;
+    }
+    return hash;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - LOOKS UP the string a dictionary code stands for
+ * @param[in]   store   The record store
+ * @param[in]   code    The code
+ * @param[out]  length  The number of characters in the string
+ * @return      A pointer to the string's (NOT terminated) characters
+*/
+const char*
+record_store_word(record_store_t *store, int code, int *length) {
+    *length = (int)(store->dict_start[code + 1] - store->dict_start[code]);
+    return store->dict_text + store->dict_start[code];
+}
@@ -0,0 +1,191 @@
+/**
+ * @file    record-store.h
+ * @brief   A HEADER file for a COLUMNAR store of the Melbourne CSV records
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          Every field of a record is kept in it's OWN array (indexed by the
+ *          record's number), so a query that only needs the footpath_id
+ *          never touches the other fields. The low-cardinality strings
+ *          (clue_sa, asset_type & segside) are interned into ONE dictionary
+ *          & stored as small codes, whilst the address text is packed
+ *          back-to-back into a single arena
+*/
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#ifndef _RECORD_STORE_H_
+#define _RECORD_STORE_H_
+
+#define STORE_INIT_CAPACITY 1024    // Initial number of records (or bytes)
+#define STORE_MAX_CODES 65536       // DISTINCT strings a uint16_t code covers
+#define STORE_EMPTY_SLOT -1         // Marks an UNUSED slot of the hash table
+#define STORE_COLUMNS 22            // The arrays making up a record store
+
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT FILES
+#include <stdio.h>
+#include <stdint.h>
+
+#include "data.h"
+#include "format.h"
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   A REFERENCE to a record, as stored in the quad-tree
+ * @param   foothpath_id    The record's footpath_id (items are sorted &
+ *                          de-duplicated by it WITHOUT visiting the store)
+ * @param   record          The record's number in the store
+*/
+typedef struct record_ref record_ref_t;
+struct record_ref {
+    int             foothpath_id;
+    int             record;
+};
+
+/**
+ * @brief   ONE array of a record store (see record_store_columns())
+ * @param   data    The 1st byte of the array
+ * @param   size    The number of bytes in the array
+*/
+typedef struct store_column store_column_t;
+struct store_column {
+    void            *data;
+    uint64_t        size;
+};
+
+/**
+ * @brief   A COLUMNAR store of records
+ * @param   count           The number of records
+ * @param   capacity        The number of records there is room for
+ * @param   foothpath_id    The footpath_id of each record
+ * @param   address_start   Where each address starts in address_text (with
+ *                          ONE extra entry marking the end of the last)
+ * @param   address_text    The characters of every address, back-to-back
+ * @param   address_capacity    The number of characters there is room for
+ * @param   clue_sa         The dictionary code of each clue_sa (as are
+ *                          asset_type & segside)
+ * @param   dict_count      The number of DISTINCT strings in the dictionary
+ * @param   dict_start      Where each string starts in dict_text (with ONE
+ *                          extra entry marking the end of the last)
+ * @param   dict_text       The characters of every dictionary string
+ * @param   dict_capacity   The number of characters there is room for
+ * @param   dict_table      An open-addressing hash table of codes, used to
+ *                          intern strings (NULL for a read-only view)
+ * @param   dict_table_size The number of slots in dict_table
+ * @param   owner           Whether the arrays are freed with the store
+ * @note    The remaining fields have ONE array each, named after the field
+*/
+typedef struct record_store record_store_t;
+struct record_store {
+    int             count;
+    int             capacity;
+    int             *foothpath_id;
+    uint64_t        *address_start;
+    char            *address_text;
+    uint64_t        address_capacity;
+    uint16_t        *clue_sa;
+    uint16_t        *asset_type;
+    long double     *deltaz;
+    long double     *distance;
+    long double     *grade1in;
+    long double     *mcc_id;
+    int             *mccid_int;
+    long double     *rlmax;
+    long double     *rlmin;
+    uint16_t        *segside;
+    int             *statusid;
+    int             *streetid;
+    int             *street_group;
+    long double     *start_lat;
+    long double     *start_lon;
+    long double     *end_lat;
+    long double     *end_lon;
+    int             dict_count;
+    uint64_t        *dict_start;
+    char            *dict_text;
+    uint64_t        dict_capacity;
+    int             *dict_table;
+    int             dict_table_size;
+    int             owner;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// RECORD STORE OPERATIONS:
+
+/**
+ * @brief       INITIALISES an EMPTY record store
+ * @param[in]   capacity    The number of records to make room for (the store
+ *                          grows beyond it if needed)
+ * @return      A POINTER to a heap-allocated record store
+*/
+record_store_t* record_store_init(int capacity);
+
+/**
+ * @brief       APPENDS a record to the store (COPYING it's strings)
+ * @param[out]  store   The record store
+ * @param[in]   base    The 1st byte of the CSV the record was read from
+ * @param[in]   data    The record as read from the CSV
+ * @return      A reference to the new record
+*/
+record_ref_t record_store_append(record_store_t *store, const char *base,
+    data_t *data);
+
+/**
+ * @brief       PRINTS a record (in the SAME format as the original data_t)
+ * @param[in]   output_file The file to print to
+ * @param[in]   store       The record store
+ * @param[in]   record      The record's number
+ * @note        Printing MANY records is faster via record_store_format()
+*/
+void record_store_print(FILE *output_file, record_store_t *store, int record);
+
+/**
+ * @brief       RENDERS a record (in the SAME format as record_store_print())
+ *              onto the end of a buffer
+ * @param[out]  buffer  The buffer
+ * @param[in]   store   The record store
+ * @param[in]   record  The record's number
+*/
+void record_store_format(format_buffer_t *buffer, record_store_t *store, 
+    int record);
+
+/**
+ * @brief       LISTS the arrays of a store, so they can be written out as is
+ * @param[in]   store   The record store
+ * @param[out]  columns Filled with STORE_COLUMNS arrays (in a FIXED order)
+*/
+void record_store_columns(record_store_t *store, store_column_t *columns);
+
+/**
+ * @brief       WRAPS arrays listed by record_store_columns() as a READ-ONLY
+ *              store, WITHOUT copying them
+ * @param[in]   columns     STORE_COLUMNS arrays (in the SAME order)
+ * @param[in]   count       The number of records
+ * @param[in]   dict_count  The number of DISTINCT dictionary strings
+ * @return      A POINTER to a heap-allocated record store, & NULL if a
+ *              column's size is INCONSISTENT with the counts
+*/
+record_store_t* record_store_view(store_column_t *columns, int count,
+    int dict_count);
+
+/**
+ * @brief       MEASURES the heap bytes a record store's columns hold
+ * @param[in]   store   The record store
+ * @return      The bytes held, & 0 for a view (whose arrays belong to
+ *              whatever it wraps)
+*/
+size_t record_store_bytes(record_store_t *store);
+
+/**
+ * @brief       FREES a record store from the heap
+ * @param[out]  store   The record store to free
+*/
+void record_store_free(record_store_t *store);
+
+#endif
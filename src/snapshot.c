@@ -0,0 +1,349 @@
+/**
+ * @file    snapshot.c
+ * @brief   A file for the implementation of a binary snapshot of a quad-tree
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "snapshot.h"
+
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#define SNAPSHOT_TMP_SUFFIX ".tmp"  // Written first, then renamed over
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+uint64_t snapshot_align(uint64_t offset);
+int snapshot_write(FILE *file, const void *bytes, size_t size,
+    uint64_t *written);
+int snapshot_pad(FILE *file, uint64_t offset, uint64_t *written);
+int snapshot_is_valid(snapshot_header_t *header, size_t size);
+int snapshot_key_matches(snapshot_key_t *k1, snapshot_key_t *k2);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       DESCRIBES what a snapshot of the current invocation is built
+ *              from
+ * @param[in]   csv             The source CSV
+ * @param[in]   root_bl_x       The root's bottom-left x
+ * @param[in]   root_bl_y       The root's bottom-left y
+ * @param[in]   root_tr_x       The root's top-right x
+ * @param[in]   root_tr_y       The root's top-right y
+ * @param[in]   leaf_capacity   The DISTINCT points a leaf holds
+ * @param[in]   max_depth       The depth at which leaves stop splitting
+ * @return      The key to save (or check) a snapshot with
+*/
+snapshot_key_t
+snapshot_key_init(csv_file_t *csv, long double root_bl_x,
+    long double root_bl_y, long double root_tr_x, long double root_tr_y,
+    int leaf_capacity, int max_depth) {
+
+    // NOTE: zeroed so the padding of the key is deterministic on disk
+    snapshot_key_t key;
+    memset(&key, 0, sizeof(snapshot_key_t));
+    key.csv_size = csv->size;
+    key.csv_checksum = csv_checksum(csv);
+    key.root_bl_x = root_bl_x;
+    key.root_bl_y = root_bl_y;
+    key.root_tr_x = root_tr_x;
+    key.root_tr_y = root_tr_y;
+    key.leaf_capacity = leaf_capacity;
+    key.max_depth = max_depth;
+    return key;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       SAVES a built quad-tree & it's records as a snapshot
+ * @param[in]   filename    The path of the snapshot to (over)write
+ * @param[in]   key         What the quad-tree was built from
+ * @param[out]  tree        The quad-tree (it is LINEARISED if it isn't 
+ *                          already)
+ * @param[in]   store       The records the quad-tree's items refer to
+ * @return      An integer flag where: 0 means the quad-tree is too deep to
+ *              linearise or the file could not be written & 1 means
+ *              SUCCESSFUL
+*/
+int
+snapshot_save(const char *filename, snapshot_key_t *key, qt_tree_t *tree,
+    record_store_t *store) {
+
+    // STEP 1: Only the (pointer-free) LINEAR backend can be saved
+    if ((tree->linear == NULL) && (! qt_linearise(tree))) {
+        return UNSUCCESSFUL;
+    }
+    lqt_t *lqt = tree->linear;
+
+    // STEP 2: Lay out the sections one after the other
+    snapshot_header_t header;
+    memset(&header, 0, sizeof(snapshot_header_t));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.coord_mode = COORD_MODE;
+    header.entry_size = sizeof(lqt_entry_t);
+    header.item_size = sizeof(record_ref_t);
+    header.key = *key;
+    header.bounds = tree->bounds;
+    header.entry_offset = snapshot_align(sizeof(snapshot_header_t));
+    header.entry_count = lqt->entry_count;
+    header.item_offset = snapshot_align(header.entry_offset
+        + header.entry_count * sizeof(lqt_entry_t));
+    header.item_count = lqt->item_count;
+    header.record_count = store->count;
+    header.dict_count = store->dict_count;
+    store_column_t columns[STORE_COLUMNS];
+    record_store_columns(store, columns);
+    uint64_t end = header.item_offset 
+        + header.item_count * sizeof(record_ref_t);
+    for (int i = 0; i < STORE_COLUMNS; i++) {
+        header.column_offset[i] = snapshot_align(end);
+        header.column_size[i] = columns[i].size;
+        end = header.column_offset[i] + columns[i].size;
+    }
+
+    // STEP 3: Write a TEMPORARY file, so a reader never maps a partial one
+    char *tmp_name = (char *)malloc(strlen(filename)
+        + sizeof(SNAPSHOT_TMP_SUFFIX));
+    assert(tmp_name != NULL);
+    sprintf(tmp_name, "%s%s", filename, SNAPSHOT_TMP_SUFFIX);
+    FILE *file = fopen(tmp_name, "wb");
+    uint64_t written = 0;
+    int status = (file != NULL)
+        && snapshot_write(file, &header, sizeof(header), &written);
+
+    // STEP 3A: The entries (copied so their padding is ALWAYS zero)
+    status = status && snapshot_pad(file, header.entry_offset, &written);
+    for (int i = 0; status && (i < lqt->entry_count); i++) {
+        lqt_entry_t entry;
+        memset(&entry, 0, sizeof(lqt_entry_t));
+        entry.key = lqt->entries[i].key;
+        entry.depth = lqt->entries[i].depth;
+        entry.first_item = lqt->entries[i].first_item;
+        entry.item_count = lqt->entries[i].item_count;
+        entry.point = lqt->entries[i].point;
+        status = snapshot_write(file, &entry, sizeof(entry), &written);
+    }
+
+    // STEP 3B: The items & the columns of the store, exactly as they are
+    status = status && snapshot_pad(file, header.item_offset, &written)
+        && snapshot_write(file, lqt->items, 
+            header.item_count * sizeof(record_ref_t), &written);
+    for (int i = 0; status && (i < STORE_COLUMNS); i++) {
+        status = snapshot_pad(file, header.column_offset[i], &written)
+            && snapshot_write(file, columns[i].data, columns[i].size, 
+                &written);
+    }
+
+    // STEP 4: Replace the old snapshot (if any) in ONE step
+    if (file != NULL) status = (fclose(file) == 0) && status;
+    status = status && (rename(tmp_name, filename) == 0);
+    if (! status) remove(tmp_name);
+    free(tmp_name);
+    return status ? SUCCESSFUL : UNSUCCESSFUL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       OPENS a snapshot by mapping it into memory
+ * @param[in]   filename    The path of the snapshot
+ * @param[in]   key         What the snapshot must have been built from
+ * @return      A POINTER to a heap-allocated snapshot, & NULL if the file is
+ *              missing, NOT a snapshot of this version & build, or STALE
+*/
+snapshot_t*
+snapshot_open(const char *filename, snapshot_key_t *key) {
+
+    // STEP 1: Map the ENTIRE file
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat info;
+    if ((fstat(fd, &info) < 0)
+        || ((size_t)info.st_size < sizeof(snapshot_header_t))) {
+        close(fd);
+        return NULL;
+    }
+    void *mapping = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) return NULL;
+
+    // STEP 2: Reject it unless it was written by THIS build from the SAME
+    //         CSV, root & tree parameters
+    snapshot_header_t *header = (snapshot_header_t *)mapping;
+    if ((! snapshot_is_valid(header, info.st_size))
+        || (! snapshot_key_matches(&header->key, key))) {
+        munmap(mapping, info.st_size);
+        return NULL;
+    }
+
+    // STEP 3: The store's columns must be consistent with it's counts
+    const char *base = (const char *)mapping;
+    store_column_t columns[STORE_COLUMNS];
+    for (int i = 0; i < STORE_COLUMNS; i++) {
+        columns[i].data = (void *)(base + header->column_offset[i]);
+        columns[i].size = header->column_size[i];
+    }
+    record_store_t *store = record_store_view(columns, 
+        (int)header->record_count, (int)header->dict_count);
+    if (store == NULL) {
+        munmap(mapping, info.st_size);
+        return NULL;
+    }
+
+    // STEP 4: Answer queries straight from the mapping
+    snapshot_t *new_snapshot = (snapshot_t *)malloc(sizeof(snapshot_t));
+    assert(new_snapshot != NULL);
+    new_snapshot->base = base;
+    new_snapshot->size = info.st_size;
+    new_snapshot->store = store;
+    new_snapshot->tree = qt_tree_init(header->bounds, key->leaf_capacity,
+        key->max_depth);
+    new_snapshot->tree->linear = lqt_view(&header->bounds,
+        (lqt_entry_t *)(base + header->entry_offset),
+        (int)header->entry_count,
+        (record_ref_t *)(base + header->item_offset),
+        (int)header->item_count);
+    return new_snapshot;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       CLOSES a snapshot (freeing it's tree & store) & unmaps it
+ * @param[out]  snapshot    The snapshot to close
+*/
+void
+snapshot_close(snapshot_t *snapshot) {
+    qt_free(snapshot->tree);
+    record_store_free(snapshot->store);
+    munmap((void *)snapshot->base, snapshot->size);
+    free(snapshot);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - ROUNDS an offset up to the next section boundary
+ * @param[in]   offset  The offset to round
+ * @return      The smallest multiple of SNAPSHOT_ALIGN that is >= offset
+*/
+uint64_t
+snapshot_align(uint64_t offset) {
+    return (offset + SNAPSHOT_ALIGN - 1) / SNAPSHOT_ALIGN * SNAPSHOT_ALIGN;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - WRITES bytes to a snapshot
+ * @param[out]  file    The snapshot being written
+ * @param[in]   bytes   The bytes to write
+ * @param[in]   size    The number of bytes
+ * @param[out]  written The number of bytes written so far (incremented)
+ * @return      An integer flag where: 0 means UNSUCCESSFUL & 1 means
+ *              SUCCESSFUL
+*/
+int
+snapshot_write(FILE *file, const void *bytes, size_t size,
+    uint64_t *written) {
+    if ((size > 0) && (fwrite(bytes, size, 1, file) != 1)) {
+        return UNSUCCESSFUL;
+    }
+    *written += size;
+    return SUCCESSFUL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - WRITES zeroes up to the start of a section
+ * @param[out]  file    The snapshot being written
+ * @param[in]   offset  Where the next section starts
+ * @param[out]  written The number of bytes written so far (incremented)
+ * @return      An integer flag where: 0 means UNSUCCESSFUL & 1 means
+ *              SUCCESSFUL
+*/
+int
+snapshot_pad(FILE *file, uint64_t offset, uint64_t *written) {
+    static const char zeroes[SNAPSHOT_ALIGN] = {0};
+    assert((offset >= *written) && (offset - *written < SNAPSHOT_ALIGN));
+    return snapshot_write(file, zeroes, offset - *written, written);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - CHECKS a mapped header belongs to this build &
+ *              that EVERY section lies within the file
+ * @param[in]   header  The header of the mapped file
+ * @param[in]   size    The size of the mapped file
+ * @return      An integer flag where: 0 means INVALID & 1 means VALID
+*/
+int
+snapshot_is_valid(snapshot_header_t *header, size_t size) {
+
+    // CASE 1: Written by a DIFFERENT version or build
+    if ((memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+        || (header->version != SNAPSHOT_VERSION)
+        || (header->coord_mode != COORD_MODE)
+        || (header->entry_size != sizeof(lqt_entry_t))
+        || (header->item_size != sizeof(record_ref_t))) {
+        return UNSUCCESSFUL;
+    }
+
+    // CASE 2: A section is too large (or runs off the end of the file)
+    if ((header->entry_count > INT_MAX) || (header->item_count > INT_MAX)
+        || (header->record_count > INT_MAX) 
+        || (header->dict_count > STORE_MAX_CODES)
+        || (header->entry_offset + header->entry_count
+            * sizeof(lqt_entry_t) > size)
+        || (header->item_offset + header->item_count
+            * sizeof(record_ref_t) > size)) {
+        return UNSUCCESSFUL;
+    }
+    for (int i = 0; i < STORE_COLUMNS; i++) {
+        if ((header->column_size[i] > size) 
+            || (header->column_offset[i] % SNAPSHOT_ALIGN != 0)
+            || (header->column_offset[i] + header->column_size[i] > size)) {
+            return UNSUCCESSFUL;
+        }
+    }
+    return SUCCESSFUL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - COMPARES two snapshot keys field by field
+ * @param[in]   k1  The 1st key
+ * @param[in]   k2  The 2nd key
+ * @return      An integer flag where: 0 means they DIFFER & 1 means they
+ *              MATCH
+*/
+int
+snapshot_key_matches(snapshot_key_t *k1, snapshot_key_t *k2) {
+    return (k1->csv_size == k2->csv_size)
+        && (k1->csv_checksum == k2->csv_checksum)
+        && (k1->root_bl_x == k2->root_bl_x)
+        && (k1->root_bl_y == k2->root_bl_y)
+        && (k1->root_tr_x == k2->root_tr_x)
+        && (k1->root_tr_y == k2->root_tr_y)
+        && (k1->leaf_capacity == k2->leaf_capacity)
+        && (k1->max_depth == k2->max_depth);
+}
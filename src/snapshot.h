@@ -0,0 +1,167 @@
+/**
+ * @file    snapshot.h
+ * @brief   A HEADER file for a binary snapshot of a built quad-tree
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          A snapshot holds the LINEAR quad-tree, it's items & the columns of
+ *          the record store in ONE file, laid out as:
+ *
+ *              header | entries | items | column 0 | ... | column N
+ *
+ *          Nothing in the file is a pointer: items are record numbers & the
+ *          strings are OFFSETS into the store's arenas. Hence the file is 
+ *          mapped into memory & queried IN PLACE, with no deserialisation 
+ *          step
+*/
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#ifndef _SNAPSHOT_H_
+#define _SNAPSHOT_H_
+
+#define SNAPSHOT_MAGIC "QTSNAP"     // Identifies a snapshot file
+#define SNAPSHOT_MAGIC_SIZE 8       // Bytes reserved for the magic
+#define SNAPSHOT_VERSION 2          // Bumped whenever the layout changes
+#define SNAPSHOT_ALIGN 16           // Alignment of EVERY section of the file
+
+/* -------------------------------------------------------------------------- */
+
+// RELEVANT HEADER FILES:
+#include <stdint.h>
+
+#include "csv.h"
+#include "quad-tree.h"
+#include "linear-quad-tree.h"
+#include "record-store.h"
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   What a snapshot was built from (a snapshot is STALE unless ALL of
+ *          these match the current invocation)
+ * @param   csv_size        The size (in bytes) of the source CSV
+ * @param   csv_checksum    The csv_checksum() of the source CSV
+ * @param   root_bl_x       The root's bottom-left x (as supplied)
+ * @param   root_bl_y       The root's bottom-left y (as supplied)
+ * @param   root_tr_x       The root's top-right x (as supplied)
+ * @param   root_tr_y       The root's top-right y (as supplied)
+ * @param   leaf_capacity   The DISTINCT points a leaf holds before splitting
+ * @param   max_depth       The depth at which leaves stop splitting
+*/
+typedef struct snapshot_key snapshot_key_t;
+struct snapshot_key {
+    uint64_t        csv_size;
+    uint64_t        csv_checksum;
+    long double     root_bl_x;
+    long double     root_bl_y;
+    long double     root_tr_x;
+    long double     root_tr_y;
+    int32_t         leaf_capacity;
+    int32_t         max_depth;
+};
+
+/**
+ * @brief   The 1st bytes of a snapshot file
+ * @param   magic           Always SNAPSHOT_MAGIC
+ * @param   version         Always SNAPSHOT_VERSION
+ * @param   coord_mode      The COORD_MODE the snapshot was written with
+ * @param   entry_size      sizeof(lqt_entry_t) of the writer
+ * @param   item_size       sizeof(record_ref_t) of the writer
+ * @param   key             What the snapshot was built from
+ * @param   bounds          The boundary of the root (SEARCH coordinates)
+ * @param   entry_offset    Where the linear quad-tree's entries start
+ * @param   entry_count     The number of entries
+ * @param   item_offset     Where the items (i.e. record references) start
+ * @param   item_count      The number of items
+ * @param   record_count    The number of records in the store
+ * @param   dict_count      The number of DISTINCT dictionary strings
+ * @param   column_offset   Where each column of the store starts
+ * @param   column_size     The size (in bytes) of each column
+*/
+typedef struct snapshot_header snapshot_header_t;
+struct snapshot_header {
+    char            magic[SNAPSHOT_MAGIC_SIZE];
+    uint32_t        version;
+    uint32_t        coord_mode;
+    uint32_t        entry_size;
+    uint32_t        item_size;
+    snapshot_key_t  key;
+    rectangle_t     bounds;
+    uint64_t        entry_offset;
+    uint64_t        entry_count;
+    uint64_t        item_offset;
+    uint64_t        item_count;
+    uint64_t        record_count;
+    uint64_t        dict_count;
+    uint64_t        column_offset[STORE_COLUMNS];
+    uint64_t        column_size[STORE_COLUMNS];
+};
+
+/**
+ * @brief   A snapshot mapped into memory
+ * @param   base    The 1st byte of the mapping
+ * @param   size    The number of bytes mapped
+ * @param   tree    A quad-tree answering queries from the mapping
+ * @param   store   The records the tree's items refer to (in the mapping)
+*/
+typedef struct snapshot snapshot_t;
+struct snapshot {
+    const char      *base;
+    size_t          size;
+    qt_tree_t       *tree;
+    record_store_t  *store;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// SNAPSHOT OPERATIONS:
+
+/**
+ * @brief       DESCRIBES what a snapshot of the current invocation is built
+ *              from
+ * @param[in]   csv             The source CSV
+ * @param[in]   root_bl_x       The root's bottom-left x
+ * @param[in]   root_bl_y       The root's bottom-left y
+ * @param[in]   root_tr_x       The root's top-right x
+ * @param[in]   root_tr_y       The root's top-right y
+ * @param[in]   leaf_capacity   The DISTINCT points a leaf holds
+ * @param[in]   max_depth       The depth at which leaves stop splitting
+ * @return      The key to save (or check) a snapshot with
+*/
+snapshot_key_t snapshot_key_init(csv_file_t *csv, long double root_bl_x,
+    long double root_bl_y, long double root_tr_x, long double root_tr_y,
+    int leaf_capacity, int max_depth);
+
+/**
+ * @brief       SAVES a built quad-tree & it's records as a snapshot
+ * @param[in]   filename    The path of the snapshot to (over)write
+ * @param[in]   key         What the quad-tree was built from
+ * @param[out]  tree        The quad-tree (it is LINEARISED if it isn't 
+ *                          already)
+ * @param[in]   store       The records the quad-tree's items refer to
+ * @return      An integer flag where: 0 means the quad-tree is too deep to
+ *              linearise or the file could not be written & 1 means
+ *              SUCCESSFUL
+*/
+int snapshot_save(const char *filename, snapshot_key_t *key, qt_tree_t *tree,
+    record_store_t *store);
+
+/**
+ * @brief       OPENS a snapshot by mapping it into memory
+ * @param[in]   filename    The path of the snapshot
+ * @param[in]   key         What the snapshot must have been built from
+ * @return      A POINTER to a heap-allocated snapshot, & NULL if the file is
+ *              missing, NOT a snapshot of this version & build, or STALE
+*/
+snapshot_t* snapshot_open(const char *filename, snapshot_key_t *key);
+
+/**
+ * @brief       CLOSES a snapshot (freeing it's tree & store) & unmaps it
+ * @param[out]  snapshot    The snapshot to close
+*/
+void snapshot_close(snapshot_t *snapshot);
+
+#endif
@@ -0,0 +1,255 @@
+/**
+ * @file    stats.c
+ * @brief   A file for the implementation of runtime statistics
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "stats.h"
+
+/* -------------------------------------------------------------------------- */
+
+// GLOBAL VARIABLES:
+int stats_enabled = 0;
+_Thread_local stats_query_t stats_current;
+
+static stats_totals_t totals[STATS_KINDS];
+
+/* -------------------------------------------------------------------------- */
+
+// AUXILLARY PROTOTYPE FUNCTIONS:
+void stats_write_totals(FILE *file, const char *name, stats_totals_t *total);
+void stats_write_shape(FILE *file, stats_shape_t *shape);
+void stats_write_bytes(FILE *file, stats_bytes_t *bytes);
+void stats_write_cache(FILE *file, stats_cache_t *cache);
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       ENABLES statistics (BEFORE any query is answered)
+*/
+void
+stats_enable(void) {
+    for (int i = 0; i < STATS_KINDS; i++) {
+        atomic_init(&totals[i].queries, 0);
+        atomic_init(&totals[i].nodes_visited, 0);
+        atomic_init(&totals[i].intersect_calls, 0);
+        atomic_init(&totals[i].contains_calls, 0);
+        atomic_init(&totals[i].duplicates, 0);
+        atomic_init(&totals[i].max_nodes_visited, 0);
+    }
+    stats_enabled = 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       STARTS counting a new query on this thread
+*/
+void
+stats_query_begin(void) {
+    if (stats_enabled) {
+        memset(&stats_current, 0, sizeof(stats_query_t));
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       ENDS the query counted on this thread, folding it's counters
+ *              into the totals of it's kind
+ * @param[in]   kind    Either STATS_POINT, STATS_RANGE, STATS_RADIUS or
+ *                      STATS_KNN
+*/
+void
+stats_query_end(int kind) {
+
+    // STEP 1: Add the query's counters to the totals
+    if (! stats_enabled) {
+        return;
+    }
+    assert((kind >= 0) && (kind < STATS_KINDS));
+    stats_totals_t *total = &totals[kind];
+    atomic_fetch_add_explicit(&total->queries, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&total->nodes_visited,
+        stats_current.nodes_visited, memory_order_relaxed);
+    atomic_fetch_add_explicit(&total->intersect_calls,
+        stats_current.intersect_calls, memory_order_relaxed);
+    atomic_fetch_add_explicit(&total->contains_calls,
+        stats_current.contains_calls, memory_order_relaxed);
+    atomic_fetch_add_explicit(&total->duplicates,
+        stats_current.duplicates, memory_order_relaxed);
+
+    // STEP 2: Raise the maximum if this query reached MORE nodes (NOTE: a
+    //         failed exchange reloads the maximum another thread raised)
+    unsigned long most = atomic_load_explicit(&total->max_nodes_visited,
+        memory_order_relaxed);
+    while ((stats_current.nodes_visited > most)
+        && (! atomic_compare_exchange_weak_explicit(&total->max_nodes_visited,
+        &most, stats_current.nodes_visited, memory_order_relaxed,
+        memory_order_relaxed)));
+    memset(&stats_current, 0, sizeof(stats_query_t));
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       ADDS a BLACK leaf to a shape
+ * @param[out]  shape   The shape
+ * @param[in]   depth   The depth of the leaf
+ * @param[in]   points  The DISTINCT points of the leaf
+ * @param[in]   items   The items of the leaf
+*/
+void
+stats_shape_leaf(stats_shape_t *shape, int depth, int points, long items) {
+
+    // NOTE: bucket b > 0 holds the item counts in [2^(b-1), 2^b)
+    assert((depth >= 0) && (depth < STATS_DEPTHS));
+    int bucket = 0;
+    while ((bucket < STATS_BUCKETS - 1) && ((items >> bucket) > 0)) {
+        bucket++;
+    }
+    shape->leaf_depths[depth]++;
+    shape->items_per_leaf[bucket]++;
+    shape->points += points;
+    shape->items += items;
+    if (depth > shape->deepest) {
+        shape->deepest = depth;
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       WRITES the totals of every kind of query, a shape, the bytes
+ *              held & a range cache's counters as a JSON object
+ * @param[out]  file    The file to write to
+ * @param[in]   shape   The shape of the quad-tree
+ * @param[in]   bytes   The bytes held by each subsystem
+ * @param[in]   cache   The range cache's counters (& NULL if there is NO
+ *                      range cache)
+*/
+void
+stats_write(FILE *file, stats_shape_t *shape, stats_bytes_t *bytes,
+    stats_cache_t *cache) {
+    static const char *names[STATS_KINDS] = {"point", "range", "radius",
+        "knn"};
+    fprintf(file, "{\n  \"queries\": {\n");
+    for (int i = 0; i < STATS_KINDS; i++) {
+        stats_write_totals(file, names[i], &totals[i]);
+        fputs((i < STATS_KINDS - 1) ? ",\n" : "\n", file);
+    }
+    fprintf(file, "  },\n");
+    stats_write_shape(file, shape);
+    stats_write_bytes(file, bytes);
+    if (cache != NULL) {
+        stats_write_cache(file, cache);
+    }
+    fprintf(file, "\n}\n");
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - WRITES the totals of one kind of query
+ * @param[out]  file    The file to write to
+ * @param[in]   name    The kind's name
+ * @param[in]   total   The kind's totals
+*/
+void
+stats_write_totals(FILE *file, const char *name, stats_totals_t *total) {
+    fprintf(file, "    \"%s\": {\"queries\": %lu, \"nodes_visited\": %lu, "
+        "\"intersect_calls\": %lu, \"contains_calls\": %lu, "
+        "\"duplicates\": %lu, \"max_nodes_visited\": %lu}", name,
+        atomic_load(&total->queries), atomic_load(&total->nodes_visited),
+        atomic_load(&total->intersect_calls),
+        atomic_load(&total->contains_calls),
+        atomic_load(&total->duplicates),
+        atomic_load(&total->max_nodes_visited));
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - WRITES the shape of a quad-tree
+ * @param[out]  file    The file to write to
+ * @param[in]   shape   The shape
+*/
+void
+stats_write_shape(FILE *file, stats_shape_t *shape) {
+
+    // STEP 1: The node counts & sizes
+    fprintf(file, "  \"shape\": {\n    \"linear\": %s,\n",
+        shape->linear ? "true" : "false");
+    fprintf(file, "    \"white\": %lu,\n    \"black\": %lu,\n    "
+        "\"grey\": %lu,\n", shape->colours[0], shape->colours[1],
+        shape->colours[2]);
+    fprintf(file, "    \"points\": %lu,\n    \"items\": %lu,\n    "
+        "\"deepest\": %d,\n", shape->points, shape->items, shape->deepest);
+
+    // STEP 2: The leaves at each depth (down to the DEEPEST)
+    fprintf(file, "    \"leaf_depths\": [");
+    for (int d = 0; d <= shape->deepest; d++) {
+        fprintf(file, "%s%lu", (d > 0) ? ", " : "", shape->leaf_depths[d]);
+    }
+
+    // STEP 3: The leaves in each NON-EMPTY bucket of items, keyed by the
+    //         bucket's range
+    fprintf(file, "],\n    \"items_per_leaf\": {");
+    int written = 0;
+    for (int b = 0; b < STATS_BUCKETS; b++) {
+        if (shape->items_per_leaf[b] == 0) continue;
+        unsigned long lo = (b == 0) ? 0 : 1UL << (b - 1);
+        unsigned long hi = (b == 0) ? 0 : (1UL << b) - 1;
+        fputs(written++ ? ", " : "", file);
+        if (lo == hi) {
+            fprintf(file, "\"%lu\": %lu", lo, shape->items_per_leaf[b]);
+        } else {
+            fprintf(file, "\"%lu-%lu\": %lu", lo, hi,
+                shape->items_per_leaf[b]);
+        }
+    }
+    fprintf(file, "}\n  },\n");
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - WRITES the bytes held by each subsystem
+ * @param[out]  file    The file to write to
+ * @param[in]   bytes   The bytes held
+*/
+void
+stats_write_bytes(FILE *file, stats_bytes_t *bytes) {
+    size_t total = bytes->nodes + bytes->slots + bytes->grown_slots
+        + bytes->items + bytes->linear + bytes->records;
+    fprintf(file, "  \"bytes\": {\"nodes\": %zu, \"slots\": %zu, "
+        "\"grown_slots\": %zu, \"items\": %zu, \"linear\": %zu, "
+        "\"records\": %zu, \"total\": %zu}", bytes->nodes, bytes->slots,
+        bytes->grown_slots, bytes->items, bytes->linear, bytes->records,
+        total);
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       AUXILLARY - WRITES the counters of a range cache
+ * @param[out]  file    The file to write to
+ * @param[in]   cache   The range cache's counters
+*/
+void
+stats_write_cache(FILE *file, stats_cache_t *cache) {
+    unsigned long lookups = cache->hits + cache->misses;
+    fprintf(file, ",\n  \"range_cache\": {\"budget\": %zu, \"bytes\": %zu, "
+        "\"entries\": %lu, \"hits\": %lu, \"misses\": %lu, "
+        "\"evictions\": %lu, \"hit_rate\": %.4f}", cache->budget,
+        cache->bytes, cache->entries, cache->hits, cache->misses,
+        cache->evictions, (lookups > 0) ? (double)cache->hits / lookups : 0);
+}
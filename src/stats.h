@@ -0,0 +1,193 @@
+/**
+ * @file    stats.h
+ * @brief   A HEADER file for the implementation of runtime statistics
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          Statistics are OPT-IN (see stats_enable()). Whilst enabled, each
+ *          thread COUNTS the work of it's current query & folds it into
+ *          shared totals once the query ends, whilst the tree's shape, the
+ *          bytes each subsystem holds & the range cache's counters are
+ *          measured on demand
+*/
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#ifndef _STATS_H_
+#define _STATS_H_
+
+#define STATS_POINT 0       // A point query (i.e. qt_search())
+#define STATS_RANGE 1       // A range query
+#define STATS_RADIUS 2      // A radius query
+#define STATS_KNN 3         // A k-nearest-neighbour query
+#define STATS_KINDS 4       // The number of kinds of query
+
+#define STATS_COLOURS 3     // WHITE, BLACK & GREY (as in quad-tree.h)
+#define STATS_DEPTHS 65     // Depths a leaf lies at (0 up to QT_MAX_DEPTH)
+#define STATS_BUCKETS 33    // Items per leaf: 0, 1, 2-3, 4-7, ... 2^31-
+
+// COUNTS work done by the CURRENT query of this thread (if enabled)
+#define STATS_COUNT(counter, n) \
+    do { if (stats_enabled) stats_current.counter += (n); } while (0)
+
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT FILES
+#include <stdio.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   The work done by ONE query
+ * @param   nodes_visited   The nodes (or linear runs) reached
+ * @param   intersect_calls The rectangle_intersect() (& circle_intersect())
+ *                          calls made
+ * @param   contains_calls  The rectangle_contains() (& circle_contains())
+ *                          calls made
+ * @param   duplicates      The records skipped as ALREADY matched (i.e. at
+ *                          their other endpoint)
+*/
+typedef struct stats_query stats_query_t;
+struct stats_query {
+    unsigned long   nodes_visited;
+    unsigned long   intersect_calls;
+    unsigned long   contains_calls;
+    unsigned long   duplicates;
+};
+
+/**
+ * @brief   The work done by EVERY query of one kind (across all threads)
+ * @param   queries         The number of queries
+ * @param   nodes_visited   The SUMS of each query's counters
+ * @param   intersect_calls
+ * @param   contains_calls
+ * @param   duplicates
+ * @param   max_nodes_visited   The MOST nodes ONE query reached
+*/
+typedef struct stats_totals stats_totals_t;
+struct stats_totals {
+    atomic_ulong    queries;
+    atomic_ulong    nodes_visited;
+    atomic_ulong    intersect_calls;
+    atomic_ulong    contains_calls;
+    atomic_ulong    duplicates;
+    atomic_ulong    max_nodes_visited;
+};
+
+/**
+ * @brief   The shape of a quad-tree
+ * @param   linear          1 if measured from the LINEAR backend (which only
+ *                          keeps the BLACK leaves), & 0 otherwise
+ * @param   colours         The number of nodes of each colour
+ * @param   leaf_depths     The number of BLACK leaves at each depth
+ * @param   items_per_leaf  The number of BLACK leaves whose item count lies
+ *                          in each power-of-2 bucket
+ * @param   points          The number of DISTINCT points
+ * @param   items           The number of items (i.e. record references)
+ * @param   deepest         The depth of the DEEPEST leaf
+*/
+typedef struct stats_shape stats_shape_t;
+struct stats_shape {
+    int             linear;
+    unsigned long   colours[STATS_COLOURS];
+    unsigned long   leaf_depths[STATS_DEPTHS];
+    unsigned long   items_per_leaf[STATS_BUCKETS];
+    unsigned long   points;
+    unsigned long   items;
+    int             deepest;
+};
+
+/**
+ * @brief   The heap bytes held by each subsystem
+ * @param   nodes       The pooled blocks of child nodes
+ * @param   slots       The pooled blocks of 'leaf_capacity' leaf slots
+ * @param   grown_slots The slots of leaves (at the maximum depth) that
+ *                      outgrew a block of 'leaf_capacity' slots
+ * @param   items       The pooled item arrays of every slot
+ * @param   linear      The entries & items of the LINEAR backend
+ * @param   records     The record store's columns
+*/
+typedef struct stats_bytes stats_bytes_t;
+struct stats_bytes {
+    size_t          nodes;
+    size_t          slots;
+    size_t          grown_slots;
+    size_t          items;
+    size_t          linear;
+    size_t          records;
+};
+
+/**
+ * @brief   The counters of a range cache (see range-cache.h)
+ * @param   budget      The MOST bytes the entries may hold
+ * @param   bytes       The bytes the entries hold
+ * @param   entries     The number of entries
+ * @param   hits        The ranges answered from the cache
+ * @param   misses      The ranges answered from the quad-tree
+ * @param   evictions   The entries evicted to make room for others
+*/
+typedef struct stats_cache stats_cache_t;
+struct stats_cache {
+    size_t          budget;
+    size_t          bytes;
+    unsigned long   entries;
+    unsigned long   hits;
+    unsigned long   misses;
+    unsigned long   evictions;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// GLOBAL VARIABLES:
+extern int stats_enabled;
+extern _Thread_local stats_query_t stats_current;
+
+/* -------------------------------------------------------------------------- */
+
+// STATS OPERATIONS:
+
+/**
+ * @brief       ENABLES statistics (BEFORE any query is answered)
+*/
+void stats_enable(void);
+
+/**
+ * @brief       STARTS counting a new query on this thread
+*/
+void stats_query_begin(void);
+
+/**
+ * @brief       ENDS the query counted on this thread, folding it's counters
+ *              into the totals of it's kind
+ * @param[in]   kind    Either STATS_POINT, STATS_RANGE, STATS_RADIUS or
+ *                      STATS_KNN
+*/
+void stats_query_end(int kind);
+
+/**
+ * @brief       ADDS a BLACK leaf to a shape
+ * @param[out]  shape   The shape
+ * @param[in]   depth   The depth of the leaf
+ * @param[in]   points  The DISTINCT points of the leaf
+ * @param[in]   items   The items of the leaf
+*/
+void stats_shape_leaf(stats_shape_t *shape, int depth, int points,
+    long items);
+
+/**
+ * @brief       WRITES the totals of every kind of query, a shape, the bytes
+ *              held & a range cache's counters as a JSON object
+ * @param[out]  file    The file to write to
+ * @param[in]   shape   The shape of the quad-tree
+ * @param[in]   bytes   The bytes held by each subsystem
+ * @param[in]   cache   The range cache's counters (& NULL if there is NO
+ *                      range cache)
+*/
+void stats_write(FILE *file, stats_shape_t *shape, stats_bytes_t *bytes,
+    stats_cache_t *cache);
+
+#endif
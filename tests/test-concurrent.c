@@ -0,0 +1,293 @@
+/**
+ * @file    test-concurrent.c
+ * @brief   A TEST of querying a CONCURRENT quad-tree whilst it is updated
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          READERS threads search for the (never updated) even rows & query
+ *          ranges, lock-free inside epoch_enter() & epoch_exit(), whilst ONE
+ *          writer repeatedly removes, re-inserts & moves the odd rows. Every
+ *          reader must ALWAYS find the even rows, & every match must refer to
+ *          it's OWN record. Built with -fsanitize=address (or thread), a
+ *          block reclaimed whilst a reader can still reach it is reported
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "../src/coordinates.h"
+#include "../src/csv.h"
+#include "../src/dynamic-array.h"
+#include "../src/epoch.h"
+#include "../src/quad-tree.h"
+#include "../src/record-store.h"
+
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#define DATASET "tests/dataset_1000.csv"
+#define ROOT_BL_X 144.9375L         // Same root as tests 8, 13, 14, ...
+#define ROOT_BL_Y -37.8750L
+#define ROOT_TR_X 145.0000L
+#define ROOT_TR_Y -37.6875L
+
+#define READERS 4                   // Threads querying the quad-tree
+#define ROUNDS 10                   // Times the writer updates every odd row
+#define GRID 4                      // Ranges per side of the root
+
+/* -------------------------------------------------------------------------- */
+
+// STRUCTURE DEFINITIONS:
+
+/**
+ * @brief   What the reader & writer threads share
+ * @param   tree        The CONCURRENT quad-tree
+ * @param   store       The records the quad-tree's items refer to
+ * @param   points      The endpoints of every row (2 per row)
+ * @param   data        The reference of each endpoint
+ * @param   middles     Where the writer moves the start of each row
+ * @param   row_count   The number of rows
+ * @param   done        Set once the writer has finished
+ * @param   failures    The checks that failed (on ANY thread)
+ * @param   queries     The queries the readers answered
+*/
+typedef struct shared shared_t;
+struct shared {
+    qt_tree_t       *tree;
+    record_store_t  *store;
+    point_2d_t      *points;
+    record_ref_t    *data;
+    point_2d_t      *middles;
+    int             row_count;
+    atomic_int      done;
+    atomic_int      failures;
+    atomic_long     queries;
+};
+
+/* -------------------------------------------------------------------------- */
+
+// FUNCTION PROTOTYPES:
+void* reader(void *arg);
+void writer(shared_t *shared);
+int valid_matches(record_store_t *store, array_t *matches, int sorted);
+
+/* -------------------------------------------------------------------------- */
+
+int main(void) {
+
+    // STEP 1: Read the dataset (in file order, & kept mapped as the rows
+    //         refer to it)
+    coord_frame_init(ROOT_BL_X, ROOT_BL_Y, ROOT_TR_X, ROOT_TR_Y);
+    rectangle_t root_bounds = rectangle_init(
+        point_2d_quantise(ROOT_BL_X, ROOT_BL_Y),
+        point_2d_quantise(ROOT_TR_X, ROOT_TR_Y));
+    csv_file_t *csv = csv_open(DATASET);
+    if (csv == NULL) {
+        fprintf(stderr, "ERROR: could not open %s\n", DATASET);
+        exit(EXIT_FAILURE);
+    }
+    int row_count = 0;
+    data_t **rows = csv_read_rows(csv, 1, &row_count);
+
+    // STEP 2: Bulk load EVERY endpoint, & then share the quad-tree
+    shared_t shared;
+    shared.store = record_store_init(row_count);
+    shared.points =
+        (point_2d_t *)malloc(sizeof(point_2d_t) * (2 * row_count + 1));
+    shared.data =
+        (record_ref_t *)malloc(sizeof(record_ref_t) * (2 * row_count + 1));
+    shared.middles =
+        (point_2d_t *)malloc(sizeof(point_2d_t) * (row_count + 1));
+    assert((shared.points != NULL) && (shared.data != NULL)
+        && (shared.middles != NULL));
+    for (int i = 0; i < row_count; i++) {
+        record_ref_t ref = record_store_append(shared.store, csv->base,
+            rows[i]);
+        shared.points[2 * i] =
+            point_2d_quantise(rows[i]->start_lon, rows[i]->start_lat);
+        shared.points[2 * i + 1] =
+            point_2d_quantise(rows[i]->end_lon, rows[i]->end_lat);
+        shared.data[2 * i] = shared.data[2 * i + 1] = ref;
+        shared.middles[i] = point_2d_quantise(
+            (rows[i]->start_lon + rows[i]->end_lon) / 2,
+            (rows[i]->start_lat + rows[i]->end_lat) / 2);
+        free_data(rows[i]);
+    }
+    free(rows);
+    shared.tree = qt_tree_init(root_bounds, QT_DEFAULT_LEAF_CAPACITY,
+        QT_UNLIMITED_DEPTH);
+    qt_bulk_load(shared.tree, shared.points, shared.data, 2 * row_count);
+    unsigned int node_count = shared.tree->node_count;
+    qt_concurrent_init(shared.tree);
+    shared.row_count = row_count;
+    atomic_init(&shared.done, 0);
+    atomic_init(&shared.failures, 0);
+    atomic_init(&shared.queries, 0);
+
+    // STEP 3: Query on the readers whilst THIS thread writes
+    pthread_t threads[READERS];
+    for (int i = 0; i < READERS; i++) {
+        if (pthread_create(&threads[i], NULL, reader, &shared) != 0) {
+            fprintf(stderr, "ERROR: could not start reader %d\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+    writer(&shared);
+    atomic_store(&shared.done, 1);
+    for (int i = 0; i < READERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    // STEP 4: Every row is back where it started, so the SHAPE is too
+    for (int i = 0; i < 2 * row_count; i++) {
+        array_t *items = qt_search(shared.tree, &shared.points[i], NULL);
+        if ((items == NULL)
+            || (array_binary_search(items, shared.data[i].foothpath_id)
+            == NULL)) {
+            atomic_fetch_add(&shared.failures, 1);
+        }
+    }
+    if (shared.tree->node_count != node_count) {
+        atomic_fetch_add(&shared.failures, 1);
+    }
+
+    // STEP 5: Report the outcome
+    int failures = atomic_load(&shared.failures);
+    printf("%s test-concurrent (%d readers, %ld queries, %d failures)\n",
+        (failures == 0) ? "PASS" : "FAIL", READERS,
+        atomic_load(&shared.queries), failures);
+    qt_free(shared.tree);
+    record_store_free(shared.store);
+    free(shared.points);
+    free(shared.data);
+    free(shared.middles);
+    csv_close(csv);
+    return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       A READER thread: searches for the even rows & queries a GRID
+ *              of ranges until the writer has finished
+ * @param[in]   arg     The shared_t of the test
+ * @return      NULL
+*/
+void*
+reader(void *arg) {
+    shared_t *shared = (shared_t *)arg;
+    epoch_t *epoch = shared->tree->epoch;
+    int id = epoch_register(epoch);
+    long queries = 0;
+    int row = 0, cell = 0;
+
+    // NOTE: one more pass after the writer finishes, so EVERY reader runs
+    int last = 0;
+    while (! last) {
+        last = atomic_load(&shared->done);
+
+        // STEP 1: An even row is NEVER updated, so it is ALWAYS found
+        epoch_enter(epoch, id);
+        int point = 2 * (2 * row) + (row % 2);
+        array_t *items = qt_search(shared->tree, &shared->points[point],
+            NULL);
+        if ((items == NULL) || (array_binary_search(items,
+            shared->data[point].foothpath_id) == NULL)
+            || (! valid_matches(shared->store, items, 1))) {
+            atomic_fetch_add(&shared->failures, 1);
+        }
+        epoch_exit(epoch, id);
+        row = (row + 1) % ((shared->row_count + 1) / 2);
+
+        // STEP 2: A range's matches refer to their OWN records, in order
+        int x = cell % GRID, y = cell / GRID;
+        rectangle_t range = rectangle_init(
+            point_2d_quantise(ROOT_BL_X + (ROOT_TR_X - ROOT_BL_X) * x / GRID,
+                ROOT_BL_Y + (ROOT_TR_Y - ROOT_BL_Y) * y / GRID),
+            point_2d_quantise(
+                ROOT_BL_X + (ROOT_TR_X - ROOT_BL_X) * (x + 1) / GRID,
+                ROOT_BL_Y + (ROOT_TR_Y - ROOT_BL_Y) * (y + 1) / GRID));
+        epoch_enter(epoch, id);
+        array_t *matches = qt_range_query(shared->tree, NULL, &range);
+        epoch_exit(epoch, id);
+        if (matches != NULL) {
+            if (! valid_matches(shared->store, matches, 1)) {
+                atomic_fetch_add(&shared->failures, 1);
+            }
+            array_free(matches);
+        }
+        cell = (cell + 1) % (GRID * GRID);
+        queries += 2;
+    }
+    atomic_fetch_add(&shared->queries, queries);
+    return NULL;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       The WRITER: removes & re-inserts (or moves away & back) every
+ *              odd row, ROUNDS times
+ * @param[out]  shared  The shared_t of the test
+*/
+void
+writer(shared_t *shared) {
+    qt_tree_t *tree = shared->tree;
+    for (int round = 0; round < ROUNDS; round++) {
+        for (int i = 1; i < shared->row_count; i += 2) {
+            point_2d_t *start = &shared->points[2 * i];
+            point_2d_t *end = &shared->points[2 * i + 1];
+            record_ref_t ref = shared->data[2 * i];
+            int ok = 1;
+
+            // CASE 1: Remove the row, & check that removing it AGAIN
+            //         publishes NOTHING, before re-inserting it
+            if (i % 4 == 1) {
+                ok &= qt_remove(tree, start, ref.foothpath_id);
+                ok &= qt_remove(tree, end, ref.foothpath_id);
+                unsigned long global = atomic_load(&tree->epoch->global);
+                ok &= ! qt_remove(tree, start, ref.foothpath_id);
+                ok &= ! qt_move(tree, start, end, ref);
+                ok &= (atomic_load(&tree->epoch->global) == global);
+                ok &= qt_insert(tree, start, ref);
+                ok &= qt_insert(tree, end, ref);
+
+            // CASE 2: Move the start of the row away & back again
+            } else {
+                ok &= qt_move(tree, start, &shared->middles[i], ref);
+                ok &= qt_move(tree, &shared->middles[i], start, ref);
+            }
+            if (! ok) atomic_fetch_add(&shared->failures, 1);
+        }
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       CHECKS that matches refer to their OWN records
+ * @param[in]   store   The records
+ * @param[in]   matches The matches to check
+ * @param[in]   sorted  Whether the matches must be in footpath_id order
+ * @return      1 if they are valid, & 0 otherwise
+*/
+int
+valid_matches(record_store_t *store, array_t *matches, int sorted) {
+    for (int i = 0; i < matches->logical_size; i++) {
+        record_ref_t ref = matches->data[i];
+        if ((ref.record < 0) || (ref.record >= store->count)
+            || (store->foothpath_id[ref.record] != ref.foothpath_id)) {
+            return 0;
+        }
+        if (sorted && (i > 0)
+            && (matches->data[i - 1].foothpath_id > ref.foothpath_id)) {
+            return 0;
+        }
+    }
+    return 1;
+}
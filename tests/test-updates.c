@@ -0,0 +1,285 @@
+/**
+ * @file    test-updates.c
+ * @brief   A TEST of removing & moving the items of a quad-tree
+ * @author  Jude Thaddeau Data
+ * @note    GitHub: https://github.com/jtd-117
+ *
+ *          Inserts EVERY endpoint of a dataset one at a time, removes a 3rd
+ *          of the rows & moves another 3rd, & then checks that the quad-tree
+ *          answers point & range queries (matches AND paths) exactly as one
+ *          freshly bulk loaded from the remaining endpoints does. Coalescing
+ *          keeps the shape canonical, so the node counts must agree too.
+ *          Finally, removing EVERYTHING must leave a single WHITE root
+*/
+/* -------------------------------------------------------------------------- */
+
+// LIBRARIES & RELEVANT HEADER FILES:
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+#include "../src/coordinates.h"
+#include "../src/csv.h"
+#include "../src/dynamic-array.h"
+#include "../src/path.h"
+#include "../src/quad-tree.h"
+#include "../src/record-store.h"
+
+/* -------------------------------------------------------------------------- */
+
+// CONSTANT DEFINITIONS:
+#define DATASET "tests/dataset_1000.csv"
+#define ROOT_BL_X 144.9375L         // Same root as tests 8, 13, 14, ...
+#define ROOT_BL_Y -37.8750L
+#define ROOT_TR_X 145.0000L
+#define ROOT_TR_Y -37.6875L
+
+#define GRID 8                      // Range queries per side of the root
+#define CONFIGS 3                   // Tree parameters tested
+
+/* -------------------------------------------------------------------------- */
+
+// FUNCTION PROTOTYPES:
+int run_config(const char *base, data_t **rows, int row_count,
+    rectangle_t *root_bounds, int leaf_capacity, int max_depth);
+int same_items(array_t *a, array_t *b);
+int same_path(path_t *a, path_t *b);
+int same_queries(qt_tree_t *updated, qt_tree_t *fresh, point_2d_t *points,
+    int n);
+
+/* -------------------------------------------------------------------------- */
+
+int main(void) {
+
+    // STEP 1: Read the dataset (in file order, & kept mapped as the rows
+    //         refer to it)
+    coord_frame_init(ROOT_BL_X, ROOT_BL_Y, ROOT_TR_X, ROOT_TR_Y);
+    rectangle_t root_bounds = rectangle_init(
+        point_2d_quantise(ROOT_BL_X, ROOT_BL_Y),
+        point_2d_quantise(ROOT_TR_X, ROOT_TR_Y));
+    csv_file_t *csv = csv_open(DATASET);
+    if (csv == NULL) {
+        fprintf(stderr, "ERROR: could not open %s\n", DATASET);
+        exit(EXIT_FAILURE);
+    }
+    int row_count = 0;
+    data_t **rows = csv_read_rows(csv, 1, &row_count);
+
+    // STEP 2: Check EVERY configuration (the default, roomier leaves, & a
+    //         depth limit that forces leaves to outgrow their slots)
+    int leaf_capacities[CONFIGS] = {QT_DEFAULT_LEAF_CAPACITY, 4, 2};
+    int max_depths[CONFIGS] = {QT_UNLIMITED_DEPTH, QT_UNLIMITED_DEPTH, 3};
+    int failed = 0;
+    for (int c = 0; c < CONFIGS; c++) {
+        if (run_config(csv->base, rows, row_count, &root_bounds,
+            leaf_capacities[c], max_depths[c])) {
+            printf("PASS test-updates (leaf capacity %d, max depth %d)\n",
+                leaf_capacities[c], max_depths[c]);
+        } else {
+            printf("FAIL test-updates (leaf capacity %d, max depth %d)\n",
+                leaf_capacities[c], max_depths[c]);
+            failed = 1;
+        }
+    }
+    for (int i = 0; i < row_count; i++) {
+        free_data(rows[i]);
+    }
+    free(rows);
+    csv_close(csv);
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       UPDATES an incrementally built quad-tree & compares it with a
+ *              freshly built one
+ * @param[in]   base            The 1st byte of the CSV the rows refer to
+ * @param[in]   rows            The rows of the dataset
+ * @param[in]   row_count       The number of rows
+ * @param[in]   root_bounds     The bounds of the root
+ * @param[in]   leaf_capacity   The DISTINCT points a leaf holds
+ * @param[in]   max_depth       The depth at which leaves stop splitting
+ * @return      1 if EVERY check passed, & 0 otherwise
+*/
+int
+run_config(const char *base, data_t **rows, int row_count,
+    rectangle_t *root_bounds, int leaf_capacity, int max_depth) {
+
+    // STEP 1: Insert EVERY endpoint one at a time
+    int ok = 1, n = 0;
+    record_store_t *store = record_store_init(row_count);
+    point_2d_t *points =
+        (point_2d_t *)malloc(sizeof(point_2d_t) * (2 * row_count + 1));
+    record_ref_t *data =
+        (record_ref_t *)malloc(sizeof(record_ref_t) * (2 * row_count + 1));
+    assert((points != NULL) && (data != NULL));
+    qt_tree_t *updated = qt_tree_init(*root_bounds, leaf_capacity, max_depth);
+    for (int i = 0; i < row_count; i++) {
+        record_ref_t ref = record_store_append(store, base, rows[i]);
+        points[n] = point_2d_quantise(rows[i]->start_lon, rows[i]->start_lat);
+        data[n++] = ref;
+        points[n] = point_2d_quantise(rows[i]->end_lon, rows[i]->end_lat);
+        data[n++] = ref;
+        ok &= qt_insert(updated, &points[n - 2], ref);
+        ok &= qt_insert(updated, &points[n - 1], ref);
+    }
+
+    // STEP 2: Remove EVERY 3rd row & move the start of the next to the
+    //         middle of the row (keeping the points the fresh tree is built
+    //         from, & the queries are asked at)
+    point_2d_t *remaining =
+        (point_2d_t *)malloc(sizeof(point_2d_t) * (2 * row_count + 1));
+    record_ref_t *remaining_data =
+        (record_ref_t *)malloc(sizeof(record_ref_t) * (2 * row_count + 1));
+    assert((remaining != NULL) && (remaining_data != NULL));
+    int m = 0;
+    for (int i = 0; i < row_count; i++) {
+        point_2d_t start = points[2 * i], end = points[2 * i + 1];
+        if (i % 3 == 0) {
+            ok &= qt_remove(updated, &start, data[2 * i].foothpath_id);
+            ok &= qt_remove(updated, &end, data[2 * i].foothpath_id);
+            continue;
+        }
+        if (i % 3 == 1) {
+            point_2d_t middle = point_2d_quantise(
+                (rows[i]->start_lon + rows[i]->end_lon) / 2,
+                (rows[i]->start_lat + rows[i]->end_lat) / 2);
+            ok &= qt_move(updated, &start, &middle, data[2 * i]);
+            start = middle;
+        }
+        remaining[m] = start;
+        remaining_data[m++] = data[2 * i];
+        remaining[m] = end;
+        remaining_data[m++] = data[2 * i + 1];
+    }
+
+    // STEP 3: Removing (or moving) what is NOT there changes NOTHING
+    unsigned int node_count = updated->node_count;
+    ok &= ! qt_remove(updated, &points[0], data[0].foothpath_id);
+    ok &= ! qt_move(updated, &points[0], &points[1], data[0]);
+    ok &= (updated->node_count == node_count);
+
+    // STEP 4: The updated tree must match one built from what remains
+    qt_tree_t *fresh = qt_tree_init(*root_bounds, leaf_capacity, max_depth);
+    qt_bulk_load(fresh, remaining, remaining_data, m);
+    ok &= (updated->node_count == fresh->node_count);
+    ok &= same_queries(updated, fresh, points, n);
+    ok &= same_queries(updated, fresh, remaining, m);
+
+    // STEP 5: Removing EVERYTHING coalesces back to a single WHITE root
+    for (int i = 0; i < m; i++) {
+        ok &= qt_remove(updated, &remaining[i], remaining_data[i].foothpath_id);
+    }
+    ok &= (updated->node_count == 1) && (updated->root->color == WHITE);
+
+    qt_free(updated);
+    qt_free(fresh);
+    record_store_free(store);
+    free(points);
+    free(data);
+    free(remaining);
+    free(remaining_data);
+    return ok;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       COMPARES the point & range queries of 2 quad-trees
+ * @param[in]   updated     The quad-tree that was updated
+ * @param[in]   fresh       The quad-tree built from what remains
+ * @param[in]   points      The points to search for
+ * @param[in]   n           The number of points
+ * @return      1 if EVERY query has the SAME matches & path, & 0 otherwise
+*/
+int
+same_queries(qt_tree_t *updated, qt_tree_t *fresh, point_2d_t *points,
+    int n) {
+
+    // STEP 1: Search for every point
+    int ok = 1;
+    path_t *a = path_init(), *b = path_init();
+    for (int i = 0; i < n; i++) {
+        path_truncate(a, 0);
+        path_truncate(b, 0);
+        ok &= same_items(qt_search(updated, &points[i], a),
+            qt_search(fresh, &points[i], b));
+        ok &= same_path(a, b);
+    }
+
+    // STEP 2: Query a GRID of ranges, from 1/GRID of the root's side up to
+    //         the WHOLE root
+    for (int size = 1; size <= GRID; size *= 2) {
+        for (int x = 0; x + size <= GRID; x++) {
+            for (int y = 0; y + size <= GRID; y++) {
+                rectangle_t range = rectangle_init(
+                    point_2d_quantise(
+                        ROOT_BL_X + (ROOT_TR_X - ROOT_BL_X) * x / GRID,
+                        ROOT_BL_Y + (ROOT_TR_Y - ROOT_BL_Y) * y / GRID),
+                    point_2d_quantise(
+                        ROOT_BL_X + (ROOT_TR_X - ROOT_BL_X) * (x + size) / GRID,
+                        ROOT_BL_Y + (ROOT_TR_Y - ROOT_BL_Y) * (y + size) / GRID));
+                path_truncate(a, 0);
+                path_truncate(b, 0);
+                array_t *found = qt_range_query(updated, a, &range);
+                array_t *expected = qt_range_query(fresh, b, &range);
+                ok &= same_items(found, expected) && same_path(a, b);
+                if (found != NULL) array_free(found);
+                if (expected != NULL) array_free(expected);
+            }
+        }
+    }
+    path_free(a);
+    path_free(b);
+    return ok;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       COMPARES 2 arrays of items
+ * @param[in]   a   The 1st array (& NULL if there were none)
+ * @param[in]   b   The 2nd array (& NULL if there were none)
+ * @return      1 if both hold the SAME records in the SAME order, & 0
+ *              otherwise
+*/
+int
+same_items(array_t *a, array_t *b) {
+    if ((a == NULL) || (b == NULL)) {
+        return a == b;
+    }
+    if (a->logical_size != b->logical_size) {
+        return 0;
+    }
+    for (int i = 0; i < a->logical_size; i++) {
+        if ((a->data[i].foothpath_id != b->data[i].foothpath_id)
+            || (a->data[i].record != b->data[i].record)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/**
+ * @brief       COMPARES 2 paths
+ * @param[in]   a   The 1st path
+ * @param[in]   b   The 2nd path
+ * @return      1 if both traverse the SAME quadrants, & 0 otherwise
+*/
+int
+same_path(path_t *a, path_t *b) {
+    if (a->length != b->length) {
+        return 0;
+    }
+    for (int i = 0; i < a->length; i++) {
+        int shift = 2 * (i % 32);
+        if (((a->words[i / 32] >> shift) & 3)
+            != ((b->words[i / 32] >> shift) & 3)) {
+            return 0;
+        }
+    }
+    return 1;
+}
@@ -0,0 +1,70 @@
+#!/bin/sh
+# Project: quad-tree-mapper
+# Name: Jude Thaddeau Data
+# GitHub: https://github.com/jtd-117
+# -------------------------------------------------------------------------- #
+
+# Runs EVERY mode 1, 2, 3 & 4 test & diffs both outputs against the expected
+# ones. Any extra arguments (e.g. --linear) are passed on to the program.
+# Usage: ./tests/validate.sh [flags...]
+
+fail=0
+
+run() {
+    mode=$1; csv=$2; bl_x=$3; bl_y=$4; tr_x=$5; tr_y=$6; test=$7
+    shift 7
+    ./mode$mode $mode tests/$csv output.out $bl_x $bl_y $tr_x $tr_y "$@" \
+        < tests/$test.in > output.stdout.out || fail=1
+    if cmp -s output.out tests/$test.out \
+        && cmp -s output.stdout.out tests/$test.stdout.out; then
+        echo "PASS $test"
+    else
+        echo "FAIL $test"
+        fail=1
+    fi
+}
+
+# MODE 1
+run 1 dataset_1.csv 144.969 -37.7975 144.971 -37.7955 test1.s3 "$@"
+run 1 dataset_1.csv 144.969 -37.7965 144.971 -37.795 test2.s3 "$@"
+run 1 dataset_1.csv 144.969 -37.7965 144.9725 -37.7945 test3.s3 "$@"
+run 1 dataset_1.csv 144.969 -37.7965 144.976 -37.7925 test4.s3 "$@"
+run 1 dataset_2.csv 144.968 -37.797 144.977 -37.79 test5.s3 "$@"
+run 1 dataset_20.csv 144.952 -37.81 144.978 -37.79 test6.s3 "$@"
+run 1 dataset_100.csv 144.9538 -37.812 144.9792 -37.784 test7.s3 "$@"
+run 1 dataset_1000.csv 144.9375 -37.8750 145.0000 -37.6875 test8.s3 "$@"
+
+# MODE 2
+run 2 dataset_1.csv 144.969 -37.7975 144.971 -37.7955 test9.s4 "$@"
+run 2 dataset_1.csv 144.969 -37.7965 144.9725 -37.7945 test10.s4 "$@"
+run 2 dataset_2.csv 144.968 -37.797 144.977 -37.79 test11.s4 "$@"
+run 2 dataset_20.csv 144.952 -37.81 144.978 -37.79 test12.s4 "$@"
+run 2 dataset_100.csv 144.9375 -37.8750 145.0000 -37.6875 test13.s4 "$@"
+run 2 dataset_1000.csv 144.9375 -37.8750 145.0000 -37.6875 test14.s4 "$@"
+
+# MODE 1 & 2 - rows removed or moved once the quad-tree is built (the 
+# expected outputs are those of a CSV holding just the remaining rows)
+run 1 dataset_20.csv 144.952 -37.81 144.978 -37.79 test19.s3 \
+    --updates tests/test19.s3.updates "$@"
+run 2 dataset_100.csv 144.9375 -37.8750 145.0000 -37.6875 test20.s4 \
+    --updates tests/test20.s4.updates "$@"
+run 2 dataset_2.csv 144.968 -37.797 144.977 -37.79 test21.s4 \
+    --updates tests/test21.s4.updates "$@"
+
+# MODE 1 - rows are NOT updated once the nodes are linearised to save a 
+# snapshot (which describes the CSV), so the expected outputs are those of the
+# WHOLE CSV (& the warning is expected)
+run 1 dataset_20.csv 144.952 -37.81 144.978 -37.79 test22.s3 \
+    --save-snapshot output.snap --updates tests/test19.s3.updates "$@" \
+    2> /dev/null
+rm -f output.snap
+
+# MODE 3
+run 3 dataset_20.csv 144.952 -37.81 144.978 -37.79 test15.s5 "$@"
+run 3 dataset_1000.csv 144.9375 -37.8750 145.0000 -37.6875 test16.s5 "$@"
+
+# MODE 4
+run 4 dataset_20.csv 144.952 -37.81 144.978 -37.79 test17.s6 "$@"
+run 4 dataset_1000.csv 144.9375 -37.8750 145.0000 -37.6875 test18.s6 "$@"
+
+exit $fail